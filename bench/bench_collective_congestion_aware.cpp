@@ -0,0 +1,224 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "bench_common.h"
+#include "common/EventQueue.h"
+#include "common/NetworkParser.h"
+#include "common/Type.h"
+#include "congestion_aware/Chunk.h"
+#include "congestion_aware/CollectiveGenerator.h"
+#include "congestion_aware/DagExecutor.h"
+#include "congestion_aware/Helper.h"
+#include <benchmark/benchmark.h>
+#include <memory>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+using namespace BenchAnalytical;
+
+namespace {
+
+/// every chunk transmission over a link schedules two events: chunk arrival and link free
+/// (in hybrid mode, "events" below counts the event-driven equivalent)
+constexpr int events_per_hop = 2;
+
+void noop_callback(void* const arg) noexcept {}
+
+/// Ring(npus / 32) x FullyConnected(4) x Switch(8)
+NetworkConfigFile make_config(const int npus_count) noexcept {
+    return NetworkConfigFile("bench_collective_congestion_aware.yml", {"Ring", "FullyConnected", "Switch"},
+                             {npus_count / 32, 4, 8}, {200.0, 100.0, 50.0}, {50.0, 500.0, 2000.0});
+}
+
+/// ring all-reduce: 2(n-1) steps, each step starts once every chunk of the previous step arrived
+class RingAllReduce {
+  public:
+    RingAllReduce(Topology& topology, const ChunkSize chunk_size) noexcept
+        : topology(topology),
+          npus_count(topology.get_npus_count()),
+          chunk_size(chunk_size),
+          steps_count(2 * (npus_count - 1)),
+          step(0),
+          arrived_count(0),
+          hops_count(0) {}
+
+    static void chunk_arrived(void* const arg) noexcept {
+        auto* const all_reduce = static_cast<RingAllReduce*>(arg);
+        if (++all_reduce->arrived_count == all_reduce->npus_count) {
+            all_reduce->run_step();
+        }
+    }
+
+    void run_step() noexcept {
+        if (step == steps_count) {
+            return;
+        }
+        step++;
+        arrived_count = 0;
+
+        for (int npu = 0; npu < npus_count; npu++) {
+            auto route = topology.route(npu, (npu + 1) % npus_count);
+            hops_count += static_cast<int64_t>(route.size()) - 1;
+            topology.send(std::make_unique<Chunk>(chunk_size, route, chunk_arrived, this));
+        }
+    }
+
+    [[nodiscard]] int64_t get_hops_count() const noexcept {
+        return hops_count;
+    }
+
+  private:
+    Topology& topology;
+    int npus_count;
+    ChunkSize chunk_size;
+    int steps_count;
+    int step;
+    int arrived_count;
+    int64_t hops_count;
+};
+
+}  // namespace
+
+static void BM_CongestionAware_AllToAll(benchmark::State& state) {
+    const auto config = make_config(static_cast<int>(state.range(0)));
+    const auto topology = construct_topology(NetworkParser(config.get_path()));
+    topology->set_hybrid_mode(state.range(1) != 0);
+    const auto npus_count = topology->get_npus_count();
+    const auto chunk_size = ChunkSize{1'048'576};
+
+    auto hops_count = int64_t{0};
+    for (auto _ : state) {
+        auto event_queue = std::make_shared<EventQueue>();
+        Topology::set_event_queue(event_queue);
+        topology->reset();
+
+        for (int i = 0; i < npus_count; i++) {
+            for (int j = 0; j < npus_count; j++) {
+                if (i == j) {
+                    continue;
+                }
+                auto route = topology->route(i, j);
+                hops_count += static_cast<int64_t>(route.size()) - 1;
+                topology->send(std::make_unique<Chunk>(chunk_size, route, noop_callback, nullptr));
+            }
+        }
+        while (!event_queue->finished()) {
+            event_queue->proceed();
+        }
+
+        benchmark::DoNotOptimize(event_queue->get_current_time());
+    }
+
+    report_events(state, static_cast<double>(hops_count) * events_per_hop);
+    report_peak_rss(state);
+}
+BENCHMARK(BM_CongestionAware_AllToAll)
+    ->ArgNames({"npus", "hybrid"})
+    ->ArgsProduct({{64, 256}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_CongestionAware_RingAllReduce(benchmark::State& state) {
+    const auto config = make_config(static_cast<int>(state.range(0)));
+    const auto topology = construct_topology(NetworkParser(config.get_path()));
+    topology->set_hybrid_mode(state.range(1) != 0);
+    const auto npus_count = topology->get_npus_count();
+    const auto chunk_size = ChunkSize{1'048'576} / npus_count;
+
+    auto hops_count = int64_t{0};
+    for (auto _ : state) {
+        auto event_queue = std::make_shared<EventQueue>();
+        Topology::set_event_queue(event_queue);
+        topology->reset();
+
+        auto all_reduce = RingAllReduce(*topology, chunk_size);
+        all_reduce.run_step();
+        while (!event_queue->finished()) {
+            event_queue->proceed();
+        }
+
+        hops_count += all_reduce.get_hops_count();
+        benchmark::DoNotOptimize(event_queue->get_current_time());
+    }
+
+    report_events(state, static_cast<double>(hops_count) * events_per_hop);
+    report_peak_rss(state);
+}
+BENCHMARK(BM_CongestionAware_RingAllReduce)
+    ->ArgNames({"npus", "hybrid"})
+    ->ArgsProduct({{64, 256}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_CongestionAware_RingAllReduceDag(benchmark::State& state) {
+    const auto config = make_config(static_cast<int>(state.range(0)));
+    const auto topology = construct_topology(NetworkParser(config.get_path()));
+    const auto npus_count = topology->get_npus_count();
+    const auto chunk_size = ChunkSize{1'048'576} / npus_count;
+
+    // ring all-reduce as a DAG: step s + 1 of NPU i waits for step s of NPU (i - 1)
+    const auto generator = CollectiveGenerator(topology);
+    const auto schedule =
+        generator.generate(CollectiveOperation::AllReduce, CollectiveAlgorithm::Ring, chunk_size * npus_count);
+    auto dag_hops_count = int64_t{0};
+    for (const auto& node : schedule.nodes) {
+        dag_hops_count += static_cast<int64_t>(topology->route(node.src, node.dest).size()) - 1;
+    }
+
+    auto hops_count = int64_t{0};
+    for (auto _ : state) {
+        auto event_queue = std::make_shared<EventQueue>();
+        Topology::set_event_queue(event_queue);
+        topology->reset();
+
+        auto dag_executor = DagExecutor(topology, event_queue, schedule.nodes, schedule.edges);
+        dag_executor.start();
+        while (!event_queue->finished()) {
+            event_queue->proceed();
+        }
+
+        hops_count += dag_hops_count;
+        benchmark::DoNotOptimize(event_queue->get_current_time());
+    }
+
+    report_events(state, static_cast<double>(hops_count) * events_per_hop);
+    report_peak_rss(state);
+}
+BENCHMARK(BM_CongestionAware_RingAllReduceDag)->ArgName("npus")->Arg(64)->Arg(256)->Unit(benchmark::kMillisecond);
+
+static void BM_CongestionAware_Permutation(benchmark::State& state) {
+    const auto config = make_config(static_cast<int>(state.range(0)));
+    const auto topology = construct_topology(NetworkParser(config.get_path()));
+    topology->set_hybrid_mode(state.range(1) != 0);
+    const auto npus_count = topology->get_npus_count();
+    const auto chunk_size = ChunkSize{65'536};
+
+    // lightly loaded: every NPU sends to its farthest peer, with sends spread over time
+    auto hops_count = int64_t{0};
+    for (auto _ : state) {
+        auto event_queue = std::make_shared<EventQueue>();
+        Topology::set_event_queue(event_queue);
+        topology->reset();
+
+        for (int i = 0; i < npus_count; i++) {
+            while (!event_queue->finished() && event_queue->get_current_time() < i * EventTime{1'000}) {
+                event_queue->proceed();
+            }
+            auto route = topology->route(i, npus_count - 1 - i);
+            hops_count += static_cast<int64_t>(route.size()) - 1;
+            topology->send(std::make_unique<Chunk>(chunk_size, route, noop_callback, nullptr));
+        }
+        while (!event_queue->finished()) {
+            event_queue->proceed();
+        }
+
+        benchmark::DoNotOptimize(event_queue->get_current_time());
+    }
+
+    report_events(state, static_cast<double>(hops_count) * events_per_hop);
+    report_peak_rss(state);
+}
+BENCHMARK(BM_CongestionAware_Permutation)
+    ->ArgNames({"npus", "hybrid"})
+    ->ArgsProduct({{256, 4096}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,125 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "bench_common.h"
+#include "common/NetworkParser.h"
+#include "common/Type.h"
+#include "congestion_unaware/CollectiveModel.h"
+#include "congestion_unaware/Helper.h"
+#include <algorithm>
+#include <benchmark/benchmark.h>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionUnaware;
+using namespace BenchAnalytical;
+
+namespace {
+
+/// Ring(npus / 32) x FullyConnected(4) x Switch(8)
+NetworkConfigFile make_config(const int npus_count) noexcept {
+    return NetworkConfigFile("bench_collective_congestion_unaware.yml", {"Ring", "FullyConnected", "Switch"},
+                             {npus_count / 32, 4, 8}, {200.0, 100.0, 50.0}, {50.0, 500.0, 2000.0});
+}
+
+}  // namespace
+
+static void BM_CongestionUnaware_AllToAll(benchmark::State& state) {
+    // without congestion, all pairs transfer concurrently: the slowest pair finishes last
+    const auto config = make_config(static_cast<int>(state.range(0)));
+    const auto topology = construct_topology(NetworkParser(config.get_path()));
+    const auto npus_count = topology->get_npus_count();
+    const auto chunk_size = ChunkSize{1'048'576};
+
+    for (auto _ : state) {
+        auto finish_time = EventTime{0};
+        for (int i = 0; i < npus_count; i++) {
+            for (int j = 0; j < npus_count; j++) {
+                if (i != j) {
+                    finish_time = std::max(finish_time, topology->send(i, j, chunk_size));
+                }
+            }
+        }
+        benchmark::DoNotOptimize(finish_time);
+    }
+
+    // every send() is one event
+    report_events(state, static_cast<double>(state.iterations()) * npus_count * (npus_count - 1));
+    report_peak_rss(state);
+}
+BENCHMARK(BM_CongestionUnaware_AllToAll)->ArgName("npus")->Arg(64)->Arg(256)->Arg(1024)->Unit(benchmark::kMillisecond);
+
+static void BM_CongestionEstimated_AllToAll(benchmark::State& state) {
+    // same traffic as BM_CongestionUnaware_AllToAll, through send_at() with the M/D/1 term
+    const auto config = make_config(static_cast<int>(state.range(0)));
+    const auto topology = construct_topology(NetworkParser(config.get_path()));
+    topology->enable_congestion_estimation(CongestionModel::MD1, 1'000'000);
+    const auto npus_count = topology->get_npus_count();
+    const auto chunk_size = ChunkSize{1'048'576};
+
+    auto send_time = EventTime{0};
+    for (auto _ : state) {
+        auto finish_time = EventTime{0};
+        for (int i = 0; i < npus_count; i++) {
+            for (int j = 0; j < npus_count; j++) {
+                if (i != j) {
+                    finish_time = std::max(finish_time, topology->send_at(i, j, chunk_size, send_time));
+                }
+            }
+        }
+        benchmark::DoNotOptimize(finish_time);
+
+        // next iteration starts on drained links
+        send_time += 10'000'000;
+    }
+
+    report_events(state, static_cast<double>(state.iterations()) * npus_count * (npus_count - 1));
+    report_peak_rss(state);
+}
+BENCHMARK(BM_CongestionEstimated_AllToAll)->ArgName("npus")->Arg(64)->Arg(256)->Arg(1024)->Unit(benchmark::kMillisecond);
+
+static void BM_CongestionUnaware_RingAllReduce(benchmark::State& state) {
+    // 2(n-1) steps, each step is bounded by its slowest neighbour transfer
+    const auto config = make_config(static_cast<int>(state.range(0)));
+    const auto topology = construct_topology(NetworkParser(config.get_path()));
+    const auto npus_count = topology->get_npus_count();
+    const auto chunk_size = ChunkSize{1'048'576} / npus_count;
+    const auto steps_count = 2 * (npus_count - 1);
+
+    for (auto _ : state) {
+        auto finish_time = EventTime{0};
+        for (int step = 0; step < steps_count; step++) {
+            auto step_time = EventTime{0};
+            for (int npu = 0; npu < npus_count; npu++) {
+                step_time = std::max(step_time, topology->send(npu, (npu + 1) % npus_count, chunk_size));
+            }
+            finish_time += step_time;
+        }
+        benchmark::DoNotOptimize(finish_time);
+    }
+
+    report_events(state, static_cast<double>(state.iterations()) * steps_count * npus_count);
+    report_peak_rss(state);
+}
+BENCHMARK(BM_CongestionUnaware_RingAllReduce)->ArgName("npus")->Arg(64)->Arg(256)->Arg(1024)->Unit(benchmark::kMillisecond);
+
+static void BM_CollectiveModel_Estimate(benchmark::State& state) {
+    // closed form: cost doesn't depend on the NPUs count beyond log(npus)
+    const auto config = make_config(static_cast<int>(state.range(0)));
+    const auto topology = construct_topology(NetworkParser(config.get_path()));
+    const auto collective_model = CollectiveModel(topology, 8);
+    const auto collective_size = ChunkSize{1'048'576};
+
+    for (auto _ : state) {
+        for (const auto algorithm : {CollectiveAlgorithm::Ring, CollectiveAlgorithm::Direct,
+                                     CollectiveAlgorithm::HalvingDoubling, CollectiveAlgorithm::DoubleBinaryTree,
+                                     CollectiveAlgorithm::Hierarchical}) {
+            benchmark::DoNotOptimize(
+                collective_model.estimate(CollectiveOperation::AllReduce, algorithm, collective_size));
+        }
+    }
+
+    report_events(state, static_cast<double>(state.iterations()) * 5);
+}
+BENCHMARK(BM_CollectiveModel_Estimate)->ArgName("npus")->Arg(1024)->Arg(131072);
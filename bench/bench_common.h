@@ -0,0 +1,110 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <sys/resource.h>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Helpers shared by the benchmark targets.
+ */
+namespace BenchAnalytical {
+
+/**
+ * Attach the peak resident set size of the process to the benchmark report.
+ * ru_maxrss is a process-wide high-water mark, so run a single benchmark
+ * (--benchmark_filter) to attribute it precisely.
+ *
+ * @param state benchmark state to report to
+ */
+inline void report_peak_rss(benchmark::State& state) noexcept {
+    auto usage = rusage();
+    getrusage(RUSAGE_SELF, &usage);
+
+    // ru_maxrss is in KiB on Linux
+    state.counters["peak_rss_MiB"] = static_cast<double>(usage.ru_maxrss) / 1024.0;
+}
+
+/**
+ * Report the number of processed events as a rate (events/s).
+ *
+ * @param state benchmark state to report to
+ * @param events_count number of events processed over all iterations
+ */
+inline void report_events(benchmark::State& state, const double events_count) noexcept {
+    state.counters["events"] = benchmark::Counter(events_count, benchmark::Counter::kIsRate);
+}
+
+/**
+ * Network config written to a temporary file, so that benchmarks can go through
+ * NetworkParser and construct_topology() exactly like a simulation run does.
+ * The file is removed when the object goes out of scope.
+ */
+class NetworkConfigFile {
+  public:
+    /**
+     * Write a network config.
+     *
+     * @param name file name (written to the working directory)
+     * @param topologies topology name per dimension (e.g., "Ring")
+     * @param npus_counts NPUs count per dimension
+     * @param bandwidths bandwidth per dimension in GB/s
+     * @param latencies latency per dimension in ns
+     */
+    NetworkConfigFile(std::string name,
+                      const std::vector<std::string>& topologies,
+                      const std::vector<int>& npus_counts,
+                      const std::vector<double>& bandwidths,
+                      const std::vector<double>& latencies) noexcept
+        : path(std::move(name)) {
+        auto file = std::ofstream(path);
+        file << "topology: " << to_yaml_list(topologies) << "\n";
+        file << "npus_count: " << to_yaml_list(npus_counts) << "\n";
+        file << "bandwidth: " << to_yaml_list(bandwidths) << "\n";
+        file << "latency: " << to_yaml_list(latencies) << "\n";
+    }
+
+    NetworkConfigFile(const NetworkConfigFile&) = delete;
+    NetworkConfigFile& operator=(const NetworkConfigFile&) = delete;
+
+    ~NetworkConfigFile() {
+        std::remove(path.c_str());
+    }
+
+    /**
+     * Get the path of the written config.
+     *
+     * @return path of the config file
+     */
+    [[nodiscard]] const std::string& get_path() const noexcept {
+        return path;
+    }
+
+  private:
+    /// path of the config file
+    std::string path;
+
+    template <typename T>
+    static std::string to_yaml_list(const std::vector<T>& values) noexcept {
+        auto list = std::string("[ ");
+        for (size_t i = 0; i < values.size(); i++) {
+            if constexpr (std::is_same_v<T, std::string>) {
+                list += values[i];
+            } else {
+                list += std::to_string(values[i]);
+            }
+            list += (i + 1 < values.size()) ? ", " : " ";
+        }
+        return list + "]";
+    }
+};
+
+}  // namespace BenchAnalytical
@@ -0,0 +1,128 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "bench_common.h"
+#include "common/EventQueue.h"
+#include "common/Type.h"
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+using namespace NetworkAnalytical;
+using namespace BenchAnalytical;
+
+namespace {
+
+/// timestamp distributions of scheduled events
+enum class Distribution {
+    Ascending,   // each event lands after all scheduled ones (worst case for the list walk)
+    Descending,  // each event lands before all scheduled ones
+    Uniform,     // uniformly random over the horizon
+    Clustered,   // few distinct timestamps, many events per timestamp
+};
+
+void noop_callback(void* const arg) noexcept {
+    benchmark::DoNotOptimize(arg);
+}
+
+std::vector<EventTime> make_timestamps(const Distribution distribution, const int events_count) noexcept {
+    auto timestamps = std::vector<EventTime>(events_count);
+    auto rng = std::mt19937_64(42);
+
+    for (int i = 0; i < events_count; i++) {
+        switch (distribution) {
+        case Distribution::Ascending:
+            timestamps[i] = i + 1;
+            break;
+        case Distribution::Descending:
+            timestamps[i] = events_count - i;
+            break;
+        case Distribution::Uniform:
+            timestamps[i] = 1 + rng() % events_count;
+            break;
+        case Distribution::Clustered:
+            timestamps[i] = 1 + rng() % std::max(1, events_count / 64);
+            break;
+        }
+    }
+
+    return timestamps;
+}
+
+/// state of the hold model: every invoked event schedules one more
+struct HoldModel {
+    EventQueue* event_queue;
+    std::mt19937_64 rng;
+    int remaining;
+
+    static void hold_callback(void* const arg) noexcept {
+        auto* const hold_model = static_cast<HoldModel*>(arg);
+        if (hold_model->remaining <= 0) {
+            return;
+        }
+        hold_model->remaining--;
+
+        // reschedule within a window of 1 to 1024 ns
+        const auto delta = 1 + (hold_model->rng() % 1024);
+        const auto event_time = hold_model->event_queue->get_current_time() + delta;
+        hold_model->event_queue->schedule_event(event_time, hold_callback, arg);
+    }
+};
+
+}  // namespace
+
+static void BM_EventQueue_ScheduleThenProceed(benchmark::State& state) {
+    const auto distribution = static_cast<Distribution>(state.range(0));
+    const auto events_count = static_cast<int>(state.range(1));
+    const auto timestamps = make_timestamps(distribution, events_count);
+
+    for (auto _ : state) {
+        auto event_queue = EventQueue();
+
+        for (const auto timestamp : timestamps) {
+            event_queue.schedule_event(timestamp, noop_callback, nullptr);
+        }
+        while (!event_queue.finished()) {
+            event_queue.proceed();
+        }
+
+        benchmark::DoNotOptimize(event_queue.get_current_time());
+    }
+
+    report_events(state, static_cast<double>(state.iterations()) * events_count);
+    report_peak_rss(state);
+}
+BENCHMARK(BM_EventQueue_ScheduleThenProceed)
+    ->ArgNames({"distribution", "events"})
+    ->ArgsProduct({{static_cast<int>(Distribution::Ascending), static_cast<int>(Distribution::Descending),
+                    static_cast<int>(Distribution::Uniform), static_cast<int>(Distribution::Clustered)},
+                   {1 << 10, 1 << 13}})
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_EventQueue_Hold(benchmark::State& state) {
+    // classic hold model: a steady population of pending events,
+    // where each proceeded event schedules a new one
+    const auto pending_count = static_cast<int>(state.range(0));
+    const auto events_count = 1 << 14;
+
+    for (auto _ : state) {
+        auto event_queue = EventQueue();
+        auto hold_model = HoldModel{&event_queue, std::mt19937_64(42), events_count - pending_count};
+
+        for (int i = 0; i < pending_count; i++) {
+            event_queue.schedule_event(1 + (hold_model.rng() % 1024), HoldModel::hold_callback, &hold_model);
+        }
+        while (!event_queue.finished()) {
+            event_queue.proceed();
+        }
+
+        benchmark::DoNotOptimize(event_queue.get_current_time());
+    }
+
+    report_events(state, static_cast<double>(state.iterations()) * events_count);
+    report_peak_rss(state);
+}
+BENCHMARK(BM_EventQueue_Hold)->ArgName("pending")->RangeMultiplier(4)->Range(16, 4096)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,111 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "bench_common.h"
+#include "common/EventQueue.h"
+#include "common/Instrumentation.h"
+#include "common/NetworkParser.h"
+#include "common/Type.h"
+#include "congestion_aware/Chunk.h"
+#include "congestion_aware/Helper.h"
+#include <array>
+#include <benchmark/benchmark.h>
+#include <type_traits>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+using namespace BenchAnalytical;
+
+namespace {
+
+/// policy marker: the loop body without any hook call, i.e., the uninstrumented baseline
+struct NoInstrumentation {};
+
+void noop_callback(void* const arg) noexcept {}
+
+/**
+ * Mimics the per-hop work of the hot path (schedule an event, forward a hop,
+ * enqueue into a link queue) on a small ring, calling the policy hooks in between.
+ */
+template <typename Policy>
+void bench_hooks(benchmark::State& state) noexcept {
+    auto queue = std::array<uint64_t, 64>();
+    auto head = size_t{0};
+    auto tail = size_t{0};
+
+    for (auto _ : state) {
+        for (uint64_t i = 0; i < 1024; i++) {
+            queue[tail] = i;
+            tail = (tail + 1) % queue.size();
+            if constexpr (!std::is_same_v<Policy, NoInstrumentation>) {
+                Policy::event_scheduled();
+                Policy::hop_forwarded();
+                Policy::queue_depth_sampled((tail + queue.size() - head) % queue.size());
+            }
+            if (i % 3 == 0) {
+                head = (head + 1) % queue.size();
+            }
+        }
+        benchmark::DoNotOptimize(queue.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * 1024);
+}
+
+}  // namespace
+
+static void BM_InstrumentationHooks_None(benchmark::State& state) {
+    bench_hooks<NoInstrumentation>(state);
+}
+BENCHMARK(BM_InstrumentationHooks_None);
+
+static void BM_InstrumentationHooks_Null(benchmark::State& state) {
+    bench_hooks<NullInstrumentation>(state);
+}
+BENCHMARK(BM_InstrumentationHooks_Null);
+
+static void BM_InstrumentationHooks_Counting(benchmark::State& state) {
+    bench_hooks<CountingInstrumentation>(state);
+}
+BENCHMARK(BM_InstrumentationHooks_Counting);
+
+static void BM_Instrumentation_AllToAll(benchmark::State& state) {
+    // end-to-end run with the policy selected at build time (NETWORK_BACKEND_INSTRUMENTATION);
+    // compare builds to measure its overhead
+    const auto topology = construct_topology(NetworkParser(BENCH_INPUT_DIR "/Ring_FullyConnected_Switch.yml"));
+    const auto npus_count = topology->get_npus_count();
+    const auto chunk_size = ChunkSize{1'048'576};
+    Instrumentation::reset();
+
+    for (auto _ : state) {
+        auto event_queue = std::make_shared<EventQueue>();
+        Topology::set_event_queue(event_queue);
+        topology->reset();
+
+        for (int i = 0; i < npus_count; i++) {
+            for (int j = 0; j < npus_count; j++) {
+                if (i != j) {
+                    topology->send(std::make_unique<Chunk>(chunk_size, topology->route(i, j), noop_callback, nullptr));
+                }
+            }
+        }
+        while (!event_queue->finished()) {
+            event_queue->proceed();
+        }
+
+        benchmark::DoNotOptimize(event_queue->get_current_time());
+    }
+
+    // counters (per run) stay zero with the null policy
+    const auto counters = Instrumentation::get_counters();
+    const auto iterations = static_cast<double>(state.iterations());
+    state.SetLabel(std::is_same_v<Instrumentation, NullInstrumentation> ? "policy=none" : "policy=counters");
+    state.counters["events_scheduled"] = static_cast<double>(counters.events_scheduled) / iterations;
+    state.counters["hops_forwarded"] = static_cast<double>(counters.hops_forwarded) / iterations;
+    state.counters["max_queue_depth"] = static_cast<double>(counters.max_queue_depth);
+    report_peak_rss(state);
+}
+BENCHMARK(BM_Instrumentation_AllToAll)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,84 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "bench_common.h"
+#include "common/Type.h"
+#include "congestion_aware/BinaryTree.h"
+#include "congestion_aware/Bus.h"
+#include "congestion_aware/DoubleBinaryTree.h"
+#include "congestion_aware/FullyConnected.h"
+#include "congestion_aware/HyperCube.h"
+#include "congestion_aware/KingMesh2D.h"
+#include "congestion_aware/Mesh.h"
+#include "congestion_aware/Mesh2D.h"
+#include "congestion_aware/Ring.h"
+#include "congestion_aware/Switch.h"
+#include "congestion_aware/Torus2D.h"
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+using namespace BenchAnalytical;
+
+namespace {
+
+/// random (src, dest) NPU pairs with src != dest, so every call does real routing work
+std::vector<std::pair<DeviceId, DeviceId>> random_pairs(const int npus_count) noexcept {
+    auto rng = std::mt19937(42);
+    auto pick = std::uniform_int_distribution<DeviceId>(0, npus_count - 1);
+    auto pairs = std::vector<std::pair<DeviceId, DeviceId>>();
+
+    while (pairs.size() < 4096) {
+        const auto src = pick(rng);
+        const auto dest = pick(rng);
+        if (src != dest) {
+            pairs.emplace_back(src, dest);
+        }
+    }
+
+    return pairs;
+}
+
+template <typename BuildingBlock>
+void bench_route(benchmark::State& state) noexcept {
+    const auto npus_count = static_cast<int>(state.range(0));
+    const auto topology = BuildingBlock(npus_count, 50.0, 500.0);
+    const auto pairs = random_pairs(npus_count);
+
+    auto index = size_t{0};
+    for (auto _ : state) {
+        const auto& [src, dest] = pairs[index];
+        benchmark::DoNotOptimize(topology.route(src, dest));
+        index = (index + 1 == pairs.size()) ? 0 : index + 1;
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    report_peak_rss(state);
+}
+
+}  // namespace
+
+// every building block, at sizes valid for all of them (perfect squares and powers of two)
+#define BENCH_ROUTE(BuildingBlock)                                                                                     \
+    static void BM_Route_##BuildingBlock(benchmark::State& state) {                                                    \
+        bench_route<BuildingBlock>(state);                                                                             \
+    }                                                                                                                  \
+    BENCHMARK(BM_Route_##BuildingBlock)->ArgName("npus")->Arg(16)->Arg(64)->Arg(256)
+
+BENCH_ROUTE(Ring);
+BENCH_ROUTE(FullyConnected);
+BENCH_ROUTE(Switch);
+BENCH_ROUTE(Bus);
+BENCH_ROUTE(BinaryTree);
+BENCH_ROUTE(DoubleBinaryTree);
+BENCH_ROUTE(Mesh);
+BENCH_ROUTE(HyperCube);
+BENCH_ROUTE(Torus2D);
+BENCH_ROUTE(Mesh2D);
+BENCH_ROUTE(KingMesh2D);
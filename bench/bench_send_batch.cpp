@@ -0,0 +1,108 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "bench_common.h"
+#include "common/NetworkParser.h"
+#include "common/Type.h"
+#include "congestion_unaware/Helper.h"
+#include "congestion_unaware/Ring.h"
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionUnaware;
+using namespace BenchAnalytical;
+
+namespace {
+
+/// number of chunks evaluated per iteration
+constexpr size_t messages_count = 1 << 16;
+
+/// random (src, dest, size) triples with src != dest
+struct Messages {
+    std::vector<DeviceId> src;
+    std::vector<DeviceId> dest;
+    std::vector<ChunkSize> chunk_size;
+    std::vector<EventTime> comms_delay;
+};
+
+Messages make_messages(const int npus_count) noexcept {
+    auto rng = std::mt19937(42);
+    auto npu_dist = std::uniform_int_distribution<DeviceId>(0, npus_count - 1);
+    auto size_dist = std::uniform_int_distribution<ChunkSize>(1'024, 1'048'576);
+
+    auto messages = Messages();
+    messages.comms_delay.resize(messages_count);
+    for (size_t i = 0; i < messages_count; i++) {
+        const auto src = npu_dist(rng);
+        auto dest = npu_dist(rng);
+        while (dest == src) {
+            dest = npu_dist(rng);
+        }
+        messages.src.push_back(src);
+        messages.dest.push_back(dest);
+        messages.chunk_size.push_back(size_dist(rng));
+    }
+    return messages;
+}
+
+/// Ring(npus / 32) x FullyConnected(4) x Switch(8)
+NetworkConfigFile make_config(const int npus_count) noexcept {
+    return NetworkConfigFile("bench_send_batch.yml", {"Ring", "FullyConnected", "Switch"}, {npus_count / 32, 4, 8},
+                             {200.0, 100.0, 50.0}, {50.0, 500.0, 2000.0});
+}
+
+void run_send(benchmark::State& state, const Topology& topology, Messages& messages) noexcept {
+    for (auto _ : state) {
+        for (size_t i = 0; i < messages_count; i++) {
+            messages.comms_delay[i] = topology.send(messages.src[i], messages.dest[i], messages.chunk_size[i]);
+        }
+        benchmark::ClobberMemory();
+    }
+    report_events(state, static_cast<double>(state.iterations()) * messages_count);
+}
+
+void run_send_batch(benchmark::State& state, const Topology& topology, Messages& messages) noexcept {
+    for (auto _ : state) {
+        topology.send_batch(messages.src.data(), messages.dest.data(), messages.chunk_size.data(),
+                            messages.comms_delay.data(), messages_count);
+        benchmark::ClobberMemory();
+    }
+    report_events(state, static_cast<double>(state.iterations()) * messages_count);
+}
+
+}  // namespace
+
+static void BM_Ring_Send(benchmark::State& state) {
+    const auto topology = std::make_shared<Ring>(static_cast<int>(state.range(0)), 50.0, 500.0, true);
+    auto messages = make_messages(topology->get_npus_count());
+    run_send(state, *topology, messages);
+}
+BENCHMARK(BM_Ring_Send)->ArgName("npus")->Arg(64)->Arg(1024);
+
+static void BM_Ring_SendBatch(benchmark::State& state) {
+    const auto topology = std::make_shared<Ring>(static_cast<int>(state.range(0)), 50.0, 500.0, true);
+    auto messages = make_messages(topology->get_npus_count());
+    run_send_batch(state, *topology, messages);
+}
+BENCHMARK(BM_Ring_SendBatch)->ArgName("npus")->Arg(64)->Arg(1024);
+
+static void BM_MultiDimTopology_Send(benchmark::State& state) {
+    const auto config = make_config(static_cast<int>(state.range(0)));
+    const auto topology = construct_topology(NetworkParser(config.get_path()));
+    auto messages = make_messages(topology->get_npus_count());
+    run_send(state, *topology, messages);
+}
+BENCHMARK(BM_MultiDimTopology_Send)->ArgName("npus")->Arg(256)->Arg(4096);
+
+static void BM_MultiDimTopology_SendBatch(benchmark::State& state) {
+    const auto config = make_config(static_cast<int>(state.range(0)));
+    const auto topology = construct_topology(NetworkParser(config.get_path()));
+    auto messages = make_messages(topology->get_npus_count());
+    run_send_batch(state, *topology, messages);
+}
+BENCHMARK(BM_MultiDimTopology_SendBatch)->ArgName("npus")->Arg(256)->Arg(4096);
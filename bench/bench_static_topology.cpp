@@ -0,0 +1,115 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "bench_common.h"
+#include "common/Type.h"
+#include "congestion_unaware/FullyConnected.h"
+#include "congestion_unaware/HyperCube.h"
+#include "congestion_unaware/MultiDimTopology.h"
+#include "congestion_unaware/Ring.h"
+#include "congestion_unaware/StaticTopology.h"
+#include "congestion_unaware/Switch.h"
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionUnaware;
+using namespace BenchAnalytical;
+
+namespace {
+
+/// number of chunks evaluated per iteration
+constexpr size_t messages_count = 1 << 16;
+
+/// random (src, dest) pairs with src != dest
+struct Messages {
+    std::vector<DeviceId> src;
+    std::vector<DeviceId> dest;
+};
+
+Messages make_messages(const int npus_count) noexcept {
+    auto rng = std::mt19937(42);
+    auto npu_dist = std::uniform_int_distribution<DeviceId>(0, npus_count - 1);
+
+    auto messages = Messages();
+    for (size_t i = 0; i < messages_count; i++) {
+        const auto src = npu_dist(rng);
+        auto dest = npu_dist(rng);
+        while (dest == src) {
+            dest = npu_dist(rng);
+        }
+        messages.src.push_back(src);
+        messages.dest.push_back(dest);
+    }
+    return messages;
+}
+
+/// evaluate every message through TopologyType::send()
+template <typename TopologyType> void run_send(benchmark::State& state, const TopologyType& topology) noexcept {
+    const auto messages = make_messages(topology.get_npus_count());
+    const auto chunk_size = ChunkSize{1'048'576};
+
+    for (auto _ : state) {
+        auto total_delay = EventTime{0};
+        for (size_t i = 0; i < messages_count; i++) {
+            total_delay += topology.send(messages.src[i], messages.dest[i], chunk_size);
+        }
+        benchmark::DoNotOptimize(total_delay);
+    }
+
+    report_events(state, static_cast<double>(state.iterations()) * messages_count);
+}
+
+/// Ring(2) x FullyConnected(8) x Switch(4), as Ring_FullyConnected_Switch.yml
+using StaticRingFullyConnectedSwitch =
+    StaticMultiDimTopology<StaticRing<2>, StaticFullyConnected<8>, StaticSwitch<4>>;
+
+}  // namespace
+
+static void BM_DynamicRing_Send(benchmark::State& state) {
+    // dispatched through the Topology interface, as construct_topology() hands it out
+    const auto topology = std::shared_ptr<Topology>(std::make_shared<Ring>(12, 50.0, 500.0));
+    run_send<Topology>(state, *topology);
+}
+BENCHMARK(BM_DynamicRing_Send);
+
+static void BM_StaticRing_Send(benchmark::State& state) {
+    const auto topology = StaticRing<12>(50.0, 500.0);
+    run_send(state, topology);
+}
+BENCHMARK(BM_StaticRing_Send);
+
+static void BM_DynamicHyperCube_Send(benchmark::State& state) {
+    const auto topology = std::shared_ptr<Topology>(std::make_shared<HyperCube>(64, 50.0, 500.0));
+    run_send<Topology>(state, *topology);
+}
+BENCHMARK(BM_DynamicHyperCube_Send);
+
+static void BM_StaticHyperCube_Send(benchmark::State& state) {
+    const auto topology = StaticHyperCube<6>(50.0, 500.0);
+    run_send(state, topology);
+}
+BENCHMARK(BM_StaticHyperCube_Send);
+
+static void BM_DynamicMultiDimTopology_Send(benchmark::State& state) {
+    auto multi_dim_topology = std::make_shared<MultiDimTopology>();
+    multi_dim_topology->append_dimension(std::make_unique<Ring>(2, 200.0, 50.0));
+    multi_dim_topology->append_dimension(std::make_unique<FullyConnected>(8, 100.0, 500.0));
+    multi_dim_topology->append_dimension(std::make_unique<Switch>(4, 50.0, 2'000.0));
+    multi_dim_topology->set_send_mode(static_cast<MultiDimSendMode>(state.range(0)));
+    const auto topology = std::shared_ptr<Topology>(multi_dim_topology);
+    run_send<Topology>(state, *topology);
+}
+BENCHMARK(BM_DynamicMultiDimTopology_Send)->ArgName("send_mode")->Arg(0)->Arg(1);
+
+static void BM_StaticMultiDimTopology_Send(benchmark::State& state) {
+    auto topology = StaticRingFullyConnectedSwitch(StaticRing<2>(200.0, 50.0), StaticFullyConnected<8>(100.0, 500.0),
+                                                   StaticSwitch<4>(50.0, 2'000.0));
+    topology.set_send_mode(static_cast<MultiDimSendMode>(state.range(0)));
+    run_send(state, topology);
+}
+BENCHMARK(BM_StaticMultiDimTopology_Send)->ArgName("send_mode")->Arg(0)->Arg(1);
@@ -0,0 +1,103 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/Type.h"
+#include "congestion_aware/MultiDimTopology.h"
+#include "congestion_aware/Switch.h"
+#include "congestion_aware/SwitchTranslationUnit.h"
+#include <benchmark/benchmark.h>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+
+namespace {
+
+/// deep switch hierarchies: every dimension is a Switch
+std::vector<int> switch_hierarchy_shape(const int dims_count, const int npus_per_dim) {
+    return std::vector<int>(dims_count, npus_per_dim);
+}
+
+/// enumerate every switch address of the hierarchy
+std::vector<MultiDimAddress> all_switch_addresses(const std::vector<int>& npus_count_per_dim) {
+    const auto dims_count = static_cast<int>(npus_count_per_dim.size());
+    auto addresses = std::vector<MultiDimAddress>();
+
+    for (int switch_dim = 0; switch_dim < dims_count; switch_dim++) {
+        // dims below switch_dim are zero, switch_dim holds the switch index, higher dims are free
+        auto address = MultiDimAddress(dims_count, 0);
+        address.at(switch_dim) = npus_count_per_dim.at(switch_dim);
+
+        while (true) {
+            addresses.push_back(address);
+
+            // odometer over higher dimensions
+            auto dim = switch_dim + 1;
+            while (dim < dims_count && ++address.at(dim) == npus_count_per_dim.at(dim)) {
+                address.at(dim) = 0;
+                dim++;
+            }
+            if (dim == dims_count) {
+                break;
+            }
+        }
+    }
+
+    return addresses;
+}
+
+}  // namespace
+
+static void BM_SwitchTranslationUnit_TranslateAddressToId(benchmark::State& state) {
+    const auto npus_count_per_dim = switch_hierarchy_shape(state.range(0), state.range(1));
+    const auto is_switch_dim = std::vector<bool>(npus_count_per_dim.size(), true);
+    const auto switch_translation_unit = SwitchTranslationUnit(npus_count_per_dim, is_switch_dim);
+    const auto addresses = all_switch_addresses(npus_count_per_dim);
+
+    auto index = size_t{0};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(switch_translation_unit.translate_address_to_id(addresses[index]));
+        index = (index + 1 == addresses.size()) ? 0 : index + 1;
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SwitchTranslationUnit_TranslateAddressToId)
+    ->ArgNames({"dims", "npus_per_dim"})
+    ->Args({2, 16})
+    ->Args({5, 4})
+    ->Args({6, 4})
+    ->Args({8, 2});
+
+static void BM_MultiDimTopology_RouteSwitchHierarchy(benchmark::State& state) {
+    const auto dims_count = static_cast<int>(state.range(0));
+    const auto npus_per_dim = static_cast<int>(state.range(1));
+
+    // build a switch-only hierarchy
+    auto topology = MultiDimTopology({}, std::vector<int>(dims_count, 0));
+    for (int dim = 0; dim < dims_count; dim++) {
+        topology.append_dimension(std::make_unique<Switch>(npus_per_dim, 50.0, 500.0, true, true));
+    }
+    topology.initialize_all_devices();
+    topology.build_switch_length_mapping();
+    topology.make_connections();
+
+    // route across every dimension: 0 -> (npus_count - 1)
+    const auto npus_count = topology.get_npus_count();
+    auto src = DeviceId{0};
+    for (auto _ : state) {
+        const auto dest = npus_count - 1 - src;
+        if (src != dest) {
+            benchmark::DoNotOptimize(topology.route(src, dest));
+        }
+        src = (src + 1 == npus_count) ? 0 : src + 1;
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MultiDimTopology_RouteSwitchHierarchy)
+    ->ArgNames({"dims", "npus_per_dim"})
+    ->Args({2, 16})
+    ->Args({5, 4})
+    ->Args({6, 4});
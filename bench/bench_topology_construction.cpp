@@ -0,0 +1,67 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "bench_common.h"
+#include "common/NetworkParser.h"
+#include "common/Type.h"
+#include "congestion_aware/FullyConnected.h"
+#include "congestion_aware/Helper.h"
+#include "congestion_aware/MultiDimTopology.h"
+#include "congestion_aware/Ring.h"
+#include "congestion_aware/Switch.h"
+#include <benchmark/benchmark.h>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+using namespace BenchAnalytical;
+
+static void BM_MultiDimTopology_Construction(benchmark::State& state) {
+    const auto threads_count = static_cast<int>(state.range(0));
+
+    for (auto _ : state) {
+        // Ring(64) x FullyConnected(16) x Switch(16): 16,384 NPUs
+        auto topology = MultiDimTopology({}, {0, 0, 0});
+        topology.append_dimension(std::make_unique<Ring>(64, 200.0, 50.0, true, true));
+        topology.append_dimension(std::make_unique<FullyConnected>(16, 100.0, 500.0, true, true));
+        topology.append_dimension(std::make_unique<Switch>(16, 50.0, 2000.0, true, true));
+
+        topology.initialize_all_devices(threads_count);
+        topology.build_switch_length_mapping();
+        topology.make_connections(threads_count);
+
+        benchmark::DoNotOptimize(topology.get_devices_count());
+    }
+
+    report_peak_rss(state);
+}
+BENCHMARK(BM_MultiDimTopology_Construction)
+    ->ArgName("threads")
+    ->RangeMultiplier(2)
+    ->Range(1, 32)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+static void BM_ConstructTopology(benchmark::State& state) {
+    // Ring(16) x FullyConnected(8) x Switch(npus / 128), through NetworkParser like a simulation run
+    const auto npus_count = static_cast<int>(state.range(0));
+    const auto config = NetworkConfigFile("bench_construct_topology.yml", {"Ring", "FullyConnected", "Switch"},
+                                          {16, 8, npus_count / 128}, {200.0, 100.0, 50.0}, {50.0, 500.0, 2000.0});
+
+    for (auto _ : state) {
+        const auto network_parser = NetworkParser(config.get_path());
+        const auto topology = construct_topology(network_parser);
+        benchmark::DoNotOptimize(topology->get_devices_count());
+    }
+
+    state.counters["npus"] = npus_count;
+    report_peak_rss(state);
+}
+BENCHMARK(BM_ConstructTopology)
+    ->ArgName("npus")
+    ->Arg(1 << 10)
+    ->Arg(1 << 14)
+    ->Arg(1 << 17)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
@@ -0,0 +1,249 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/DragonflyLayout.h"
+#include <cassert>
+
+using namespace NetworkAnalytical;
+
+namespace {
+
+/// splitmix64 finalizer
+uint64_t mix(uint64_t value) noexcept {
+    value += 0x9e3779b97f4a7c15ULL;
+    value = (value ^ (value >> 30U)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27U)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31U);
+}
+
+/// pick the index-th value of [0, count), skipping two distinct values
+int pick_skipping(int index, const int first_skipped, const int second_skipped) noexcept {
+    assert(first_skipped != second_skipped);
+
+    const auto low = (first_skipped < second_skipped) ? first_skipped : second_skipped;
+    const auto high = (first_skipped < second_skipped) ? second_skipped : first_skipped;
+    if (index >= low) {
+        index++;
+    }
+    if (index >= high) {
+        index++;
+    }
+    return index;
+}
+
+}  // namespace
+
+DragonflyLayout::DragonflyLayout(const int groups,
+                                 const int routers_per_group,
+                                 const int global_links_per_router,
+                                 const int npus_per_router,
+                                 const DragonflyArrangement arrangement) noexcept
+    : groups(groups),
+      routers_per_group(routers_per_group),
+      global_links_per_router(global_links_per_router),
+      npus_per_router(npus_per_router),
+      copies_count((routers_per_group * global_links_per_router) / (groups - 1)),
+      arrangement(arrangement) {
+    assert(groups >= 2);
+    assert(routers_per_group >= 1);
+    assert(1 <= global_links_per_router && global_links_per_router <= groups - 1);
+    assert(npus_per_router >= 1);
+    assert((routers_per_group * global_links_per_router) % (groups - 1) == 0);
+}
+
+int DragonflyLayout::get_npus_count() const noexcept {
+    return groups * routers_per_group * npus_per_router;
+}
+
+int DragonflyLayout::get_routers_count() const noexcept {
+    return groups * routers_per_group;
+}
+
+int DragonflyLayout::peer_group(const int group, const int offset) const noexcept {
+    assert(0 <= offset && offset < groups - 1);
+
+    switch (arrangement) {
+    case DragonflyArrangement::Absolute:
+        return (offset < group) ? offset : offset + 1;
+    case DragonflyArrangement::Relative:
+        return (group + offset + 1) % groups;
+    case DragonflyArrangement::Circulant: {
+        // offsets 0, 1, 2, 3, ... step +1, -1, +2, -2, ...
+        const auto step = (offset / 2) + 1;
+        return (offset % 2 == 0) ? (group + step) % groups : (group - step + groups) % groups;
+    }
+    default:
+        assert(false);
+        return -1;
+    }
+}
+
+int DragonflyLayout::offset_to(const int group, const int peer) const noexcept {
+    assert(group != peer);
+
+    switch (arrangement) {
+    case DragonflyArrangement::Absolute:
+        return (peer < group) ? peer : peer - 1;
+    case DragonflyArrangement::Relative:
+        return (peer - group - 1 + groups) % groups;
+    case DragonflyArrangement::Circulant: {
+        // a step of groups / 2 is taken forward only
+        const auto forward_step = (peer - group + groups) % groups;
+        return (forward_step <= groups / 2) ? 2 * (forward_step - 1) : (2 * (groups - forward_step - 1)) + 1;
+    }
+    default:
+        assert(false);
+        return -1;
+    }
+}
+
+DeviceId DragonflyLayout::append_global_hop(const DeviceId router,
+                                            const int peer,
+                                            const int copy,
+                                            DeviceId* const route,
+                                            int& length) const noexcept {
+    const auto npus_count = get_npus_count();
+    const auto group = (router - npus_count) / routers_per_group;
+
+    // leave the group through the gateway owning the global port
+    const auto port = offset_to(group, peer) + (copy * (groups - 1));
+    const auto gateway = npus_count + (group * routers_per_group) + (port / global_links_per_router);
+    if (gateway != router) {
+        route[length++] = gateway;
+    }
+
+    // arrive at the router owning the port of the peer group linking back
+    const auto peer_port = offset_to(peer, group) + (copy * (groups - 1));
+    const auto arrival = npus_count + (peer * routers_per_group) + (peer_port / global_links_per_router);
+    route[length++] = arrival;
+    return arrival;
+}
+
+int DragonflyLayout::minimal_route(const DeviceId src,
+                                   const DeviceId dest,
+                                   const uint64_t hash,
+                                   DeviceId* const route) const noexcept {
+    const auto npus_count = get_npus_count();
+    assert(0 <= src && src < npus_count);
+    assert(0 <= dest && dest < npus_count);
+
+    auto length = 0;
+    route[length++] = src;
+    if (src == dest) {
+        return length;
+    }
+
+    const auto src_router = npus_count + (src / npus_per_router);
+    const auto dest_router = npus_count + (dest / npus_per_router);
+    route[length++] = src_router;
+
+    if (src_router != dest_router) {
+        const auto src_group = (src_router - npus_count) / routers_per_group;
+        const auto dest_group = (dest_router - npus_count) / routers_per_group;
+
+        auto router = src_router;
+        if (src_group != dest_group) {
+            const auto copy = static_cast<int>(hash % static_cast<uint64_t>(copies_count));
+            router = append_global_hop(router, dest_group, copy, route, length);
+        }
+        if (router != dest_router) {
+            route[length++] = dest_router;
+        }
+    }
+
+    route[length++] = dest;
+    assert(length <= max_route_length);
+    return length;
+}
+
+int DragonflyLayout::valiant_route(const DeviceId src,
+                                   const DeviceId dest,
+                                   uint64_t hash,
+                                   DeviceId* const route) const noexcept {
+    const auto npus_count = get_npus_count();
+    assert(0 <= src && src < npus_count);
+    assert(0 <= dest && dest < npus_count);
+
+    const auto src_router = npus_count + (src / npus_per_router);
+    const auto dest_router = npus_count + (dest / npus_per_router);
+    const auto src_group = (src_router - npus_count) / routers_per_group;
+    const auto dest_group = (dest_router - npus_count) / routers_per_group;
+
+    if (src_group == dest_group) {
+        // detour through a third router of the group, if any
+        if (src_router == dest_router || routers_per_group <= 2) {
+            return minimal_route(src, dest, hash, route);
+        }
+
+        const auto group_router = npus_count + (src_group * routers_per_group);
+        const auto index = static_cast<int>(hash % static_cast<uint64_t>(routers_per_group - 2));
+        const auto intermediate = pick_skipping(index, src_router - group_router, dest_router - group_router);
+
+        auto length = 0;
+        route[length++] = src;
+        route[length++] = src_router;
+        route[length++] = group_router + intermediate;
+        route[length++] = dest_router;
+        route[length++] = dest;
+        return length;
+    }
+
+    // detour through a third group, if any
+    if (groups <= 2) {
+        return minimal_route(src, dest, hash, route);
+    }
+
+    const auto intermediate_group = pick_skipping(static_cast<int>(hash % static_cast<uint64_t>(groups - 2)),
+                                                  src_group, dest_group);
+    hash /= static_cast<uint64_t>(groups - 2);
+    const auto first_copy = static_cast<int>(hash % static_cast<uint64_t>(copies_count));
+    hash /= static_cast<uint64_t>(copies_count);
+    const auto second_copy = static_cast<int>(hash % static_cast<uint64_t>(copies_count));
+
+    auto length = 0;
+    route[length++] = src;
+    route[length++] = src_router;
+    auto router = append_global_hop(src_router, intermediate_group, first_copy, route, length);
+    router = append_global_hop(router, dest_group, second_copy, route, length);
+    if (router != dest_router) {
+        route[length++] = dest_router;
+    }
+    route[length++] = dest;
+
+    assert(length <= max_route_length);
+    return length;
+}
+
+std::vector<ConnectionPolicy> DragonflyLayout::get_router_links() const noexcept {
+    const auto npus_count = get_npus_count();
+    auto links = std::vector<ConnectionPolicy>();
+
+    for (auto group = 0; group < groups; group++) {
+        const auto group_router = npus_count + (group * routers_per_group);
+
+        // routers of a group are fully connected
+        for (auto router = 0; router < routers_per_group; router++) {
+            for (auto peer_router = 0; peer_router < routers_per_group; peer_router++) {
+                if (router != peer_router) {
+                    links.emplace_back(group_router + router, group_router + peer_router);
+                }
+            }
+        }
+
+        // every global port links out once; the peer port links back
+        for (auto port = 0; port < routers_per_group * global_links_per_router; port++) {
+            const auto peer = peer_group(group, port % (groups - 1));
+            const auto peer_port = offset_to(peer, group) + ((port / (groups - 1)) * (groups - 1));
+            links.emplace_back(group_router + (port / global_links_per_router),
+                               npus_count + (peer * routers_per_group) + (peer_port / global_links_per_router));
+        }
+    }
+
+    return links;
+}
+
+uint64_t DragonflyLayout::hash(const DeviceId src, const DeviceId dest, const uint64_t chunk_id) noexcept {
+    return mix(mix(mix(static_cast<uint64_t>(src)) ^ static_cast<uint64_t>(dest)) ^ chunk_id);
+}
@@ -15,3 +15,23 @@ Bandwidth NetworkAnalytical::bw_GBps_to_Bpns(const Bandwidth bw_GBps) noexcept {
     // 1 s is 10^9 ns
     return bw_GBps * (1 << 30) / (1'000'000'000);  // GB/s to B/ns
 }
+
+int NetworkAnalytical::ceil_log2(const int value) noexcept {
+    assert(value >= 1);
+
+    auto log = 0;
+    while ((1 << log) < value) {
+        log++;
+    }
+    return log;
+}
+
+int NetworkAnalytical::floor_log2(const int value) noexcept {
+    assert(value >= 1);
+
+    auto log = 0;
+    while ((2 << log) <= value) {
+        log++;
+    }
+    return log;
+}
@@ -26,10 +26,14 @@ void EventList::add_event(const Callback callback, const CallbackArg callback_ar
     events.emplace_back(callback, callback_arg);
 }
 
-void EventList::invoke_events() noexcept {
+uint64_t EventList::invoke_events() noexcept {
     // invoke all events in the event list
+    auto invoked_events_count = uint64_t{0};
     while (!events.empty()) {
         events.front().invoke_event();
         events.pop_front();
+        invoked_events_count++;
     }
+
+    return invoked_events_count;
 }
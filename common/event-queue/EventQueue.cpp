@@ -4,11 +4,16 @@ LICENSE file in the root directory of this source tree.
 *******************************************************************************/
 
 #include "common/EventQueue.h"
+#include "common/Instrumentation.h"
 #include <cassert>
 
 using namespace NetworkAnalytical;
 
-EventQueue::EventQueue() noexcept : current_time(0) {
+EventQueue::EventQueue() noexcept
+    : current_time(0),
+      invoked_events_count(0),
+      pending_events_count(0),
+      progress_reporter(nullptr) {
     // create empty event queue
     event_queue = std::list<EventList>();
 }
@@ -18,8 +23,9 @@ EventTime EventQueue::get_current_time() const noexcept {
 }
 
 bool EventQueue::finished() const noexcept {
-    // check whether event queue is empty
-    return event_queue.empty();
+    // check whether event queue is empty, or the current progress reporter stopped the run early
+    // (replacing or removing the reporter resumes the run)
+    return event_queue.empty() || (progress_reporter != nullptr && progress_reporter->stop_requested());
 }
 
 void EventQueue::proceed() noexcept {
@@ -32,12 +38,20 @@ void EventQueue::proceed() noexcept {
     // check the validity and update current time
     assert(current_event_list.get_event_time() > current_time);
     current_time = current_event_list.get_event_time();
+    Instrumentation::event_time_proceeded();
 
     // invoke events
-    current_event_list.invoke_events();
+    const auto invoked_count = current_event_list.invoke_events();
+    invoked_events_count += invoked_count;
+    pending_events_count -= invoked_count;
 
     // drop processed event list
     event_queue.pop_front();
+
+    // report progress
+    if (progress_reporter != nullptr) {
+        progress_reporter->on_proceed(current_time, invoked_events_count, pending_events_count);
+    }
 }
 
 void EventQueue::schedule_event(const EventTime event_time,
@@ -68,4 +82,18 @@ void EventQueue::schedule_event(const EventTime event_time,
     // now, whether (1) or (2), the entry to insert the event is found
     // add event to event_list
     event_list_it->add_event(callback, callback_arg);
+    pending_events_count++;
+    Instrumentation::event_scheduled();
+}
+
+uint64_t EventQueue::get_invoked_events_count() const noexcept {
+    return invoked_events_count;
+}
+
+uint64_t EventQueue::get_pending_events_count() const noexcept {
+    return pending_events_count;
+}
+
+void EventQueue::set_progress_reporter(std::shared_ptr<ProgressReporter> progress_reporter) noexcept {
+    this->progress_reporter = std::move(progress_reporter);
 }
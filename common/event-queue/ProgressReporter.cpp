@@ -0,0 +1,93 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/ProgressReporter.h"
+#include <cassert>
+#include <iostream>
+
+using namespace NetworkAnalytical;
+
+void ProgressReporter::print_sample(const ProgressSample& sample) noexcept {
+    std::cout << "[Progress] simulated_time=" << sample.simulated_time << "ns"
+              << " wall_time=" << sample.wall_time << "s"
+              << " events=" << sample.events_count << " events_per_sec=" << sample.events_per_second
+              << " pending_events=" << sample.pending_events_count
+              << " chunks_in_flight=" << sample.chunks_in_flight << std::endl;
+}
+
+ProgressReporter::ProgressReporter(const uint64_t events_interval,
+                                   const double wall_time_interval,
+                                   ProgressCallback callback) noexcept
+    : events_interval(events_interval),
+      wall_time_interval(wall_time_interval),
+      callback(std::move(callback)),
+      chunks_in_flight_counter(),
+      stop_condition(),
+      stopped(false),
+      start_time(Clock::now()),
+      last_sample_time(start_time),
+      last_sample_events_count(0),
+      proceeds_since_wall_time_check(0) {
+    assert(wall_time_interval >= 0);
+    assert(this->callback != nullptr);
+}
+
+void ProgressReporter::set_chunks_in_flight_counter(ChunksInFlightCounter chunks_in_flight_counter) noexcept {
+    this->chunks_in_flight_counter = std::move(chunks_in_flight_counter);
+}
+
+void ProgressReporter::set_stop_condition(StopCondition stop_condition) noexcept {
+    this->stop_condition = std::move(stop_condition);
+}
+
+bool ProgressReporter::stop_requested() const noexcept {
+    return stopped;
+}
+
+void ProgressReporter::on_proceed(const EventTime simulated_time,
+                                  const uint64_t events_count,
+                                  const uint64_t pending_events_count) noexcept {
+    // event-count trigger
+    if (events_interval > 0 && events_count - last_sample_events_count >= events_interval) {
+        sample(simulated_time, events_count, pending_events_count);
+        return;
+    }
+
+    // wall-time trigger, reading the clock only every few proceeds
+    if (wall_time_interval > 0 && ++proceeds_since_wall_time_check >= wall_time_check_period) {
+        proceeds_since_wall_time_check = 0;
+        const auto elapsed = std::chrono::duration<double>(Clock::now() - last_sample_time).count();
+        if (elapsed >= wall_time_interval) {
+            sample(simulated_time, events_count, pending_events_count);
+        }
+    }
+}
+
+void ProgressReporter::sample(const EventTime simulated_time,
+                              const uint64_t events_count,
+                              const uint64_t pending_events_count) noexcept {
+    const auto now = Clock::now();
+    const auto since_last_sample = std::chrono::duration<double>(now - last_sample_time).count();
+    const auto new_events_count = events_count - last_sample_events_count;
+
+    auto progress_sample = ProgressSample();
+    progress_sample.simulated_time = simulated_time;
+    progress_sample.wall_time = std::chrono::duration<double>(now - start_time).count();
+    progress_sample.events_count = events_count;
+    progress_sample.events_per_second = (since_last_sample > 0) ? (new_events_count / since_last_sample) : 0.0;
+    progress_sample.pending_events_count = pending_events_count;
+    progress_sample.chunks_in_flight = (chunks_in_flight_counter != nullptr) ? chunks_in_flight_counter() : 0;
+
+    last_sample_time = now;
+    last_sample_events_count = events_count;
+    proceeds_since_wall_time_check = 0;
+
+    callback(progress_sample);
+
+    // stop the run once the condition is met
+    if (stop_condition != nullptr && stop_condition(progress_sample)) {
+        stopped = true;
+    }
+}
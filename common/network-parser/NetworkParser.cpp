@@ -4,12 +4,23 @@ LICENSE file in the root directory of this source tree.
 *******************************************************************************/
 
 #include "common/NetworkParser.h"
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 
 using namespace NetworkAnalytical;
 
-NetworkParser::NetworkParser(const std::string& path) noexcept : dims_count(-1) {
+NetworkParser::NetworkParser(const std::string& path) noexcept
+    : dims_count(-1),
+      multi_dim_send_mode(MultiDimSendMode::FirstDim),
+      radix(0),
+      tiers(0),
+      oversubscription(1),
+      groups(0),
+      routers_per_group(0),
+      global_links_per_router(0),
+      dragonfly_arrangement(DragonflyArrangement::Absolute),
+      dragonfly_routing(DragonflyRouting::Minimal) {
     // initialize values
     npus_count_per_dim = {};
     bandwidth_per_dim = {};
@@ -17,6 +28,8 @@ NetworkParser::NetworkParser(const std::string& path) noexcept : dims_count(-1)
     topology_per_dim = {};
     faulty_links = {};
     non_recursive_topo = {};
+    shape = {};
+    wraparound = {};
 
     try {
         // load network config file
@@ -71,6 +84,50 @@ std::vector<int> NetworkParser::get_non_recursive_topo() const noexcept {
     return non_recursive_topo;
 }
 
+MultiDimSendMode NetworkParser::get_multi_dim_send_mode() const noexcept {
+    return multi_dim_send_mode;
+}
+
+std::vector<int> NetworkParser::get_shape() const noexcept {
+    return shape;
+}
+
+std::vector<bool> NetworkParser::get_wraparound() const noexcept {
+    return wraparound;
+}
+
+int NetworkParser::get_radix() const noexcept {
+    return radix;
+}
+
+int NetworkParser::get_tiers() const noexcept {
+    return tiers;
+}
+
+int NetworkParser::get_oversubscription() const noexcept {
+    return oversubscription;
+}
+
+int NetworkParser::get_groups() const noexcept {
+    return groups;
+}
+
+int NetworkParser::get_routers_per_group() const noexcept {
+    return routers_per_group;
+}
+
+int NetworkParser::get_global_links_per_router() const noexcept {
+    return global_links_per_router;
+}
+
+DragonflyArrangement NetworkParser::get_dragonfly_arrangement() const noexcept {
+    return dragonfly_arrangement;
+}
+
+DragonflyRouting NetworkParser::get_dragonfly_routing() const noexcept {
+    return dragonfly_routing;
+}
+
 void NetworkParser::parse_network_config_yml(const YAML::Node& network_config) noexcept {
     // parse topology_per_dim
     const auto topology_names = parse_vector<std::string>(network_config["topology"]);
@@ -108,6 +165,51 @@ void NetworkParser::parse_network_config_yml(const YAML::Node& network_config) n
         non_recursive_topo.resize(dims_count, 0);
     }
 
+    // parse multi-dimension send mode (optional)
+    if (network_config["multi_dim_send"]) {
+        multi_dim_send_mode = parse_multi_dim_send_mode(network_config["multi_dim_send"].as<std::string>());
+    }
+
+    // parse the axes of a TorusND or MeshND topology (optional)
+    if (network_config["shape"]) {
+        shape = parse_vector<int>(network_config["shape"]);
+    }
+    if (network_config["wraparound"]) {
+        for (const auto axis_wraparound : parse_vector<int>(network_config["wraparound"])) {
+            wraparound.push_back(axis_wraparound != 0);
+        }
+    } else if (!topology_per_dim.empty()) {
+        wraparound.resize(shape.size(), topology_per_dim[0] == TopologyBuildingBlock::TorusND);
+    }
+
+    // parse the switches of a FatTree topology (optional)
+    if (network_config["radix"]) {
+        radix = network_config["radix"].as<int>();
+    }
+    if (network_config["tiers"]) {
+        tiers = network_config["tiers"].as<int>();
+    }
+    if (network_config["oversubscription"]) {
+        oversubscription = network_config["oversubscription"].as<int>();
+    }
+
+    // parse the groups and routing of a Dragonfly topology (optional)
+    if (network_config["groups"]) {
+        groups = network_config["groups"].as<int>();
+    }
+    if (network_config["routers_per_group"]) {
+        routers_per_group = network_config["routers_per_group"].as<int>();
+    }
+    if (network_config["global_links_per_router"]) {
+        global_links_per_router = network_config["global_links_per_router"].as<int>();
+    }
+    if (network_config["arrangement"]) {
+        dragonfly_arrangement = parse_dragonfly_arrangement(network_config["arrangement"].as<std::string>());
+    }
+    if (network_config["routing"]) {
+        dragonfly_routing = parse_dragonfly_routing(network_config["routing"].as<std::string>());
+    }
+
     // check the validity of the parsed network config
     check_validity();
 
@@ -170,12 +272,79 @@ TopologyBuildingBlock NetworkParser::parse_topology_name(const std::string& topo
     if (topology_name == "KingMesh2D") {
         return TopologyBuildingBlock::KingMesh2D;
     }
+    if (topology_name == "TorusND") {
+        return TopologyBuildingBlock::TorusND;
+    }
+    if (topology_name == "MeshND") {
+        return TopologyBuildingBlock::MeshND;
+    }
+    if (topology_name == "FatTree") {
+        return TopologyBuildingBlock::FatTree;
+    }
+    if (topology_name == "Dragonfly") {
+        return TopologyBuildingBlock::Dragonfly;
+    }
 
     // shouldn't reach here
     std::cerr << "[Error] (network/analytical) " << "Topology name " << topology_name << " not supported" << std::endl;
     std::exit(-1);
 }
 
+MultiDimSendMode NetworkParser::parse_multi_dim_send_mode(const std::string& mode_name) noexcept {
+    if (mode_name == "FirstDim") {
+        return MultiDimSendMode::FirstDim;
+    }
+
+    if (mode_name == "Accumulate") {
+        return MultiDimSendMode::Accumulate;
+    }
+
+    if (mode_name == "Pipelined") {
+        return MultiDimSendMode::Pipelined;
+    }
+
+    // shouldn't reach here
+    std::cerr << "[Error] (network/analytical) " << "multi_dim_send " << mode_name << " not supported" << std::endl;
+    std::exit(-1);
+}
+
+DragonflyArrangement NetworkParser::parse_dragonfly_arrangement(const std::string& arrangement_name) noexcept {
+    if (arrangement_name == "Absolute") {
+        return DragonflyArrangement::Absolute;
+    }
+
+    if (arrangement_name == "Relative") {
+        return DragonflyArrangement::Relative;
+    }
+
+    if (arrangement_name == "Circulant") {
+        return DragonflyArrangement::Circulant;
+    }
+
+    // shouldn't reach here
+    std::cerr << "[Error] (network/analytical) " << "arrangement " << arrangement_name << " not supported"
+              << std::endl;
+    std::exit(-1);
+}
+
+DragonflyRouting NetworkParser::parse_dragonfly_routing(const std::string& routing_name) noexcept {
+    if (routing_name == "Minimal") {
+        return DragonflyRouting::Minimal;
+    }
+
+    if (routing_name == "Valiant") {
+        return DragonflyRouting::Valiant;
+    }
+
+    if (routing_name == "UGAL") {
+        return DragonflyRouting::UGAL;
+    }
+
+    // shouldn't reach here
+    std::cerr << "[Error] (network/analytical) " << "routing " << routing_name << " not supported" << std::endl;
+    std::exit(-1);
+}
+
 void NetworkParser::check_validity() const noexcept {
     // dims_count should match
     if (dims_count != npus_count_per_dim.size()) {
@@ -223,6 +392,122 @@ void NetworkParser::check_validity() const noexcept {
         }
     }
 
+    // TorusND and MeshND span the whole network, with their axes given by shape
+    const auto is_grid = [](const TopologyBuildingBlock topology) {
+        return topology == TopologyBuildingBlock::TorusND || topology == TopologyBuildingBlock::MeshND;
+    };
+    if (std::any_of(topology_per_dim.begin(), topology_per_dim.end(), is_grid)) {
+        if (dims_count != 1) {
+            std::cerr << "[Error] (network/analytical) "
+                      << "TorusND and MeshND should be defined as a single dimensional topology" << std::endl;
+            std::exit(-1);
+        }
+
+        auto shape_npus_count = 1;
+        for (const auto& axis_npus_count : shape) {
+            if (axis_npus_count <= 0) {
+                std::cerr << "[Error] (network/analytical) " << "shape (" << axis_npus_count
+                          << ") should be larger than 0" << std::endl;
+                std::exit(-1);
+            }
+            shape_npus_count *= axis_npus_count;
+        }
+        if (shape.empty() || shape_npus_count != npus_count_per_dim[0]) {
+            std::cerr << "[Error] (network/analytical) " << "product of shape (" << shape_npus_count
+                      << ") doesn't match with npus_count (" << npus_count_per_dim[0] << ")" << std::endl;
+            std::exit(-1);
+        }
+
+        if (wraparound.size() != shape.size()) {
+            std::cerr << "[Error] (network/analytical) " << "length of wraparound (" << wraparound.size()
+                      << ") doesn't match with the length of shape (" << shape.size() << ")" << std::endl;
+            std::exit(-1);
+        }
+    } else if (!shape.empty()) {
+        std::cerr << "[Error] (network/analytical) " << "shape is only supported by TorusND and MeshND" << std::endl;
+        std::exit(-1);
+    }
+
+    // FatTree spans the whole network, with its switches given by radix, tiers, and oversubscription
+    const auto is_fat_tree = [](const TopologyBuildingBlock topology) {
+        return topology == TopologyBuildingBlock::FatTree;
+    };
+    if (std::any_of(topology_per_dim.begin(), topology_per_dim.end(), is_fat_tree)) {
+        if (dims_count != 1) {
+            std::cerr << "[Error] (network/analytical) " << "FatTree should be defined as a single dimensional topology"
+                      << std::endl;
+            std::exit(-1);
+        }
+
+        if (radix < 2 || radix % 2 != 0) {
+            std::cerr << "[Error] (network/analytical) " << "radix (" << radix << ") should be a positive even number"
+                      << std::endl;
+            std::exit(-1);
+        }
+        if (tiers < 1) {
+            std::cerr << "[Error] (network/analytical) " << "tiers (" << tiers << ") should be larger than 0"
+                      << std::endl;
+            std::exit(-1);
+        }
+        if (oversubscription < 1 || (tiers > 1 && radix % (oversubscription + 1) != 0)) {
+            std::cerr << "[Error] (network/analytical) " << "oversubscription (" << oversubscription
+                      << ") should be at least 1 and split radix (" << radix << ") into endpoints and uplinks"
+                      << std::endl;
+            std::exit(-1);
+        }
+
+        // leaves own radix * o / (o + 1) NPUs each, and there are (radix / 2)^(tiers - 1) of them
+        auto fat_tree_npus_count = (tiers == 1) ? radix : radix - (radix / (oversubscription + 1));
+        for (auto tier = 1; tier < tiers; tier++) {
+            fat_tree_npus_count *= radix / 2;
+        }
+        if (fat_tree_npus_count != npus_count_per_dim[0]) {
+            std::cerr << "[Error] (network/analytical) " << "NPUs of the FatTree (" << fat_tree_npus_count
+                      << ") don't match with npus_count (" << npus_count_per_dim[0] << ")" << std::endl;
+            std::exit(-1);
+        }
+    }
+
+    // Dragonfly spans the whole network, with its routers given by groups and routers_per_group
+    const auto is_dragonfly = [](const TopologyBuildingBlock topology) {
+        return topology == TopologyBuildingBlock::Dragonfly;
+    };
+    if (std::any_of(topology_per_dim.begin(), topology_per_dim.end(), is_dragonfly)) {
+        if (dims_count != 1) {
+            std::cerr << "[Error] (network/analytical) "
+                      << "Dragonfly should be defined as a single dimensional topology" << std::endl;
+            std::exit(-1);
+        }
+
+        if (groups < 2 || routers_per_group < 1 || global_links_per_router < 1) {
+            std::cerr << "[Error] (network/analytical) " << "groups (" << groups << "), routers_per_group ("
+                      << routers_per_group << "), and global_links_per_router (" << global_links_per_router
+                      << ") should be at least 2, 1, and 1" << std::endl;
+            std::exit(-1);
+        }
+
+        // a router links to a group at most once
+        if (global_links_per_router > groups - 1) {
+            std::cerr << "[Error] (network/analytical) " << "global_links_per_router (" << global_links_per_router
+                      << ") should not exceed the other groups (" << groups - 1 << ")" << std::endl;
+            std::exit(-1);
+        }
+
+        // every group links to every other group by the same number of global links
+        if ((routers_per_group * global_links_per_router) % (groups - 1) != 0) {
+            std::cerr << "[Error] (network/analytical) " << "global links of a group ("
+                      << routers_per_group * global_links_per_router << ") should be a multiple of the other groups ("
+                      << groups - 1 << ")" << std::endl;
+            std::exit(-1);
+        }
+
+        if (npus_count_per_dim[0] % (groups * routers_per_group) != 0) {
+            std::cerr << "[Error] (network/analytical) " << "npus_count (" << npus_count_per_dim[0]
+                      << ") should be a multiple of the routers (" << groups * routers_per_group << ")" << std::endl;
+            std::exit(-1);
+        }
+    }
+
     // Validate non_recursive_topo
     if (!non_recursive_topo.empty()) {
         // Size must match dims_count
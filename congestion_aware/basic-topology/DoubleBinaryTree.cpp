@@ -30,12 +30,11 @@ DoubleBinaryTree::DoubleBinaryTree(const int npus_count,
     // std::cout << "Depth of the tree: " << depth << std::endl;
     m_root_max_tree_root = new Node();
     m_root_min_tree_root = new Node();
-    m_node_list.push_back(m_root_max_tree_root);
-    m_node_list.push_back(m_root_min_tree_root);
     m_root_max_tree_root->left = initialize_tree(depth - 1, npus_count - 1); // create the root node, leaf is at depth 0
     m_root_min_tree_root->right = initialize_tree(depth - 1, npus_count - 1); // create the root node, leaf is at depth 0
 
-    // assign id's
+    // assign id's; build_tree() also registers every node, roots included, in m_node_list,
+    // which owns them (registering the roots here as well would free them twice)
     build_tree(m_root_max_tree_root, m_max_start);
     build_tree(m_root_min_tree_root, m_min_start);
 
@@ -0,0 +1,140 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/Dragonfly.h"
+#include "congestion_aware/Link.h"
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <utility>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+
+Dragonfly::Dragonfly(const int groups,
+                     const int routers_per_group,
+                     const int global_links_per_router,
+                     const int npus_per_router,
+                     const DragonflyArrangement arrangement,
+                     const DragonflyRouting routing,
+                     const Bandwidth bandwidth,
+                     const Latency latency,
+                     const std::vector<std::tuple<int, int, double>>& faulty_links) noexcept
+    : BasicTopology(groups * routers_per_group * npus_per_router,
+                    groups * routers_per_group * (npus_per_router + 1),
+                    bandwidth,
+                    latency,
+                    /*is_multi_dim=*/false),
+      layout(groups, routers_per_group, global_links_per_router, npus_per_router, arrangement),
+      routing(routing),
+      npus_per_router(npus_per_router) {
+    assert(bandwidth > 0);
+    assert(latency >= 0);
+
+    Dragonfly::basic_topology_type = TopologyBuildingBlock::Dragonfly;
+
+    // derate of each faulty link, in both directions
+    auto derates = std::map<std::pair<DeviceId, DeviceId>, double>();
+    for (const auto& [src, dest, derate] : faulty_links) {
+        if (derate == 0) {
+            // routes are arithmetic and never detour around a down link
+            std::cerr << "[Error] (network/analytical/congestion_aware/Dragonfly): "
+                      << "link " << src << " - " << dest << " is down, which Dragonfly does not support" << std::endl;
+            std::exit(-1);
+        }
+        derates[{src, dest}] = derate;
+        derates[{dest, src}] = derate;
+    }
+
+    // connect npus and routers, derating the faulty links
+    for (const auto& policy : get_connection_policies()) {
+        const auto it = derates.find({policy.src, policy.dst});
+        const auto derate = (it == derates.end()) ? 1.0 : it->second;
+        connect(policy.src, policy.dst, bandwidth * derate, latency, /*bidirectional=*/false);
+    }
+}
+
+Route Dragonfly::route(const DeviceId src, const DeviceId dest) const noexcept {
+    return route_chunk(src, dest, 0);
+}
+
+Route Dragonfly::route_chunk(const DeviceId src, const DeviceId dest, const uint64_t chunk_id) const noexcept {
+    DeviceId route_ids[DragonflyLayout::max_route_length];
+    const auto length = route_device_ids(src, dest, chunk_id, route_ids);
+
+    // construct route
+    auto route = Route();
+    for (auto i = 0; i < length; i++) {
+        route.push_back(devices[route_ids[i]]);
+    }
+    return route;
+}
+
+int Dragonfly::route_device_ids(const DeviceId src,
+                                const DeviceId dest,
+                                const uint64_t chunk_id,
+                                DeviceId* const route) const noexcept {
+    // assert npus are in valid range
+    assert(0 <= src && src < npus_count);
+    assert(0 <= dest && dest < npus_count);
+
+    const auto hash = DragonflyLayout::hash(src, dest, chunk_id);
+    switch (routing) {
+    case DragonflyRouting::Minimal:
+        return layout.minimal_route(src, dest, hash, route);
+    case DragonflyRouting::Valiant:
+        return layout.valiant_route(src, dest, hash, route);
+    case DragonflyRouting::UGAL: {
+        // take the Valiant route only if it is cheaper than the minimal one
+        DeviceId valiant_route[DragonflyLayout::max_route_length];
+        const auto minimal_length = layout.minimal_route(src, dest, hash, route);
+        const auto valiant_length = layout.valiant_route(src, dest, hash, valiant_route);
+        if (ugal_cost(valiant_route, valiant_length) >= ugal_cost(route, minimal_length)) {
+            return minimal_length;
+        }
+        for (auto i = 0; i < valiant_length; i++) {
+            route[i] = valiant_route[i];
+        }
+        return valiant_length;
+    }
+    default:
+        assert(false);
+        return 0;
+    }
+}
+
+size_t Dragonfly::ugal_cost(const DeviceId* const route, const int length) const noexcept {
+    // a route without links between routers stays at its router
+    if (length < 4) {
+        return 0;
+    }
+
+    // output queue of the src router towards the next router
+    const auto& links = devices[route[1]]->get_links();
+    const auto link = links.find(route[2]);
+    assert(link != links.end());
+
+    const auto hops_count = static_cast<size_t>(length - 1);
+    return (link->second->get_queue_length() + 1) * hops_count;
+}
+
+std::vector<ConnectionPolicy> Dragonfly::get_connection_policies() const noexcept {
+    auto policies = std::vector<ConnectionPolicy>();
+
+    // link every npu to its router
+    for (auto npu = 0; npu < npus_count; npu++) {
+        const auto router = npus_count + (npu / npus_per_router);
+        policies.emplace_back(npu, router);
+        policies.emplace_back(router, npu);
+    }
+
+    // local and global links between routers
+    for (const auto& policy : layout.get_router_links()) {
+        policies.push_back(policy);
+    }
+
+    return policies;
+}
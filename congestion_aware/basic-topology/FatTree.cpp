@@ -0,0 +1,232 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/FatTree.h"
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <utility>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+
+namespace {
+
+/// uplinks per leaf switch (none for a single-tier fat-tree)
+int get_leaf_uplinks_count(const int radix, const int tiers, const int oversubscription) noexcept {
+    return (tiers == 1) ? 0 : radix / (oversubscription + 1);
+}
+
+/// number of leaf switches: arity^(tiers - 1)
+int get_leaves_count(const int radix, const int tiers) noexcept {
+    auto leaves_count = 1;
+    for (auto tier = 1; tier < tiers; tier++) {
+        leaves_count *= radix / 2;
+    }
+    return leaves_count;
+}
+
+/// splitmix64 finalizer
+uint64_t mix(uint64_t value) noexcept {
+    value += 0x9e3779b97f4a7c15ULL;
+    value = (value ^ (value >> 30U)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27U)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31U);
+}
+
+}  // namespace
+
+int FatTree::compute_npus_count(const int radix, const int tiers, const int oversubscription) noexcept {
+    const auto leaf_npus_count = radix - get_leaf_uplinks_count(radix, tiers, oversubscription);
+    return leaf_npus_count * get_leaves_count(radix, tiers);
+}
+
+int FatTree::compute_switches_count(const int radix, const int tiers, const int oversubscription) noexcept {
+    // every upper tier has leaf_uplinks_count switches per group of arity leaves
+    const auto leaves_count = get_leaves_count(radix, tiers);
+    const auto upper_tier_switches_count =
+        get_leaf_uplinks_count(radix, tiers, oversubscription) * (leaves_count / (radix / 2));
+    return leaves_count + ((tiers - 1) * upper_tier_switches_count);
+}
+
+FatTree::FatTree(const int radix,
+                 const int tiers,
+                 const int oversubscription,
+                 const Bandwidth bandwidth,
+                 const Latency latency,
+                 const std::vector<std::tuple<int, int, double>>& faulty_links) noexcept
+    : BasicTopology(compute_npus_count(radix, tiers, oversubscription),
+                    compute_npus_count(radix, tiers, oversubscription) +
+                        compute_switches_count(radix, tiers, oversubscription),
+                    bandwidth,
+                    latency,
+                    /*is_multi_dim=*/false),
+      tiers(tiers),
+      arity(radix / 2),
+      leaf_npus_count(radix - get_leaf_uplinks_count(radix, tiers, oversubscription)),
+      leaf_uplinks_count(get_leaf_uplinks_count(radix, tiers, oversubscription)) {
+    assert(radix >= 2 && radix % 2 == 0);
+    assert(tiers >= 1);
+    assert(oversubscription >= 1);
+    assert(tiers == 1 || radix % (oversubscription + 1) == 0);
+    assert(bandwidth > 0);
+    assert(latency >= 0);
+
+    FatTree::basic_topology_type = TopologyBuildingBlock::FatTree;
+
+    // lay out the switches tier by tier, right after the npus
+    const auto leaves_count = get_leaves_count(radix, tiers);
+    auto first_switch = npus_count;
+    for (auto tier = 0; tier < tiers; tier++) {
+        first_switch_per_tier.push_back(first_switch);
+        first_switch += (tier == 0) ? leaves_count : leaf_uplinks_count * (leaves_count / arity);
+    }
+    assert(first_switch == devices_count);
+
+    auto digit_weight = 1;
+    for (auto digit = 1; digit < tiers - 1; digit++) {
+        digit_weights.push_back(digit_weight);
+        digit_weight *= arity;
+    }
+
+    // derate of each faulty link, in both directions
+    auto derates = std::map<std::pair<DeviceId, DeviceId>, double>();
+    for (const auto& [src, dest, derate] : faulty_links) {
+        if (derate == 0) {
+            // routes never detour around a down link
+            std::cerr << "[Error] (network/analytical/congestion_aware/FatTree): "
+                      << "link " << src << " - " << dest << " is down, which FatTree does not support" << std::endl;
+            std::exit(-1);
+        }
+        derates[{src, dest}] = derate;
+        derates[{dest, src}] = derate;
+    }
+
+    // connect npus and switches, derating the faulty links
+    for (const auto& policy : get_connection_policies()) {
+        const auto it = derates.find({policy.src, policy.dst});
+        const auto derate = (it == derates.end()) ? 1.0 : it->second;
+        connect(policy.src, policy.dst, bandwidth * derate, latency, /*bidirectional=*/false);
+    }
+}
+
+DeviceId FatTree::switch_id(const int tier, const int low, const int high) const noexcept {
+    assert(0 <= tier && tier < tiers);
+
+    if (tier == 0) {
+        assert(0 <= low && low < arity);
+        return first_switch_per_tier[0] + low + (arity * high);
+    }
+
+    assert(0 <= low && low < leaf_uplinks_count);
+    return first_switch_per_tier[tier] + low + (leaf_uplinks_count * high);
+}
+
+Route FatTree::route(const DeviceId src, const DeviceId dest) const noexcept {
+    return route_chunk(src, dest, 0);
+}
+
+Route FatTree::route_chunk(const DeviceId src, const DeviceId dest, const uint64_t chunk_id) const noexcept {
+    // assert npus are in valid range
+    assert(0 <= src && src < npus_count);
+    assert(0 <= dest && dest < npus_count);
+
+    // construct route
+    auto route = Route();
+    route.push_back(devices[src]);
+    if (src == dest) {
+        return route;
+    }
+
+    const auto src_leaf = src / leaf_npus_count;
+    const auto dest_leaf = dest / leaf_npus_count;
+    route.push_back(devices[first_switch_per_tier[0] + src_leaf]);
+
+    if (src_leaf != dest_leaf) {
+        // the turn is one tier above the highest digit where the leaves differ
+        auto high = src_leaf / arity;
+        const auto dest_high = dest_leaf / arity;
+        auto top_tier = 1;
+        for (auto digit = tiers - 2; digit >= 1; digit--) {
+            const auto weight = digit_weights[digit - 1];
+            if ((high / weight) % arity != (dest_high / weight) % arity) {
+                top_tier = digit + 1;
+                break;
+            }
+        }
+
+        // go up, picking an equal-cost uplink at every tier
+        auto hash = mix(mix(mix(static_cast<uint64_t>(src)) ^ static_cast<uint64_t>(dest)) ^ chunk_id);
+        const auto low = static_cast<int>(hash % static_cast<uint64_t>(leaf_uplinks_count));
+        hash /= static_cast<uint64_t>(leaf_uplinks_count);
+        route.push_back(devices[switch_id(1, low, high)]);
+        for (auto tier = 1; tier < top_tier; tier++) {
+            const auto weight = digit_weights[tier - 1];
+            const auto next_digit = static_cast<int>(hash % static_cast<uint64_t>(arity));
+            hash /= static_cast<uint64_t>(arity);
+            high += (next_digit - ((high / weight) % arity)) * weight;
+            route.push_back(devices[switch_id(tier + 1, low, high)]);
+        }
+
+        // go down, restoring the digits of the destination leaf
+        for (auto tier = top_tier; tier > 1; tier--) {
+            const auto weight = digit_weights[tier - 2];
+            high += (((dest_high / weight) % arity) - ((high / weight) % arity)) * weight;
+            route.push_back(devices[switch_id(tier - 1, low, high)]);
+        }
+        assert(high == dest_high);
+
+        route.push_back(devices[first_switch_per_tier[0] + dest_leaf]);
+    }
+
+    route.push_back(devices[dest]);
+    return route;
+}
+
+std::vector<ConnectionPolicy> FatTree::get_connection_policies() const noexcept {
+    auto policies = std::vector<ConnectionPolicy>();
+
+    // link every npu to its leaf
+    for (auto npu = 0; npu < npus_count; npu++) {
+        const auto leaf = first_switch_per_tier[0] + (npu / leaf_npus_count);
+        policies.emplace_back(npu, leaf);
+        policies.emplace_back(leaf, npu);
+    }
+
+    if (tiers == 1) {
+        return policies;
+    }
+
+    // link every leaf to its uplink switches of tier 1
+    const auto leaves_count = first_switch_per_tier[1] - first_switch_per_tier[0];
+    for (auto leaf = 0; leaf < leaves_count; leaf++) {
+        for (auto low = 0; low < leaf_uplinks_count; low++) {
+            const auto leaf_id = first_switch_per_tier[0] + leaf;
+            const auto upper_id = switch_id(1, low, leaf / arity);
+            policies.emplace_back(leaf_id, upper_id);
+            policies.emplace_back(upper_id, leaf_id);
+        }
+    }
+
+    // link every switch of tier t to the switches of tier t + 1 differing in digit t
+    const auto highs_count = leaves_count / arity;
+    for (auto tier = 1; tier < tiers - 1; tier++) {
+        const auto weight = digit_weights[tier - 1];
+        for (auto high = 0; high < highs_count; high++) {
+            for (auto low = 0; low < leaf_uplinks_count; low++) {
+                const auto lower_id = switch_id(tier, low, high);
+                for (auto digit = 0; digit < arity; digit++) {
+                    const auto upper_high = high + ((digit - ((high / weight) % arity)) * weight);
+                    const auto upper_id = switch_id(tier + 1, low, upper_high);
+                    policies.emplace_back(lower_id, upper_id);
+                    policies.emplace_back(upper_id, lower_id);
+                }
+            }
+        }
+    }
+
+    return policies;
+}
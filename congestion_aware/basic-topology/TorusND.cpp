@@ -0,0 +1,169 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/TorusND.h"
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <utility>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+
+namespace {
+
+/// product of the axis sizes
+int get_shape_npus_count(const std::vector<int>& shape) noexcept {
+    auto npus_count = 1;
+    for (const auto axis_npus_count : shape) {
+        npus_count *= axis_npus_count;
+    }
+    return npus_count;
+}
+
+}  // namespace
+
+TorusND::TorusND(const std::vector<int>& shape,
+                 const Bandwidth bandwidth,
+                 const Latency latency,
+                 const std::vector<bool>& wraparound,
+                 const bool bidirectional,
+                 const std::vector<std::tuple<int, int, double>>& faulty_links) noexcept
+    : BasicTopology(get_shape_npus_count(shape),
+                    get_shape_npus_count(shape),
+                    bandwidth,
+                    latency,
+                    /*is_multi_dim=*/false),
+      shape(shape),
+      wraparound(wraparound),
+      bidirectional(bidirectional) {
+    assert(!shape.empty());
+    assert(shape.size() == wraparound.size());
+    assert(bandwidth > 0);
+    assert(latency >= 0);
+
+    auto wraps_every_axis = true;
+    auto stride = DeviceId{1};
+    for (size_t axis = 0; axis < shape.size(); axis++) {
+        assert(shape[axis] > 0);
+        if (!bidirectional && !wraparound[axis] && shape[axis] > 1) {
+            // unidirectional links can't route back along an axis that doesn't wrap around
+            std::cerr << "[Error] (network/analytical/congestion_aware/TorusND): "
+                      << "axis " << axis << " doesn't wrap around, which unidirectional links do not support"
+                      << std::endl;
+            std::exit(-1);
+        }
+        strides.push_back(stride);
+        stride *= shape[axis];
+        wraps_every_axis = wraps_every_axis && wraparound[axis];
+    }
+
+    TorusND::basic_topology_type = wraps_every_axis ? TopologyBuildingBlock::TorusND : TopologyBuildingBlock::MeshND;
+
+    // derate of each faulty link, in both directions
+    auto derates = std::map<std::pair<DeviceId, DeviceId>, double>();
+    for (const auto& [src, dest, derate] : faulty_links) {
+        if (derate == 0) {
+            // routes are dimension-ordered and never detour
+            std::cerr << "[Error] (network/analytical/congestion_aware/TorusND): "
+                      << "link " << src << " - " << dest << " is down, which TorusND does not support" << std::endl;
+            std::exit(-1);
+        }
+        derates[{src, dest}] = derate;
+        derates[{dest, src}] = derate;
+    }
+
+    // connect npus along every axis, derating the faulty links
+    for (const auto& policy : get_connection_policies()) {
+        const auto it = derates.find({policy.src, policy.dst});
+        const auto derate = (it == derates.end()) ? 1.0 : it->second;
+        connect(policy.src, policy.dst, bandwidth * derate, latency, /*bidirectional=*/false);
+    }
+}
+
+bool TorusND::has_next_link(const int axis, const int coordinate) const noexcept {
+    if (coordinate + 1 < shape[axis]) {
+        return true;
+    }
+
+    // the wraparound link of an axis of two NPUs would duplicate the link back
+    return wraparound[axis] && (shape[axis] > 2 || (shape[axis] == 2 && !bidirectional));
+}
+
+Route TorusND::route(const DeviceId src, const DeviceId dest) const noexcept {
+    // assert npus are in valid range
+    assert(0 <= src && src < npus_count);
+    assert(0 <= dest && dest < npus_count);
+
+    // construct empty route
+    auto route = Route();
+    route.push_back(devices[src]);
+
+    // dimension-ordered routing, axis 0 first
+    auto current = src;
+    for (size_t axis = 0; axis < shape.size(); axis++) {
+        const auto axis_npus_count = shape[axis];
+        const auto stride = strides[axis];
+        auto coordinate = (current / stride) % axis_npus_count;
+        const auto dest_coordinate = (dest / stride) % axis_npus_count;
+        if (coordinate == dest_coordinate) {
+            continue;
+        }
+
+        // pick the direction and the number of hops
+        auto step = 1;
+        auto hops_count = dest_coordinate - coordinate;
+        if (wraparound[axis]) {
+            hops_count = (hops_count + axis_npus_count) % axis_npus_count;
+            if (bidirectional && hops_count > axis_npus_count / 2) {
+                step = -1;
+                hops_count = axis_npus_count - hops_count;
+            }
+        } else if (hops_count < 0) {
+            assert(bidirectional);
+            step = -1;
+            hops_count = -hops_count;
+        }
+
+        // walk along the axis
+        for (auto hop = 0; hop < hops_count; hop++) {
+            if (step > 0) {
+                current += (coordinate + 1 < axis_npus_count) ? stride : -(axis_npus_count - 1) * stride;
+                coordinate = (coordinate + 1 < axis_npus_count) ? coordinate + 1 : 0;
+            } else {
+                current -= (coordinate > 0) ? stride : -(axis_npus_count - 1) * stride;
+                coordinate = (coordinate > 0) ? coordinate - 1 : axis_npus_count - 1;
+            }
+            route.push_back(devices[current]);
+        }
+    }
+
+    assert(current == dest);
+    return route;
+}
+
+std::vector<ConnectionPolicy> TorusND::get_connection_policies() const noexcept {
+    auto policies = std::vector<ConnectionPolicy>();
+
+    // link every npu to its next neighbour along every axis, and back if bidirectional
+    for (auto npu = 0; npu < npus_count; npu++) {
+        for (size_t axis = 0; axis < shape.size(); axis++) {
+            const auto coordinate = (npu / strides[axis]) % shape[axis];
+            if (!has_next_link(static_cast<int>(axis), coordinate)) {
+                continue;
+            }
+
+            const auto next = (coordinate + 1 < shape[axis]) ? npu + strides[axis]
+                                                             : npu - ((shape[axis] - 1) * strides[axis]);
+            policies.emplace_back(npu, next);
+            if (bidirectional) {
+                policies.emplace_back(next, npu);
+            }
+        }
+    }
+
+    return policies;
+}
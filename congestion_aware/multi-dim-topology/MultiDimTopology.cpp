@@ -7,19 +7,45 @@ LICENSE file in the root directory of this source tree.
 #include "congestion_aware/Helper.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cstdint>
 #include <cstdlib>
 #include <functional>
 #include <iostream>
 #include <numeric>
+#include <thread>
 #include <utility>
 
 namespace NetworkAnalyticalCongestionAware {
 
+namespace {
+
+/**
+ * Run worker(worker_id) on threads_count threads (including the calling thread)
+ * and wait for all of them to finish.
+ */
+template <typename Worker> void run_workers(const int threads_count, Worker&& worker) noexcept {
+    assert(threads_count > 0);
+
+    auto threads = std::vector<std::thread>();
+    for (int worker_id = 1; worker_id < threads_count; worker_id++) {
+        threads.emplace_back(std::ref(worker), worker_id);
+    }
+    worker(0);
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+}  // namespace
+
 MultiDimTopology::MultiDimTopology(const std::vector<std::tuple<int, int, double>> faulty_links, const std::vector<int> non_recursive_topo) noexcept 
 : Topology() , faulty_links{faulty_links}, m_non_recursive_topo{non_recursive_topo}{
     // initialize values
     m_topology_per_dim.clear();
+    m_npus_stride_per_dim.clear();
     npus_count_per_dim = {};
 
     // initialize topology shape
@@ -299,6 +325,9 @@ void MultiDimTopology::append_dimension(std::unique_ptr<BasicTopology> topology)
     // increment dims_count
     this->dims_count++;
 
+    // the new dimension strides over all NPUs of the lower dimensions
+    m_npus_stride_per_dim.push_back(this->npus_count);
+
     // increase npus_count
     const auto topology_size = topology->get_npus_count();
     this->npus_count *= topology_size;
@@ -316,64 +345,145 @@ void MultiDimTopology::append_dimension(std::unique_ptr<BasicTopology> topology)
     this->npus_count_per_dim.push_back(topology_size);
 }
 
-void MultiDimTopology::make_connections() noexcept {
+void MultiDimTopology::make_connections(const int threads_count) noexcept {
     if (!m_switch_translation_unit.has_value()) {
         std::cerr << "[Error] (network/analytical/congestion_aware/MultiDimTopology): "
                   << "SwitchTranslationUnit is not initialized." << std::endl;
         std::exit(-1);
     }
 
+    if (threads_count > 1) {
+        make_connections_parallel(threads_count);
+        return;
+    }
+
     for (int dim = 0; dim < dims_count; dim++) {
         // intra-dim connections
         const auto topology = m_topology_per_dim.at(dim).get();
         const auto policies = topology->get_connection_policies();
         assert(policies.size() != 0);
-        bool non_recursive = false;
-        std::vector<std::pair<MultiDimAddress, MultiDimAddress>> address_pairs;
+        const auto connections_count = get_connections_count_per_policy(dim);
 
+        // expand each policy over all other dimensions and connect on the fly
         for (const auto& policy : policies) {
-            if (!non_recursive) {
-                address_pairs = generateAddressPairs(npus_count_per_dim, policy, dim);
-            }
+            for_each_connection(dim, policy, 0, connections_count,
+                                [this, dim](const DeviceId src, const DeviceId dest) { connect_in_dim(dim, src, dest); });
+        }
+    }
+}
 
-            // --- RECURSIVE MODE: only first nodes of lower dimensions ---
-            else {
-                address_pairs = generateAddressPairs_only_first_nodes(npus_count_per_dim, policy, dim);
-            }
-            //std::vector<std::pair<MultiDimAddress, MultiDimAddress>> address_pairs =
-            //    generateAddressPairs(npus_count_per_dim, policy, dim);
-            for (const auto& address_pair : address_pairs) {
-                // translate to device ID, depending on switch or not
-
-                const auto src = is_switch(address_pair.first)
-                                     ? m_switch_translation_unit.value().translate_address_to_id(address_pair.first)
-                                     : translate_address_back(address_pair.first);
-                const auto dest = is_switch(address_pair.second)
-                                      ? m_switch_translation_unit.value().translate_address_to_id(address_pair.second)
-                                      : translate_address_back(address_pair.second);
-                assert(0 <= src && src < devices_count);
-                assert(0 <= dest && dest < devices_count);
-                
+void MultiDimTopology::make_lazy_connections() noexcept {
+    if (!m_switch_translation_unit.has_value()) {
+        std::cerr << "[Error] (network/analytical/congestion_aware/MultiDimTopology): "
+                  << "SwitchTranslationUnit is not initialized." << std::endl;
+        std::exit(-1);
+    }
+
+    // links are created by connect_lazily as chunks are sent
+    lazy_links = true;
+}
+
+void MultiDimTopology::connect_lazily(const DeviceId src, const DeviceId dest) noexcept {
+    assert(lazy_links);
+
+    connect_in_dim(get_link_dim(src, dest), src, dest);
+}
 
-                // make connection
+void MultiDimTopology::make_connections_parallel(const int threads_count) noexcept {
+    assert(threads_count > 1);
+
+    // flatten every (dim, policy, connection) into one global index space
+    auto policies_per_dim = std::vector<std::vector<ConnectionPolicy>>();
+    auto connections_count_per_dim = std::vector<int>();
+    auto first_index_per_dim = std::vector<int64_t>();
+    int64_t total_connections_count = 0;
+    for (int dim = 0; dim < dims_count; dim++) {
+        policies_per_dim.push_back(m_topology_per_dim.at(dim)->get_connection_policies());
+        assert(!policies_per_dim.back().empty());
+        connections_count_per_dim.push_back(get_connections_count_per_policy(dim));
+        first_index_per_dim.push_back(total_connections_count);
+        total_connections_count += static_cast<int64_t>(policies_per_dim.back().size()) * connections_count_per_dim.back();
+    }
+
+    // the global index space is cut into contiguous blocks, handed out to workers dynamically
+    const auto blocks_count = static_cast<int64_t>(threads_count) * 16;
+    const auto block_size = std::max<int64_t>(1, (total_connections_count + blocks_count - 1) / blocks_count);
+
+    // each device is owned by exactly one worker, so links of different workers never share a Device
+    const auto devices_per_worker = (devices_count + threads_count - 1) / threads_count;
+
+    // (1) expand blocks into thread-local link blocks, bucketed by the worker owning the src device
+    // link_blocks[block][owner] keeps the global enumeration order within each bucket
+    auto link_blocks = std::vector<std::vector<std::vector<LinkSpec>>>(
+        blocks_count, std::vector<std::vector<LinkSpec>>(threads_count));
+    auto next_block = std::atomic<int64_t>(0);
+    run_workers(threads_count, [&](const int worker_id) {
+        for (auto block = next_block++; block < blocks_count; block = next_block++) {
+            const auto block_first = block * block_size;
+            const auto block_last = std::min(block_first + block_size, total_connections_count);
+            auto& buckets = link_blocks[block];
+
+            for (int dim = 0; dim < dims_count && block_first < block_last; dim++) {
+                const auto& policies = policies_per_dim[dim];
+                const auto connections_count = connections_count_per_dim[dim];
+                const auto dim_first = first_index_per_dim[dim];
+                const auto dim_last = dim_first + static_cast<int64_t>(policies.size()) * connections_count;
+                if (block_last <= dim_first || dim_last <= block_first) {
+                    continue;
+                }
+
+                // policies of this dim overlapping the block
+                const auto first = std::max(block_first, dim_first) - dim_first;
+                const auto last = std::min(block_last, dim_last) - dim_first;
                 const auto bandwidth = bandwidth_per_dim.at(dim);
-                const auto latency = topology->get_link_latency();
-                if(fault_derate(src, dest) != 0)
-                    connect(src, dest, bandwidth * fault_derate(src, dest), latency, false);
-                else
-                    connect(src, dest, bandwidth, latency, false);  //might be removable
+                const auto latency = m_topology_per_dim.at(dim)->get_link_latency();
+                for (auto policy_id = first / connections_count; policy_id * connections_count < last; policy_id++) {
+                    const auto policy_first = policy_id * connections_count;
+                    const auto connection_first = static_cast<int>(std::max(first, policy_first) - policy_first);
+                    const auto connection_last =
+                        static_cast<int>(std::min(last, policy_first + connections_count) - policy_first);
+
+                    for_each_connection(dim, policies[policy_id], connection_first, connection_last,
+                                        [&](const DeviceId src, const DeviceId dest) {
+                                            buckets[src / devices_per_worker].push_back(
+                                                {src, dest, derated_bandwidth(bandwidth, src, dest), latency});
+                                        });
+                }
             }
         }
-    }
+    });
+
+    // (2) merge: each worker creates the links of its own devices, consuming blocks in order
+    run_workers(threads_count, [&](const int worker_id) {
+        for (auto& buckets : link_blocks) {
+            for (const auto& link : buckets[worker_id]) {
+                assert(0 <= link.src && link.src < devices_count);
+                assert(0 <= link.dest && link.dest < devices_count);
+                connect(link.src, link.dest, link.bandwidth, link.latency, false);
+            }
+
+            // release the thread-local block as soon as it is merged
+            std::vector<LinkSpec>().swap(buckets[worker_id]);
+        }
+    });
 }
 
-void MultiDimTopology::initialize_all_devices() noexcept {
+void MultiDimTopology::initialize_all_devices(const int threads_count) noexcept {
+    assert(threads_count > 0);
+
     // instantiate all devices
     const auto total_num_devices = get_total_num_devices();
-
-    for (auto i = 0; i < total_num_devices; i++) {
-        devices.push_back(std::make_shared<Device>(i));
-    }
+    devices.resize(total_num_devices);
+
+    // each worker instantiates a contiguous range of devices
+    const auto devices_per_worker = (total_num_devices + threads_count - 1) / threads_count;
+    run_workers(threads_count, [&](const int worker_id) {
+        const auto first = std::min(worker_id * devices_per_worker, total_num_devices);
+        const auto last = std::min(first + devices_per_worker, total_num_devices);
+        for (auto i = first; i < last; i++) {
+            devices[i] = std::make_shared<Device>(i);
+        }
+    });
 }
 
 MultiDimAddress MultiDimTopology::translate_address(const DeviceId npu_id) const noexcept {
@@ -418,12 +528,8 @@ DeviceId MultiDimTopology::translate_address_back(const MultiDimAddress multi_di
     DeviceId device_id = 0;
     assert(multi_dim_address.size() == dims_count);
     for (int top_dim = dims_count - 1; top_dim >= 0; top_dim--) {
-        // product from beginning to the top_dim - 1
-        DeviceId total_npus_in_group = std::accumulate(npus_count_per_dim.begin(), npus_count_per_dim.begin() + top_dim,
-                                                       static_cast<DeviceId>(1), std::multiplies<DeviceId>());
-
         // Add the contribution to the total device ID
-        device_id += total_npus_in_group * multi_dim_address.at(top_dim);
+        device_id += m_npus_stride_per_dim[top_dim] * multi_dim_address[top_dim];
     }
     return device_id;
 }
@@ -443,6 +549,21 @@ int MultiDimTopology::get_dim_to_transfer(const MultiDimAddress& src_address,
     std::exit(-1);
 }
 
+int MultiDimTopology::get_link_dim(const DeviceId src, const DeviceId dest) const noexcept {
+    assert(m_switch_translation_unit.has_value());
+
+    // links touching a switch belong to the switch's dimension
+    if (src >= npus_count) {
+        return m_switch_translation_unit->get_switch_dim(src);
+    }
+    if (dest >= npus_count) {
+        return m_switch_translation_unit->get_switch_dim(dest);
+    }
+
+    // NPU-to-NPU links belong to the dimension the two addresses differ in
+    return get_dim_to_transfer(translate_address(src), translate_address(dest));
+}
+
 int MultiDimTopology::get_total_num_devices() const noexcept {
     assert(npus_count_per_dim.size() == dims_count);
 
@@ -548,56 +669,118 @@ void MultiDimTopology::make_non_recursive_connections() noexcept {
     }
 
     for (int dim = 0; dim < dims_count; dim++) {
-    const auto topology = m_topology_per_dim.at(dim).get();
-    const auto policies = topology->get_connection_policies();
-    assert(!policies.empty());
-
-    bool recursive_dim = (m_non_recursive_topo.at(dim) == 1);
+        const auto topology = m_topology_per_dim.at(dim).get();
+        const auto policies = topology->get_connection_policies();
+        assert(!policies.empty());
 
+        // Create links for all expanded pairs
+        const auto connections_count = get_connections_count_per_policy(dim);
         for (const auto& policy : policies) {
+            for_each_connection(dim, policy, 0, connections_count,
+                                [this, dim](const DeviceId src, const DeviceId dest) { connect_in_dim(dim, src, dest); });
+        }
+    }
+}
 
-            std::vector<std::pair<MultiDimAddress, MultiDimAddress>> address_pairs;
-
-            // --- NORMAL MODE ---
-            if (!recursive_dim) {
-                address_pairs =
-                    generateAddressPairs(npus_count_per_dim, policy, dim);
-            }
+int MultiDimTopology::get_connections_count_per_policy(const int dim) const noexcept {
+    assert(0 <= dim && dim < dims_count);
 
-            // --- RECURSIVE MODE: only first nodes of lower dimensions ---
-            else {
-                address_pairs =
-                    generateAddressPairs(npus_count_per_dim, policy, dim);
-            }
+    // product of the sizes of every free dimension
+    auto connections_count = 1;
+    for (int d = 0; d < dims_count; d++) {
+        if (d == dim) {
+            continue;
+        }
+        connections_count *= npus_count_per_dim[d];
+    }
 
-            // Create links for all generated pairs
-            for (const auto& ap : address_pairs) {
+    return connections_count;
+}
 
-                const auto src = is_switch(ap.first)
-                                    ? m_switch_translation_unit.value().translate_address_to_id(ap.first)
-                                    : translate_address_back(ap.first);
+template <typename Visitor>
+void MultiDimTopology::for_each_connection(const int dim,
+                                           const ConnectionPolicy& policy,
+                                           const int first,
+                                           const int last,
+                                           Visitor&& visitor) const noexcept {
+    assert(0 <= dim && dim < dims_count);
+    assert(0 <= first && first <= last);
+    assert(last <= get_connections_count_per_policy(dim));
+    assert(m_switch_translation_unit.has_value());
+    const auto& switch_translation_unit = m_switch_translation_unit.value();
+
+    // running ID contribution of the other dimensions,
+    // for NPU endpoints and for switch endpoints of this dimension respectively
+    DeviceId npu_base = 0;
+    DeviceId switch_offset = 0;
+
+    // seek the odometer to the first connection, lowest dimension being the fastest digit
+    auto counters = std::vector<int>(dims_count, 0);
+    auto leftover = first;
+    for (int d = 0; d < dims_count; d++) {
+        if (d == dim) {
+            continue;
+        }
+        counters[d] = leftover % npus_count_per_dim[d];
+        leftover /= npus_count_per_dim[d];
+        npu_base += counters[d] * m_npus_stride_per_dim[d];
+        switch_offset += counters[d] * switch_translation_unit.get_switch_stride(dim, d);
+    }
 
-                const auto dest = is_switch(ap.second)
-                                    ? m_switch_translation_unit.value().translate_address_to_id(ap.second)
-                                    : translate_address_back(ap.second);
+    // translate a per-dimension ID into the global device ID
+    const auto dim_npus_count = npus_count_per_dim[dim];
+    const auto dim_stride = m_npus_stride_per_dim[dim];
+    const auto to_device_id = [&](const DeviceId local_id) {
+        if (local_id < dim_npus_count) {
+            return npu_base + (local_id * dim_stride);
+        }
+        assert(local_id == dim_npus_count);
+        return switch_translation_unit.get_switch_base_id(dim) + switch_offset;
+    };
 
-                assert(0 <= src && src < devices_count);
-                assert(0 <= dest && dest < devices_count);
+    for (auto connection = first; connection < last; connection++) {
+        visitor(to_device_id(policy.src), to_device_id(policy.dst));
 
-                const auto bw = bandwidth_per_dim.at(dim);
-                const auto lat = topology->get_link_latency();
+        // advance the odometer, lowest dimension first
+        for (int d = 0; d < dims_count; d++) {
+            if (d == dim) {
+                continue;
+            }
 
-                if (fault_derate(src, dest) != 0)
-                    connect(src, dest, bw * fault_derate(src, dest), lat, false);
-                else
-                    connect(src, dest, bw, lat, false);
+            const auto switch_stride = switch_translation_unit.get_switch_stride(dim, d);
+            if (++counters[d] < npus_count_per_dim[d]) {
+                npu_base += m_npus_stride_per_dim[d];
+                switch_offset += switch_stride;
+                break;
             }
+
+            // wrap around this digit and carry to the next one
+            counters[d] = 0;
+            npu_base -= (npus_count_per_dim[d] - 1) * m_npus_stride_per_dim[d];
+            switch_offset -= (npus_count_per_dim[d] - 1) * switch_stride;
         }
     }
+}
 
+Bandwidth MultiDimTopology::derated_bandwidth(const Bandwidth bandwidth,
+                                              const DeviceId src,
+                                              const DeviceId dest) const noexcept {
+    // derate the bandwidth if the link is listed in the fault map
+    const auto derate = fault_derate(src, dest);
+    if (derate != 0) {
+        return bandwidth * derate;
+    }
+    return bandwidth;  // might be removable
 }
 
+void MultiDimTopology::connect_in_dim(const int dim, const DeviceId src, const DeviceId dest) noexcept {
+    assert(0 <= src && src < devices_count);
+    assert(0 <= dest && dest < devices_count);
 
+    const auto bandwidth = derated_bandwidth(bandwidth_per_dim.at(dim), src, dest);
+    const auto latency = m_topology_per_dim.at(dim)->get_link_latency();
+    connect(src, dest, bandwidth, latency, false);
+}
 
 };  // namespace NetworkAnalyticalCongestionAware
 
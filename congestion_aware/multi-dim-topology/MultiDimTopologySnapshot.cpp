@@ -0,0 +1,249 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/Helper.h"
+#include "congestion_aware/Link.h"
+#include "congestion_aware/MultiDimTopology.h"
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace NetworkAnalyticalCongestionAware {
+
+namespace {
+
+/// identifies a topology snapshot file
+constexpr char snapshot_magic[8] = {'A', 'N', 'A', 'T', 'O', 'P', 'O', '\0'};
+
+/// bump whenever the layout below changes
+constexpr uint32_t snapshot_version = 2;
+
+/**
+ * Snapshot layout:
+ * [SnapshotHeader]
+ * [SnapshotDim] x dims_count
+ * [SnapshotFaultyLink] x faulty_links_count
+ * [SnapshotLink] x links_count
+ */
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    int32_t dims_count;
+    int32_t npus_count;
+    int32_t devices_count;  // number of instantiated devices (NPUs and switches)
+    int32_t lazy_links;     // 1 if links not saved are still to be instantiated as chunks cross them
+    int32_t padding;
+    uint64_t faulty_links_count;
+    uint64_t links_count;
+};
+
+struct SnapshotDim {
+    int32_t topology_type;
+    int32_t npus_count;
+    int32_t non_recursive;
+    int32_t padding;
+    double bandwidth;
+    double latency;
+};
+
+struct SnapshotFaultyLink {
+    int32_t src;
+    int32_t dest;
+    double health;
+};
+
+struct SnapshotLink {
+    int32_t src;
+    int32_t dest;
+    double bandwidth;
+    double latency;
+};
+
+[[noreturn]] void snapshot_error(const std::string& path, const std::string& message) noexcept {
+    std::cerr << "[Error] (network/analytical/congestion_aware/MultiDimTopology): "
+              << "snapshot " << path << ": " << message << std::endl;
+    std::exit(-1);
+}
+
+}  // namespace
+
+void MultiDimTopology::save_snapshot(const std::string& path) const noexcept {
+    assert(dims_count > 0);
+
+    auto file = std::ofstream(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        snapshot_error(path, "cannot open for writing");
+    }
+
+    // count links
+    uint64_t links_count = 0;
+    for (const auto& device : devices) {
+        links_count += device->get_links().size();
+    }
+
+    // header
+    auto header = SnapshotHeader();
+    std::memcpy(header.magic, snapshot_magic, sizeof(snapshot_magic));
+    header.version = snapshot_version;
+    header.dims_count = dims_count;
+    header.npus_count = npus_count;
+    header.devices_count = static_cast<int32_t>(devices.size());
+    header.lazy_links = lazy_links ? 1 : 0;
+    header.padding = 0;
+    header.faulty_links_count = faulty_links.size();
+    header.links_count = links_count;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    // shape of each dimension
+    for (int dim = 0; dim < dims_count; dim++) {
+        const auto& topology = m_topology_per_dim.at(dim);
+        auto snapshot_dim = SnapshotDim();
+        snapshot_dim.topology_type = static_cast<int32_t>(topology->get_basic_topology_type());
+        snapshot_dim.npus_count = npus_count_per_dim.at(dim);
+        snapshot_dim.non_recursive = m_non_recursive_topo.at(dim);
+        snapshot_dim.padding = 0;
+        snapshot_dim.bandwidth = bandwidth_per_dim.at(dim);
+        snapshot_dim.latency = topology->get_link_latency();
+        file.write(reinterpret_cast<const char*>(&snapshot_dim), sizeof(snapshot_dim));
+    }
+
+    // fault map
+    for (const auto& [src, dest, health] : faulty_links) {
+        const auto snapshot_faulty_link = SnapshotFaultyLink{src, dest, health};
+        file.write(reinterpret_cast<const char*>(&snapshot_faulty_link), sizeof(snapshot_faulty_link));
+    }
+
+    // links, device-major and dest-ascending
+    for (const auto& device : devices) {
+        const auto src = device->get_id();
+        for (const auto& [dest, link] : device->get_links()) {
+            const auto snapshot_link = SnapshotLink{src, dest, link->get_bandwidth(), link->get_latency()};
+            file.write(reinterpret_cast<const char*>(&snapshot_link), sizeof(snapshot_link));
+        }
+    }
+
+    if (!file) {
+        snapshot_error(path, "write failed");
+    }
+}
+
+std::shared_ptr<MultiDimTopology> MultiDimTopology::load_snapshot(const std::string& path) noexcept {
+    // map the whole file
+    const auto fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        snapshot_error(path, "cannot open for reading");
+    }
+    struct stat file_stat {};
+    if (fstat(fd, &file_stat) != 0 || file_stat.st_size < static_cast<off_t>(sizeof(SnapshotHeader))) {
+        close(fd);
+        snapshot_error(path, "truncated header");
+    }
+    const auto file_size = static_cast<size_t>(file_stat.st_size);
+    auto* const mapped = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        snapshot_error(path, "mmap failed");
+    }
+    const auto* const data = static_cast<const char*>(mapped);
+
+    // validate header
+    auto header = SnapshotHeader();
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, snapshot_magic, sizeof(snapshot_magic)) != 0) {
+        snapshot_error(path, "not a topology snapshot");
+    }
+    if (header.version != snapshot_version) {
+        snapshot_error(path, "unsupported version " + std::to_string(header.version) + " (expected " +
+                                 std::to_string(snapshot_version) + ")");
+    }
+    if (header.dims_count <= 0) {
+        snapshot_error(path, "corrupted file");
+    }
+
+    // each section must fit in the rest of the file, checked by division so that corrupted counts can't overflow
+    auto remaining_size = file_size - sizeof(SnapshotHeader);
+    const auto section_fits = [&remaining_size](const uint64_t count, const size_t entry_size) {
+        if (count > remaining_size / entry_size) {
+            return false;
+        }
+        remaining_size -= count * entry_size;
+        return true;
+    };
+    if (!section_fits(header.dims_count, sizeof(SnapshotDim)) ||
+        !section_fits(header.faulty_links_count, sizeof(SnapshotFaultyLink)) ||
+        !section_fits(header.links_count, sizeof(SnapshotLink)) || remaining_size != 0) {
+        snapshot_error(path, "corrupted file (section counts don't match the file size)");
+    }
+    auto offset = sizeof(SnapshotHeader);
+
+    // shape of each dimension
+    auto snapshot_dims = std::vector<SnapshotDim>(header.dims_count);
+    std::memcpy(snapshot_dims.data(), data + offset, header.dims_count * sizeof(SnapshotDim));
+    offset += header.dims_count * sizeof(SnapshotDim);
+
+    // fault map
+    auto faulty_links = std::vector<std::tuple<int, int, double>>();
+    faulty_links.reserve(header.faulty_links_count);
+    for (uint64_t i = 0; i < header.faulty_links_count; i++) {
+        auto snapshot_faulty_link = SnapshotFaultyLink();
+        std::memcpy(&snapshot_faulty_link, data + offset, sizeof(snapshot_faulty_link));
+        offset += sizeof(snapshot_faulty_link);
+        faulty_links.emplace_back(snapshot_faulty_link.src, snapshot_faulty_link.dest, snapshot_faulty_link.health);
+    }
+
+    // rebuild the dimensions; switch translation tables are derived from the shape
+    auto non_recursive_topo = std::vector<int>();
+    for (const auto& snapshot_dim : snapshot_dims) {
+        non_recursive_topo.push_back(snapshot_dim.non_recursive);
+    }
+    auto topology = std::make_shared<MultiDimTopology>(faulty_links, non_recursive_topo);
+    for (const auto& snapshot_dim : snapshot_dims) {
+        const auto topology_type = static_cast<TopologyBuildingBlock>(snapshot_dim.topology_type);
+        topology->append_dimension(construct_dim_topology(topology_type, snapshot_dim.npus_count,
+                                                          snapshot_dim.bandwidth, snapshot_dim.latency));
+    }
+    topology->initialize_all_devices();
+    topology->build_switch_length_mapping();
+    if (topology->npus_count != header.npus_count ||
+        topology->devices.size() != static_cast<size_t>(header.devices_count)) {
+        snapshot_error(path, "shape doesn't match the saved device count");
+    }
+
+    // restore links as saved, without expanding connection policies
+    for (uint64_t i = 0; i < header.links_count; i++) {
+        auto snapshot_link = SnapshotLink();
+        std::memcpy(&snapshot_link, data + offset, sizeof(snapshot_link));
+        offset += sizeof(snapshot_link);
+        if (snapshot_link.src < 0 || snapshot_link.src >= header.devices_count || snapshot_link.dest < 0 ||
+            snapshot_link.dest >= header.devices_count) {
+            snapshot_error(path, "link " + std::to_string(i) + " connects devices out of range (" +
+                                     std::to_string(snapshot_link.src) + " -> " + std::to_string(snapshot_link.dest) +
+                                     ")");
+        }
+        if (!(snapshot_link.bandwidth > 0)) {
+            snapshot_error(path, "link " + std::to_string(i) + " has non-positive bandwidth");
+        }
+        topology->connect(snapshot_link.src, snapshot_link.dest, snapshot_link.bandwidth, snapshot_link.latency, false);
+    }
+    assert(offset == file_size);
+
+    // links of a lazy topology not crossed before saving are instantiated on demand again
+    if (header.lazy_links != 0) {
+        topology->make_lazy_connections();
+    }
+
+    munmap(mapped, file_size);
+    return topology;
+}
+
+};  // namespace NetworkAnalyticalCongestionAware
@@ -5,7 +5,7 @@ LICENSE file in the root directory of this source tree.
 
 #include "congestion_aware/SwitchTranslationUnit.h"
 #include <cassert>
-#include <iostream>
+#include <functional>
 #include <numeric>
 
 namespace NetworkAnalyticalCongestionAware {
@@ -14,60 +14,86 @@ SwitchTranslationUnit::SwitchTranslationUnit(std::vector<int> npus_count_per_dim
                                              std::vector<bool> is_switch_dim) noexcept
     : m_total_npus_count{std::accumulate(
           npus_count_per_dim.begin(), npus_count_per_dim.end(), 1, std::multiplies<int>())},
+      m_dims_count{static_cast<int>(npus_count_per_dim.size())},
       m_npus_count_per_dim{npus_count_per_dim},
       m_is_switch_dim{is_switch_dim} {
     assert(npus_count_per_dim.size() == is_switch_dim.size());
 
-    // build switch length to starting offset mapping
+    m_switch_base_id_per_dim.assign(m_dims_count, -1);
+    m_switch_strides.assign(m_dims_count * m_dims_count, 0);
+
+    // switches of each switch dimension are laid out contiguously after all NPUs,
+    // ordered from the lowest switch dimension to the highest one
     int cumulative_offset = 0;
-    int dims_count = m_npus_count_per_dim.size();
-    for (int dim = 0; dim < dims_count; dim++) {
-        if (m_is_switch_dim.at(dim)) {
-            // product of npus in all higher dimensions
-            int num_switches = std::accumulate(m_npus_count_per_dim.begin() + dim + 1, m_npus_count_per_dim.end(),
-                                               static_cast<int>(1), std::multiplies<int>());
-
-            int address_length = dims_count - dim - 1;
-            assert(m_switch_length_number_mapping.find(address_length) == m_switch_length_number_mapping.end());
-            m_switch_length_number_mapping.insert({address_length, cumulative_offset});
-            cumulative_offset += num_switches;
+    for (int switch_dim = 0; switch_dim < m_dims_count; switch_dim++) {
+        if (!m_is_switch_dim.at(switch_dim)) {
+            continue;
+        }
+
+        // a switch in switch_dim is identified by its address in all higher dimensions
+        DeviceId stride = 1;
+        for (int dim = switch_dim + 1; dim < m_dims_count; dim++) {
+            m_switch_strides.at(switch_dim * m_dims_count + dim) = stride;
+            stride *= m_npus_count_per_dim.at(dim);
         }
+
+        // stride now holds the number of switches in this dimension
+        m_switch_base_id_per_dim.at(switch_dim) = m_total_npus_count + cumulative_offset;
+        cumulative_offset += stride;
     }
 }
 
-[[nodiscard]] DeviceId SwitchTranslationUnit::translate_address_to_id(const MultiDimAddress& address) const noexcept {
+DeviceId SwitchTranslationUnit::translate_address_to_id(const MultiDimAddress& address) const noexcept {
+    assert(address.size() == m_dims_count);
+
     // find which dimension is the switch
     int switch_dim = -1;
-    for (int dim = 0; dim < address.size(); dim++) {
-        if (address.at(dim) == m_npus_count_per_dim.at(dim)) {
+    for (int dim = 0; dim < m_dims_count; dim++) {
+        if (address[dim] == m_npus_count_per_dim[dim]) {
             switch_dim = dim;
             break;
         }
     }
     assert(switch_dim != -1);
+    assert(m_is_switch_dim[switch_dim]);
+
+    // offset within the switch dimension, using the precomputed strides
+    const auto* const strides = m_switch_strides.data() + switch_dim * m_dims_count;
+    DeviceId device_id = m_switch_base_id_per_dim[switch_dim];
+    for (int dim = switch_dim + 1; dim < m_dims_count; dim++) {
+        device_id += strides[dim] * address[dim];
+    }
+
+    return device_id;
+}
+
+DeviceId SwitchTranslationUnit::get_switch_base_id(const int switch_dim) const noexcept {
+    assert(0 <= switch_dim && switch_dim < m_dims_count);
+    assert(m_is_switch_dim[switch_dim]);
+
+    return m_switch_base_id_per_dim[switch_dim];
+}
 
-    // get the length of rest address
-    int left_length = address.size() - switch_dim - 1;
-    MultiDimAddress partial_addr(address.begin() + switch_dim + 1, address.end());
-    // get offset on that level
-    DeviceId offset = translate_partial_address_to_offset(
-        partial_addr, std::vector<int>(m_npus_count_per_dim.begin() + switch_dim + 1, m_npus_count_per_dim.end()));
+DeviceId SwitchTranslationUnit::get_switch_stride(const int switch_dim, const int dim) const noexcept {
+    assert(0 <= switch_dim && switch_dim < m_dims_count);
+    assert(0 <= dim && dim < m_dims_count);
 
-    return m_total_npus_count + m_switch_length_number_mapping.at(left_length) + offset;
+    return m_switch_strides[switch_dim * m_dims_count + dim];
 }
 
-DeviceId SwitchTranslationUnit::translate_partial_address_to_offset(
-    const MultiDimAddress& partial_address, const std::vector<int>& partial_npus_count_per_dim) const noexcept {
-    // roughly duplicate of MultiDimTopology::translate_address_back
-    DeviceId device_id = 0;
-    for (int top_dim = partial_npus_count_per_dim.size() - 1; top_dim >= 0; top_dim--) {
-        DeviceId total_npus_in_group =
-            std::accumulate(partial_npus_count_per_dim.begin(), partial_npus_count_per_dim.begin() + top_dim,
-                            static_cast<DeviceId>(1), std::multiplies<DeviceId>());
+int SwitchTranslationUnit::get_switch_dim(const DeviceId switch_id) const noexcept {
+    assert(switch_id >= m_total_npus_count);
 
-        device_id += total_npus_in_group * partial_address.at(top_dim);
+    // switch dimensions are laid out in ascending order: the last base not above the id holds the switch
+    for (int switch_dim = m_dims_count - 1; switch_dim >= 0; switch_dim--) {
+        if (m_is_switch_dim[switch_dim] && m_switch_base_id_per_dim[switch_dim] <= switch_id) {
+            return switch_dim;
+        }
     }
-    return device_id;
+
+    // shouldn't reach here
+    assert(false);
+    return -1;
 }
 
 };  // namespace NetworkAnalyticalCongestionAware
@@ -4,18 +4,28 @@ LICENSE file in the root directory of this source tree.
 *******************************************************************************/
 
 #include "congestion_aware/Chunk.h"
+#include "common/Instrumentation.h"
 #include "congestion_aware/Device.h"
 #include "congestion_aware/Link.h"
 #include <cassert>
 
 using namespace NetworkAnalyticalCongestionAware;
 
+// declaring static next_chunk_id
+uint64_t Chunk::next_chunk_id = 0;
+
+// declaring static chunks_in_flight
+uint64_t Chunk::chunks_in_flight = 0;
+
 void Chunk::chunk_arrived_next_device(void* const chunk_ptr) noexcept {
     assert(chunk_ptr != nullptr);
 
     // cast to unique_ptr<Chunk>
     auto chunk = std::unique_ptr<Chunk>(static_cast<Chunk*>(chunk_ptr));
 
+    // the link is done with the chunk
+    chunk->unlink();
+
     // mark chunk arrived next node
     chunk->mark_arrived_next_device();
 
@@ -31,13 +41,27 @@ void Chunk::chunk_arrived_next_device(void* const chunk_ptr) noexcept {
 }
 
 Chunk::Chunk(const ChunkSize chunk_size, Route route, const Callback callback, const CallbackArg callback_arg) noexcept
-    : chunk_size(chunk_size),
+    : chunk_id(next_chunk_id++),
+      chunk_size(chunk_size),
       route(std::move(route)),
       callback(callback),
       callback_arg(callback_arg) {
     assert(chunk_size > 0);
     assert(!this->route.empty());
     assert(callback != nullptr);
+
+    chunks_in_flight++;
+    Instrumentation::chunk_created();
+}
+
+Chunk::~Chunk() noexcept {
+    assert(chunks_in_flight > 0);
+
+    chunks_in_flight--;
+}
+
+uint64_t Chunk::get_chunks_in_flight() noexcept {
+    return chunks_in_flight;
 }
 
 std::shared_ptr<Device> Chunk::current_device() const noexcept {
@@ -80,6 +104,14 @@ ChunkSize Chunk::get_size() const noexcept {
     return chunk_size;
 }
 
+uint64_t Chunk::get_id() const noexcept {
+    return chunk_id;
+}
+
+const Route& Chunk::get_route() const noexcept {
+    return route;
+}
+
 void Chunk::invoke_callback() noexcept {
     // invoke callback
     (*callback)(callback_arg);
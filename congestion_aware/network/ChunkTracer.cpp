@@ -0,0 +1,115 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/ChunkTracer.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <tuple>
+
+using namespace NetworkAnalyticalCongestionAware;
+
+ChunkTracer::ChunkTracer(const size_t capacity) noexcept : next_index(0), recorded_count(0) {
+    assert(capacity > 0);
+
+    // preallocate the ring buffer
+    records.resize(capacity);
+}
+
+void ChunkTracer::record(const ChunkTraceRecord& record) noexcept {
+    // overwrite the oldest record once full
+    records[next_index] = record;
+    next_index = (next_index + 1 == records.size()) ? 0 : next_index + 1;
+    recorded_count++;
+}
+
+size_t ChunkTracer::get_records_count() const noexcept {
+    return static_cast<size_t>(std::min<uint64_t>(recorded_count, records.size()));
+}
+
+uint64_t ChunkTracer::get_dropped_count() const noexcept {
+    return recorded_count - get_records_count();
+}
+
+void ChunkTracer::clear() noexcept {
+    next_index = 0;
+    recorded_count = 0;
+}
+
+void ChunkTracer::write_chrome_trace(const std::string& path,
+                                     const std::unordered_map<const Link*, LinkTrack>& link_tracks) const noexcept {
+    auto file = std::ofstream(path);
+    if (!file) {
+        std::cerr << "[Error] (network/analytical/congestion_aware): "
+                  << "cannot open " << path << " to write chunk trace" << std::endl;
+        std::exit(-1);
+    }
+
+    // assign thread ids to links ordered by (dim, src, dest)
+    auto ordered_tracks = std::map<std::tuple<int, DeviceId, DeviceId>, const Link*>();
+    for (const auto& [link, track] : link_tracks) {
+        ordered_tracks.emplace(std::make_tuple(track.dim, track.src, track.dest), link);
+    }
+    auto thread_ids = std::unordered_map<const Link*, int>();
+    for (const auto& [key, link] : ordered_tracks) {
+        thread_ids.emplace(link, static_cast<int>(thread_ids.size()));
+    }
+
+    // Chrome trace timestamps are in microseconds
+    file << std::fixed << std::setprecision(3);
+    file << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+    auto first_event = true;
+    const auto separator = [&]() -> const char* {
+        const auto* const sep = first_event ? "\n" : ",\n";
+        first_event = false;
+        return sep;
+    };
+
+    // name processes (dimensions) and threads (links) that appear in the records
+    const auto records_count = get_records_count();
+    const auto oldest_index = (records_count < records.size()) ? 0 : next_index;
+    auto used_links = std::vector<bool>(thread_ids.size(), false);
+    auto used_dims = std::map<int, bool>();
+    for (size_t i = 0; i < records_count; i++) {
+        const auto& record = records[(oldest_index + i) % records.size()];
+        const auto thread_id = thread_ids.find(record.link);
+        if (thread_id == thread_ids.end() || used_links[thread_id->second]) {
+            continue;
+        }
+        used_links[thread_id->second] = true;
+
+        const auto& track = link_tracks.at(record.link);
+        if (!used_dims[track.dim]) {
+            used_dims[track.dim] = true;
+            file << separator() << R"(  {"ph": "M", "name": "process_name", "pid": )" << track.dim
+                 << R"(, "args": {"name": "dim )" << track.dim << R"("}})";
+        }
+        file << separator() << R"(  {"ph": "M", "name": "thread_name", "pid": )" << track.dim
+             << R"(, "tid": )" << thread_id->second << R"(, "args": {"name": "link )" << track.src << " -> "
+             << track.dest << R"("}})";
+    }
+
+    // one complete event per transmission, spanning the serialization on the link
+    for (size_t i = 0; i < records_count; i++) {
+        const auto& record = records[(oldest_index + i) % records.size()];
+        const auto thread_id = thread_ids.find(record.link);
+        if (thread_id == thread_ids.end()) {
+            continue;
+        }
+
+        const auto& track = link_tracks.at(record.link);
+        file << separator() << R"(  {"ph": "X", "name": "chunk )" << record.chunk_id << R"(", "pid": )" << track.dim
+             << R"(, "tid": )" << thread_id->second << R"(, "ts": )" << (record.start_time / 1000.0)
+             << R"(, "dur": )" << ((record.end_time - record.start_time) / 1000.0)
+             << R"(, "args": {"chunk_id": )" << record.chunk_id << R"(, "bytes": )" << record.chunk_size
+             << R"(, "queueing_delay_ns": )" << record.queueing_delay << "}}";
+    }
+
+    file << "\n]}\n";
+}
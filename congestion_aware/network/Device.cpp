@@ -4,6 +4,7 @@ LICENSE file in the root directory of this source tree.
 *******************************************************************************/
 
 #include "congestion_aware/Device.h"
+#include "common/Instrumentation.h"
 #include "congestion_aware/Chunk.h"
 #include "congestion_aware/Link.h"
 #include <cassert>
@@ -40,6 +41,7 @@ void Device::send(std::unique_ptr<Chunk> chunk) noexcept {
 
     // send the chunk to the next dest
     // delegate this task to the link
+    Instrumentation::hop_forwarded();
     links[next_dest_id]->send(std::move(chunk));
 }
 
@@ -59,6 +61,25 @@ void Device::connect(const DeviceId id, const Bandwidth bandwidth, const Latency
     links[id] = std::make_shared<Link>(bandwidth, latency);
 }
 
+void Device::connect(const DeviceId id, std::shared_ptr<Link> link) noexcept {
+    assert(id >= 0);
+    assert(link != nullptr);
+    assert(!connected(id) || links[id] == link);
+
+    links[id] = std::move(link);
+}
+
+const std::map<DeviceId, std::shared_ptr<Link>>& Device::get_links() const noexcept {
+    return links;
+}
+
+void Device::reset() noexcept {
+    // reset all outgoing links
+    for (auto& [dest, link] : links) {
+        link->reset();
+    }
+}
+
 bool Device::connected(const DeviceId dest) const noexcept {
     assert(dest >= 0);
 
@@ -4,9 +4,11 @@ LICENSE file in the root directory of this source tree.
 *******************************************************************************/
 
 #include "congestion_aware/Link.h"
+#include "common/Instrumentation.h"
 #include "common/NetworkFunction.h"
 #include "congestion_aware/Chunk.h"
 #include "congestion_aware/Device.h"
+#include "congestion_aware/ReservedChunk.h"
 #include <cassert>
 
 using namespace NetworkAnalytical;
@@ -15,6 +17,17 @@ using namespace NetworkAnalyticalCongestionAware;
 // declaring static event_queue
 std::shared_ptr<EventQueue> Link::event_queue;
 
+// declaring static chunk_tracer
+std::shared_ptr<ChunkTracer> Link::chunk_tracer;
+
+double LinkStats::mean_pending_depth() const noexcept {
+    if (chunks_count == 0) {
+        return 0.0;
+    }
+
+    return static_cast<double>(pending_depth_sum) / static_cast<double>(chunks_count);
+}
+
 void Link::link_become_free(void* const link_ptr) noexcept {
     assert(link_ptr != nullptr);
 
@@ -37,11 +50,23 @@ void Link::set_event_queue(std::shared_ptr<EventQueue> event_queue_ptr) noexcept
     Link::event_queue = std::move(event_queue_ptr);
 }
 
+void Link::set_chunk_tracer(std::shared_ptr<ChunkTracer> chunk_tracer_ptr) noexcept {
+    // set the chunk tracer
+    Link::chunk_tracer = std::move(chunk_tracer_ptr);
+}
+
+const std::shared_ptr<ChunkTracer>& Link::get_chunk_tracer() noexcept {
+    return Link::chunk_tracer;
+}
+
 Link::Link(const Bandwidth bandwidth, const Latency latency) noexcept
     : bandwidth(bandwidth),
       latency(latency),
       pending_chunks(),
-      busy(false) {
+      in_flight_chunks(nullptr),
+      reserved_chunks(nullptr),
+      busy(false),
+      stats() {
     assert(bandwidth > 0);
     assert(latency >= 0);
 
@@ -49,12 +74,25 @@ Link::Link(const Bandwidth bandwidth, const Latency latency) noexcept
     bandwidth_Bpns = bw_GBps_to_Bpns(bandwidth);
 }
 
+Link::~Link() noexcept {
+    free_in_flight_chunks();
+}
+
 void Link::send(std::unique_ptr<Chunk> chunk) noexcept {
     assert(chunk != nullptr);
 
-    if (busy) {
+    // sample the queue depth seen by the arriving chunk
+    Instrumentation::queue_depth_sampled(pending_chunks.size());
+
+    if (busy || wait_for_reservation(chunk->get_size(), Link::event_queue->get_current_time())) {
         // link is busy, add to pending chunks
-        pending_chunks.push_back(std::move(chunk));
+        pending_chunks.push_back({std::move(chunk), Link::event_queue->get_current_time()});
+
+        // track the deepest queue
+        const auto pending_depth = static_cast<uint64_t>(pending_chunks.size());
+        if (pending_depth > stats.max_pending_depth) {
+            stats.max_pending_depth = pending_depth;
+        }
     } else {
         // service this chunk immediately
         schedule_chunk_transmission(std::move(chunk));
@@ -65,12 +103,21 @@ void Link::process_pending_transmission() noexcept {
     // pending chunk should exist
     assert(pending_chunk_exists());
 
+    // a reserved chunk may hold the link next
+    const auto& front_chunk = pending_chunks.front();
+    if (wait_for_reservation(front_chunk.chunk->get_size(), front_chunk.enqueued_time)) {
+        return;
+    }
+
     // get chunk to process
-    auto chunk = std::move(pending_chunks.front());
+    auto& pending_chunk = pending_chunks.front();
+    auto chunk = std::move(pending_chunk.chunk);
+    const auto queueing_delay = Link::event_queue->get_current_time() - pending_chunk.enqueued_time;
+    stats.queueing_delay += queueing_delay;
     pending_chunks.pop_front();
 
     // service this chunk
-    schedule_chunk_transmission(std::move(chunk));
+    schedule_chunk_transmission(std::move(chunk), queueing_delay);
 }
 
 bool Link::pending_chunk_exists() const noexcept {
@@ -78,6 +125,11 @@ bool Link::pending_chunk_exists() const noexcept {
     return !pending_chunks.empty();
 }
 
+size_t Link::get_queue_length() const noexcept {
+    // pending chunks, and the chunk in transmission if busy
+    return pending_chunks.size() + (busy ? 1 : 0);
+}
+
 void Link::set_busy() noexcept {
     // set busy to true
     busy = true;
@@ -88,6 +140,154 @@ void Link::set_free() noexcept {
     busy = false;
 }
 
+Bandwidth Link::get_bandwidth() const noexcept {
+    return bandwidth;
+}
+
+Latency Link::get_latency() const noexcept {
+    return latency;
+}
+
+const LinkStats& Link::get_stats() const noexcept {
+    return stats;
+}
+
+void Link::reset() noexcept {
+    // drop pending chunks, chunks in transmission, and reservations
+    pending_chunks.clear();
+    free_in_flight_chunks();
+    reservations.clear();
+
+    // set link free
+    set_free();
+
+    // clear statistics
+    stats = LinkStats();
+}
+
+void Link::free_in_flight_chunks() noexcept {
+    // each chunk unlinks itself from the list when deleted
+    while (in_flight_chunks != nullptr) {
+        delete in_flight_chunks;
+    }
+    while (reserved_chunks != nullptr) {
+        delete reserved_chunks;
+    }
+}
+
+bool Link::idle_during(const EventTime start_time, const EventTime end_time) noexcept {
+    assert(start_time <= end_time);
+
+    if (busy || pending_chunk_exists()) {
+        return false;
+    }
+
+    // reservations are sorted and disjoint: stop at the first one starting at or after end_time
+    drop_expired_reservations(Link::event_queue->get_current_time());
+    for (const auto& reservation : reservations) {
+        if (reservation.start_time >= end_time) {
+            break;
+        }
+        if (reservation.end_time > start_time) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void Link::reserve(ReservedChunk* const reserved_chunk, const int hop, const EventTime start_time) noexcept {
+    assert(reserved_chunk != nullptr);
+
+    const auto chunk_size = reserved_chunk->get_size();
+    const auto end_time = start_time + serialization_delay(chunk_size);
+
+    // keep reservations sorted by start_time
+    auto position = reservations.begin();
+    while (position != reservations.end() && position->start_time < start_time) {
+        position++;
+    }
+    reservations.insert(position, {start_time, end_time, reserved_chunk, hop});
+
+    // the first link of the route tracks the reserved chunk until it is deleted
+    if (hop == 0) {
+        reserved_chunk->link_into(reserved_chunks);
+    }
+
+    // the transmission is accounted for as if it went through the pending queue
+    stats.busy_time += serialization_delay(chunk_size);
+    stats.bytes += chunk_size;
+    stats.chunks_count++;
+}
+
+void Link::release(const ReservedChunk* const reserved_chunk) noexcept {
+    assert(reserved_chunk != nullptr);
+
+    for (auto it = reservations.begin(); it != reservations.end(); it++) {
+        if (it->reserved_chunk == reserved_chunk) {
+            // roll back statistics
+            const auto chunk_size = reserved_chunk->get_size();
+            stats.busy_time -= serialization_delay(chunk_size);
+            stats.bytes -= chunk_size;
+            stats.chunks_count--;
+
+            reservations.erase(it);
+            return;
+        }
+    }
+
+    // shouldn't reach here
+    assert(false);
+}
+
+void Link::drop_expired_reservations(const EventTime current_time) noexcept {
+    while (!reservations.empty() && reservations.front().end_time <= current_time) {
+        reservations.pop_front();
+    }
+}
+
+bool Link::wait_for_reservation(const ChunkSize chunk_size, const EventTime enqueued_time) noexcept {
+    assert(!busy);
+
+    if (reservations.empty()) {
+        return false;
+    }
+
+    const auto current_time = Link::event_queue->get_current_time();
+    const auto end_time = current_time + serialization_delay(chunk_size);
+    drop_expired_reservations(current_time);
+
+    while (!reservations.empty()) {
+        const auto& reservation = reservations.front();
+
+        if (reservation.start_time == current_time && enqueued_time < current_time) {
+            // the reserved chunk arrives just now, but this chunk has been queued since before:
+            // the reserved chunk would have queued up behind it
+            reservation.reserved_chunk->demote(reservation.hop);
+            continue;
+        }
+
+        if (reservation.start_time <= current_time) {
+            // the reserved chunk holds the link: wait until it leaves
+            set_busy();
+            auto* const link_ptr = static_cast<void*>(this);
+            Link::event_queue->schedule_event(reservation.end_time, link_become_free, link_ptr);
+            return true;
+        }
+
+        if (end_time <= reservation.start_time) {
+            // done before the reserved chunk arrives
+            return false;
+        }
+
+        // this chunk got here first and would still be serializing when the reserved chunk arrives:
+        // the reserved chunk queues behind it from this hop on (releases this reservation)
+        reservation.reserved_chunk->demote(reservation.hop);
+    }
+
+    return false;
+}
+
 EventTime Link::serialization_delay(const ChunkSize chunk_size) const noexcept {
     assert(chunk_size > 0);
 
@@ -108,7 +308,7 @@ EventTime Link::communication_delay(const ChunkSize chunk_size) const noexcept {
     return static_cast<EventTime>(delay);
 }
 
-void Link::schedule_chunk_transmission(std::unique_ptr<Chunk> chunk) noexcept {
+void Link::schedule_chunk_transmission(std::unique_ptr<Chunk> chunk, const EventTime queueing_delay) noexcept {
     assert(chunk != nullptr);
 
     // link should be free
@@ -121,9 +321,24 @@ void Link::schedule_chunk_transmission(std::unique_ptr<Chunk> chunk) noexcept {
     const auto chunk_size = chunk->get_size();
     const auto current_time = Link::event_queue->get_current_time();
 
+    // update statistics
+    stats.busy_time += serialization_delay(chunk_size);
+    stats.bytes += chunk_size;
+    stats.chunks_count++;
+    stats.pending_depth_sum += pending_chunks.size();
+
+    // record the transmission
+    if constexpr (chunk_trace_enabled) {
+        if (Link::chunk_tracer != nullptr) {
+            const auto end_time = current_time + serialization_delay(chunk_size);
+            Link::chunk_tracer->record({this, chunk->get_id(), chunk_size, current_time, end_time, queueing_delay});
+        }
+    }
+
     // schedule chunk arrival event
     const auto communication_time = communication_delay(chunk_size);
     const auto chunk_arrival_time = current_time + communication_time;
+    chunk->link_into(in_flight_chunks);
     auto* const chunk_ptr = static_cast<void*>(chunk.release());
     Link::event_queue->schedule_event(chunk_arrival_time, Chunk::chunk_arrived_next_device, chunk_ptr);
 
@@ -0,0 +1,181 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/ReservedChunk.h"
+#include "common/Instrumentation.h"
+#include "congestion_aware/Chunk.h"
+#include "congestion_aware/ChunkTracer.h"
+#include "congestion_aware/Device.h"
+#include "congestion_aware/Link.h"
+#include <cassert>
+
+using namespace NetworkAnalyticalCongestionAware;
+
+// declaring static event_queue
+std::shared_ptr<EventQueue> ReservedChunk::event_queue;
+
+void ReservedChunk::set_event_queue(std::shared_ptr<EventQueue> event_queue_ptr) noexcept {
+    assert(event_queue_ptr != nullptr);
+
+    // set the event queue
+    ReservedChunk::event_queue = std::move(event_queue_ptr);
+}
+
+std::unique_ptr<Chunk> ReservedChunk::try_reserve(std::unique_ptr<Chunk> chunk) noexcept {
+    assert(chunk != nullptr);
+    assert(!chunk->arrived_dest());
+
+    const auto& route = chunk->get_route();
+    const auto chunk_size = chunk->get_size();
+    const auto hops_count = static_cast<int>(route.size()) - 1;
+
+    // walk the route with the congestion-unaware timing:
+    // every link must be idle while the chunk serializes on it
+    auto links = std::vector<Link*>();
+    auto arrival_times = std::vector<EventTime>();
+    links.reserve(hops_count);
+    arrival_times.reserve(hops_count + 1);
+
+    auto arrival_time = ReservedChunk::event_queue->get_current_time();
+    for (auto it = route.begin(), next_it = std::next(it); next_it != route.end(); it++, next_it++) {
+        auto* const link = (*it)->get_links().at((*next_it)->get_id()).get();
+        if (!link->idle_during(arrival_time, arrival_time + link->serialization_delay(chunk_size))) {
+            // contended: take the event-driven path
+            return chunk;
+        }
+
+        links.push_back(link);
+        arrival_times.push_back(arrival_time);
+        arrival_time += link->communication_delay(chunk_size);
+    }
+    arrival_times.push_back(arrival_time);
+
+    // reserve every link, and schedule the final arrival only
+    auto* const reserved_chunk = new ReservedChunk(std::move(chunk), std::move(links), std::move(arrival_times));
+    for (int hop = 0; hop < hops_count; hop++) {
+        reserved_chunk->links[hop]->reserve(reserved_chunk, hop, reserved_chunk->arrival_times[hop]);
+    }
+
+    reserved_chunk->pending_events_count++;
+    auto* const reserved_chunk_ptr = static_cast<void*>(reserved_chunk);
+    ReservedChunk::event_queue->schedule_event(arrival_time, chunk_arrived_dest, reserved_chunk_ptr);
+
+    return nullptr;
+}
+
+ReservedChunk::ReservedChunk(std::unique_ptr<Chunk> chunk,
+                             std::vector<Link*> links,
+                             std::vector<EventTime> arrival_times) noexcept
+    : chunk(std::move(chunk)),
+      links(std::move(links)),
+      arrival_times(std::move(arrival_times)),
+      pending_events_count(0) {
+    assert(this->chunk != nullptr);
+    assert(!this->links.empty());
+    assert(this->arrival_times.size() == this->links.size() + 1);
+
+    chunk_size = this->chunk->get_size();
+    demoted_hop = static_cast<int>(this->links.size());
+}
+
+void ReservedChunk::demote(const int hop) noexcept {
+    assert(0 <= hop && hop < static_cast<int>(links.size()));
+
+    if (hop >= demoted_hop) {
+        // already taking the event-driven path from this hop
+        return;
+    }
+
+    // a demotion always happens before the chunk reaches the hop, or just as it does
+    // (the resume then fires later in the same time step)
+    assert(ReservedChunk::event_queue->get_current_time() <= arrival_times[hop]);
+
+    // give up the remaining reservations
+    for (int h = hop; h < demoted_hop; h++) {
+        links[h]->release(this);
+    }
+    demoted_hop = hop;
+
+    // re-enter the event-driven path once the chunk reaches the hop
+    // (a resume scheduled by an earlier demotion fires later and finds the chunk gone)
+    pending_events_count++;
+    auto* const reserved_chunk_ptr = static_cast<void*>(this);
+    ReservedChunk::event_queue->schedule_event(arrival_times[hop], chunk_resumed, reserved_chunk_ptr);
+}
+
+ChunkSize ReservedChunk::get_size() const noexcept {
+    assert(chunk_size > 0);
+
+    return chunk_size;
+}
+
+void ReservedChunk::chunk_arrived_dest(void* const reserved_chunk_ptr) noexcept {
+    assert(reserved_chunk_ptr != nullptr);
+
+    auto* const reserved_chunk = static_cast<ReservedChunk*>(reserved_chunk_ptr);
+
+    if (reserved_chunk->demoted_hop == static_cast<int>(reserved_chunk->links.size())) {
+        // arrived through the fast path
+        reserved_chunk->trace_transmissions(reserved_chunk->demoted_hop);
+        auto chunk = std::move(reserved_chunk->chunk);
+        for (int hop = 0; hop < reserved_chunk->demoted_hop; hop++) {
+            chunk->mark_arrived_next_device();
+        }
+        assert(chunk->arrived_dest());
+        chunk->invoke_callback();
+    }
+
+    event_fired(reserved_chunk);
+}
+
+void ReservedChunk::chunk_resumed(void* const reserved_chunk_ptr) noexcept {
+    assert(reserved_chunk_ptr != nullptr);
+
+    auto* const reserved_chunk = static_cast<ReservedChunk*>(reserved_chunk_ptr);
+
+    if (reserved_chunk->chunk != nullptr) {
+        // move the chunk up to the demoted hop, then send it as usual
+        reserved_chunk->trace_transmissions(reserved_chunk->demoted_hop);
+        auto chunk = std::move(reserved_chunk->chunk);
+        for (int hop = 0; hop < reserved_chunk->demoted_hop; hop++) {
+            chunk->mark_arrived_next_device();
+        }
+        const auto current_device = chunk->current_device();
+        current_device->send(std::move(chunk));
+    }
+
+    event_fired(reserved_chunk);
+}
+
+void ReservedChunk::trace_transmissions(const int hops_count) const noexcept {
+    assert(chunk != nullptr);
+
+    for (int hop = 0; hop < hops_count; hop++) {
+        Instrumentation::hop_forwarded();
+    }
+
+    // record the transmissions as Link would have
+    if constexpr (chunk_trace_enabled) {
+        const auto& chunk_tracer = Link::get_chunk_tracer();
+        if (chunk_tracer != nullptr) {
+            for (int hop = 0; hop < hops_count; hop++) {
+                const auto start_time = arrival_times[hop];
+                const auto end_time = start_time + links[hop]->serialization_delay(chunk_size);
+                chunk_tracer->record({links[hop], chunk->get_id(), chunk_size, start_time, end_time, 0});
+            }
+        }
+    }
+}
+
+void ReservedChunk::event_fired(ReservedChunk* const reserved_chunk) noexcept {
+    assert(reserved_chunk != nullptr);
+    assert(reserved_chunk->pending_events_count > 0);
+
+    // the last event referring to the object releases it
+    reserved_chunk->pending_events_count--;
+    if (reserved_chunk->pending_events_count == 0) {
+        delete reserved_chunk;
+    }
+}
@@ -6,11 +6,14 @@ LICENSE file in the root directory of this source tree.
 #include "congestion_aware/Helper.h"
 #include "congestion_aware/BinaryTree.h"
 #include "congestion_aware/DoubleBinaryTree.h"
+#include "congestion_aware/Dragonfly.h"
+#include "congestion_aware/FatTree.h"
 #include "congestion_aware/FullyConnected.h"
 #include "congestion_aware/Mesh.h"
 #include "congestion_aware/MultiDimTopology.h"
 #include "congestion_aware/Ring.h"
 #include "congestion_aware/Torus2D.h"
+#include "congestion_aware/TorusND.h"
 #include "congestion_aware/Mesh2D.h"
 #include "congestion_aware/KingMesh2D.h"
 #include "congestion_aware/Switch.h"
@@ -21,8 +24,9 @@ LICENSE file in the root directory of this source tree.
 using namespace NetworkAnalytical;
 using namespace NetworkAnalyticalCongestionAware;
 
-std::shared_ptr<Topology> NetworkAnalyticalCongestionAware::construct_topology(
-    const NetworkParser& network_parser) noexcept {
+std::shared_ptr<Topology> NetworkAnalyticalCongestionAware::construct_topology(const NetworkParser& network_parser,
+                                                                               const int threads_count,
+                                                                               const bool lazy_links) noexcept {
     // get network_parser info
     const auto dims_count = network_parser.get_dims_count();
     const auto topologies_per_dim = network_parser.get_topologies_per_dim();
@@ -63,6 +67,20 @@ std::shared_ptr<Topology> NetworkAnalyticalCongestionAware::construct_topology(
             return std::make_shared<KingMesh2D>(npus_count, bandwidth, latency);
         case TopologyBuildingBlock::HyperCube:
             return std::make_shared<HyperCube>(npus_count, bandwidth, latency, faulty_links);
+        case TopologyBuildingBlock::TorusND:
+        case TopologyBuildingBlock::MeshND:
+            return std::make_shared<TorusND>(network_parser.get_shape(), bandwidth, latency,
+                                             network_parser.get_wraparound(), true, faulty_links);
+        case TopologyBuildingBlock::FatTree:
+            return std::make_shared<FatTree>(network_parser.get_radix(), network_parser.get_tiers(),
+                                             network_parser.get_oversubscription(), bandwidth, latency, faulty_links);
+        case TopologyBuildingBlock::Dragonfly:
+            return std::make_shared<Dragonfly>(
+                network_parser.get_groups(), network_parser.get_routers_per_group(),
+                network_parser.get_global_links_per_router(),
+                npus_count / (network_parser.get_groups() * network_parser.get_routers_per_group()),
+                network_parser.get_dragonfly_arrangement(), network_parser.get_dragonfly_routing(), bandwidth, latency,
+                faulty_links);
         default:
             // shouldn't reaach here
             std::cerr << "[Error] (network/analytical/congestion_aware) "
@@ -81,64 +99,68 @@ std::shared_ptr<Topology> NetworkAnalyticalCongestionAware::construct_topology(
             const auto bandwidth = bandwidths_per_dim[dim];
             const auto latency = latencies_per_dim[dim];
             //const auto non_recursive_topo = non_recursive_topo_per_dim[dim];
-            const bool is_multi_dim = true;
 
             // create a network dim
-            std::unique_ptr<BasicTopology> dim_topology;
-            switch (topology_type) {
-            case TopologyBuildingBlock::Ring:
-                dim_topology =
-                    std::make_unique<Ring>(npus_count, bandwidth, latency, /* bidirectional = */ true, is_multi_dim);
-                break;
-            case TopologyBuildingBlock::Switch:
-                dim_topology = std::make_unique<Switch>(npus_count, bandwidth, latency, is_multi_dim);
-                break;
-            case TopologyBuildingBlock::FullyConnected:
-                dim_topology = std::make_unique<FullyConnected>(npus_count, bandwidth, latency, is_multi_dim);
-                break;
-            case TopologyBuildingBlock::BinaryTree:
-                dim_topology = std::make_unique<BinaryTree>(npus_count, bandwidth, latency, is_multi_dim);
-                break;
-            case TopologyBuildingBlock::DoubleBinaryTree:
-                dim_topology = std::make_unique<DoubleBinaryTree>(npus_count, bandwidth, latency, is_multi_dim);
-                break;
-            case TopologyBuildingBlock::Mesh:
-                dim_topology = std::make_unique<Mesh>(npus_count, bandwidth, latency, is_multi_dim);
-                break;
-            case TopologyBuildingBlock::Torus2D:
-                dim_topology = std::make_unique<Torus2D>(npus_count, bandwidth, latency, is_multi_dim);
-                break;
-            case TopologyBuildingBlock::Mesh2D:
-                dim_topology = std::make_unique<Mesh2D>(npus_count, bandwidth, latency, is_multi_dim);
-                break;
-            case TopologyBuildingBlock::KingMesh2D:
-                dim_topology = std::make_unique<KingMesh2D>(npus_count, bandwidth, latency, is_multi_dim);
-                break;
-            case TopologyBuildingBlock::HyperCube:
-                dim_topology =
-                    std::make_unique<HyperCube>(npus_count, bandwidth, latency, /* bidirectional = */ true, is_multi_dim);
-                break;
-
-            default:
-                // shouldn't reach here
-                std::cerr << "[Error] (network/analytical/congestion_aware)"
-                          << "Not supported multi-topology" << std::endl;
-                std::exit(-1);
-            }
+            auto dim_topology = construct_dim_topology(topology_type, npus_count, bandwidth, latency);
 
             // append network dimension
             multi_dim_topology->append_dimension(std::move(dim_topology));
         }
 
-        multi_dim_topology->initialize_all_devices();
+        multi_dim_topology->initialize_all_devices(threads_count);
         multi_dim_topology->build_switch_length_mapping();
-        multi_dim_topology->make_connections();
+        if (lazy_links) {
+            multi_dim_topology->make_lazy_connections();
+        } else {
+            multi_dim_topology->make_connections(threads_count);
+        }
 
         // return created multi-dimensional topology
         return multi_dim_topology;
     }
 }
 
+std::shared_ptr<Topology> NetworkAnalyticalCongestionAware::construct_topology_from_snapshot(
+    const std::string& path) noexcept {
+    return MultiDimTopology::load_snapshot(path);
+}
+
+std::unique_ptr<BasicTopology> NetworkAnalyticalCongestionAware::construct_dim_topology(
+    const TopologyBuildingBlock topology_type,
+    const int npus_count,
+    const Bandwidth bandwidth,
+    const Latency latency) noexcept {
+    const bool is_multi_dim = true;
+
+    switch (topology_type) {
+    case TopologyBuildingBlock::Ring:
+        return std::make_unique<Ring>(npus_count, bandwidth, latency, /* bidirectional = */ true, is_multi_dim);
+    case TopologyBuildingBlock::Switch:
+        return std::make_unique<Switch>(npus_count, bandwidth, latency, is_multi_dim);
+    case TopologyBuildingBlock::FullyConnected:
+        return std::make_unique<FullyConnected>(npus_count, bandwidth, latency, is_multi_dim);
+    case TopologyBuildingBlock::BinaryTree:
+        return std::make_unique<BinaryTree>(npus_count, bandwidth, latency, is_multi_dim);
+    case TopologyBuildingBlock::DoubleBinaryTree:
+        return std::make_unique<DoubleBinaryTree>(npus_count, bandwidth, latency, is_multi_dim);
+    case TopologyBuildingBlock::Mesh:
+        return std::make_unique<Mesh>(npus_count, bandwidth, latency, is_multi_dim);
+    case TopologyBuildingBlock::Torus2D:
+        return std::make_unique<Torus2D>(npus_count, bandwidth, latency, is_multi_dim);
+    case TopologyBuildingBlock::Mesh2D:
+        return std::make_unique<Mesh2D>(npus_count, bandwidth, latency, is_multi_dim);
+    case TopologyBuildingBlock::KingMesh2D:
+        return std::make_unique<KingMesh2D>(npus_count, bandwidth, latency, is_multi_dim);
+    case TopologyBuildingBlock::HyperCube:
+        return std::make_unique<HyperCube>(npus_count, bandwidth, latency, /* bidirectional = */ true, is_multi_dim);
+    default:
+        // shouldn't reach here
+        std::cerr << "[Error] (network/analytical/congestion_aware)"
+                  << "Not supported multi-topology" << std::endl;
+        std::exit(-1);
+    }
+}
+
 std::vector<std::pair<MultiDimAddress, MultiDimAddress>> NetworkAnalyticalCongestionAware::generateAddressPairs(
     const MultiDimAddress& upper, const ConnectionPolicy& policy, int dim) noexcept {
     std::vector<std::pair<MultiDimAddress, MultiDimAddress>> result;
@@ -5,18 +5,34 @@ LICENSE file in the root directory of this source tree.
 
 #include "congestion_aware/Topology.h"
 #include "congestion_aware/Link.h"
+#include "congestion_aware/ReservedChunk.h"
 #include <cassert>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
 
 using namespace NetworkAnalyticalCongestionAware;
 
 void Topology::set_event_queue(std::shared_ptr<EventQueue> event_queue) noexcept {
     assert(event_queue != nullptr);
 
-    // pass the given event_queue to Link
+    // pass the given event_queue to Link and ReservedChunk
+    ReservedChunk::set_event_queue(event_queue);
     Link::set_event_queue(std::move(event_queue));
 }
 
-Topology::Topology() noexcept : npus_count(-1), devices_count(-1), dims_count(-1) {
+void Topology::set_chunk_tracer(std::shared_ptr<ChunkTracer> chunk_tracer) noexcept {
+    // pass the given chunk_tracer to Link
+    Link::set_chunk_tracer(std::move(chunk_tracer));
+}
+
+Topology::Topology() noexcept
+    : npus_count(-1),
+      devices_count(-1),
+      dims_count(-1),
+      hybrid_mode(false),
+      lazy_links(false) {
     npus_count_per_dim = {};
 }
 
@@ -36,6 +52,12 @@ int Topology::get_npus_count() const noexcept {
     return npus_count;
 }
 
+std::shared_ptr<Device> Topology::get_device(const DeviceId id) const noexcept {
+    assert(0 <= id && id < static_cast<DeviceId>(devices.size()));
+
+    return devices[id];
+}
+
 int Topology::get_dims_count() const noexcept {
     assert(dims_count > 0);
 
@@ -54,6 +76,11 @@ std::vector<Bandwidth> Topology::get_bandwidth_per_dim() const noexcept {
     return bandwidth_per_dim;
 }
 
+Route Topology::route_chunk(const DeviceId src, const DeviceId dest, const uint64_t chunk_id) const noexcept {
+    // a single route per src-dest pair by default
+    return route(src, dest);
+}
+
 void Topology::send(std::unique_ptr<Chunk> chunk) noexcept {
     assert(chunk != nullptr);
 
@@ -63,10 +90,121 @@ void Topology::send(std::unique_ptr<Chunk> chunk) noexcept {
     // assert src is valid
     assert(0 <= src && src < devices_count);
 
+    // instantiate the links of the route not crossed before
+    if (lazy_links) {
+        const auto& route = chunk->get_route();
+        for (auto it = route.begin(), next = std::next(it); next != route.end(); it = next++) {
+            if (!(*it)->connected((*next)->get_id())) {
+                connect_lazily((*it)->get_id(), (*next)->get_id());
+            }
+        }
+    }
+
+    // in hybrid mode, try the fast path first
+    if (hybrid_mode) {
+        chunk = ReservedChunk::try_reserve(std::move(chunk));
+        if (chunk == nullptr) {
+            return;
+        }
+    }
+
     // initiate transmission from src
     devices.at(src)->send(std::move(chunk));
 }
 
+void Topology::set_hybrid_mode(const bool hybrid_mode) noexcept {
+    this->hybrid_mode = hybrid_mode;
+}
+
+void Topology::reset() noexcept {
+    // reset all devices, O(links)
+    for (auto& device : devices) {
+        device->reset();
+    }
+}
+
+void Topology::dump_link_stats(const std::string& path) const noexcept {
+    auto file = std::ofstream(path);
+    if (!file) {
+        std::cerr << "[Error] (network/analytical/congestion_aware): "
+                  << "cannot open " << path << " to dump link stats" << std::endl;
+        std::exit(-1);
+    }
+
+    // pick the format from the extension
+    const auto json_suffix = std::string(".json");
+    const auto is_json = path.size() >= json_suffix.size() &&
+                         path.compare(path.size() - json_suffix.size(), json_suffix.size(), json_suffix) == 0;
+
+    if (is_json) {
+        file << "[";
+    } else {
+        file << "src,dest,dim,busy_time_ns,bytes,chunks_count,max_pending_depth,mean_pending_depth,queueing_delay_ns\n";
+    }
+
+    auto first_entry = true;
+    for (const auto& device : devices) {
+        const auto src = device->get_id();
+        for (const auto& [dest, link] : device->get_links()) {
+            const auto dim = get_link_dim(src, dest);
+            const auto& stats = link->get_stats();
+
+            if (is_json) {
+                file << (first_entry ? "\n" : ",\n") << "  {\"src\": " << src << ", \"dest\": " << dest
+                     << ", \"dim\": " << dim << ", \"busy_time_ns\": " << stats.busy_time
+                     << ", \"bytes\": " << stats.bytes << ", \"chunks_count\": " << stats.chunks_count
+                     << ", \"max_pending_depth\": " << stats.max_pending_depth
+                     << ", \"mean_pending_depth\": " << stats.mean_pending_depth()
+                     << ", \"queueing_delay_ns\": " << stats.queueing_delay << "}";
+            } else {
+                file << src << "," << dest << "," << dim << "," << stats.busy_time << "," << stats.bytes << ","
+                     << stats.chunks_count << "," << stats.max_pending_depth << "," << stats.mean_pending_depth()
+                     << "," << stats.queueing_delay << "\n";
+            }
+            first_entry = false;
+        }
+    }
+
+    if (is_json) {
+        file << "\n]\n";
+    }
+}
+
+void Topology::dump_chunk_trace(const std::string& path) const noexcept {
+    const auto& chunk_tracer = Link::get_chunk_tracer();
+    if (chunk_tracer == nullptr) {
+        std::cerr << "[Error] (network/analytical/congestion_aware): "
+                  << "no chunk tracer is set" << std::endl;
+        std::exit(-1);
+    }
+
+    // name every link of this topology
+    auto link_tracks = std::unordered_map<const Link*, LinkTrack>();
+    for (const auto& device : devices) {
+        const auto src = device->get_id();
+        for (const auto& [dest, link] : device->get_links()) {
+            link_tracks.emplace(link.get(), LinkTrack{src, dest, get_link_dim(src, dest)});
+        }
+    }
+
+    chunk_tracer->write_chrome_trace(path, link_tracks);
+}
+
+int Topology::get_link_dim(const DeviceId src, const DeviceId dest) const noexcept {
+    assert(0 <= src && src < devices_count);
+    assert(0 <= dest && dest < devices_count);
+
+    // single-dimensional by default
+    return 0;
+}
+
+void Topology::connect_lazily(const DeviceId src, const DeviceId dest) noexcept {
+    // shouldn't reach here
+    std::cerr << "[Error] (network/analytical/congestion_aware): "
+              << "lazy links are not supported by this topology (" << src << " -> " << dest << ")" << std::endl;
+    std::exit(-1);
+}
+
 void Topology::connect(const DeviceId src,
                        const DeviceId dest,
                        const Bandwidth bandwidth,
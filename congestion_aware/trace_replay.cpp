@@ -0,0 +1,87 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/EventQueue.h"
+#include "common/NetworkParser.h"
+#include "common/OptionParser.h"
+#include "congestion_aware/Helper.h"
+#include "congestion_aware/TraceReplayer.h"
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+
+namespace {
+
+void print_usage(const char* const program) {
+    std::cerr << "Usage: " << program << " <network.yml> <trace> [options]" << std::endl
+              << "  trace: CSV (issue_time,depends_on,src,dest,bytes) or binary (*.bin)" << std::endl
+              << "  --output <path>            per-message completion CSV" << std::endl
+              << "  --window <count>           messages kept in memory (default: 65536)" << std::endl
+              << "  --hybrid                   enable hybrid simulation" << std::endl;
+}
+
+}  // namespace
+
+int main(const int argc, const char* const argv[]) {
+    if (argc < 3) {
+        print_usage(argv[0]);
+        return -1;
+    }
+
+    // parse arguments
+    const auto network_config_path = std::string(argv[1]);
+    const auto trace_path = std::string(argv[2]);
+    auto output_path = std::string();
+    auto window = 65'536;
+    auto hybrid_mode = false;
+
+    for (int i = 3; i < argc; i++) {
+        const auto option = std::string(argv[i]);
+        if (option == "--hybrid") {
+            hybrid_mode = true;
+        } else if (option == "--output" && i + 1 < argc) {
+            output_path = argv[++i];
+        } else if (option == "--window" && i + 1 < argc) {
+            parse_number(argv[0], option, argv[++i], window, print_usage);
+            if (window <= 0) {
+                std::cerr << "[Error] (network/analytical/congestion_aware/trace_replay): "
+                          << "--window (" << window << ") should be positive" << std::endl;
+                print_usage(argv[0]);
+                return -1;
+            }
+        } else {
+            print_usage(argv[0]);
+            return -1;
+        }
+    }
+
+    // Instantiate shared resources
+    const auto event_queue = std::make_shared<EventQueue>();
+    Topology::set_event_queue(event_queue);
+
+    // Parse network config and create topology
+    const auto network_parser = NetworkParser(network_config_path);
+    const auto topology = construct_topology(network_parser);
+    topology->set_hybrid_mode(hybrid_mode);
+
+    // Replay the trace
+    auto trace_replayer = TraceReplayer(topology, event_queue, TraceReader::open(trace_path), window, output_path);
+    trace_replayer.start();
+    while (!event_queue->finished()) {
+        event_queue->proceed();
+    }
+
+    // Print simulation result
+    const auto& stats = trace_replayer.get_stats();
+    std::cout << "Messages completed: " << stats.messages_count << std::endl;
+    std::cout << "Bytes delivered: " << stats.bytes << std::endl;
+    std::cout << "Late messages: " << stats.late_messages_count << std::endl;
+    std::cout << "Simulation finished at time: " << stats.finish_time << " ns" << std::endl;
+
+    return 0;
+}
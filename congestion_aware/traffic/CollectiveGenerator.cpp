@@ -0,0 +1,465 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/CollectiveGenerator.h"
+#include "common/NetworkFunction.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+
+namespace {
+
+[[noreturn]] void collective_error(const std::string& message) noexcept {
+    std::cerr << "[Error] (network/analytical/congestion_aware/CollectiveGenerator): " << message << std::endl;
+    std::exit(-1);
+}
+
+/// number of trailing zero bits of value > 0
+int trailing_zeros(const int value) noexcept {
+    assert(value > 0);
+
+    auto count = 0;
+    while (((value >> count) & 1) == 0) {
+        count++;
+    }
+    return count;
+}
+
+}  // namespace
+
+/**
+ * Emits the sends of a lane (a chunk of the buffer, or a tree of a chunk) step by step.
+ *
+ * Every NPU keeps a frontier: the sends its next sends wait for.
+ * Sends received during a step join the frontier at the next step,
+ * replacing it if the NPU sent since the frontier was formed (the new data supersedes it),
+ * or extending it otherwise (e.g., a tree node waiting for children received at different steps).
+ */
+class CollectiveGenerator::LaneBuilder {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param schedule schedule to append the sends to
+     * @param frontiers initial frontier of each NPU
+     */
+    LaneBuilder(CollectiveSchedule& schedule, std::vector<std::vector<int>> frontiers) noexcept
+        : schedule(schedule),
+          frontiers(std::move(frontiers)),
+          arrivals(this->frontiers.size()),
+          sent(this->frontiers.size(), false) {}
+
+    /**
+     * Start a new step: sends received so far join the frontiers.
+     */
+    void step() noexcept {
+        for (size_t npu = 0; npu < frontiers.size(); npu++) {
+            auto& npu_arrivals = arrivals[npu];
+            if (npu_arrivals.empty()) {
+                continue;
+            }
+
+            auto& frontier = frontiers[npu];
+            if (sent[npu]) {
+                frontier.swap(npu_arrivals);
+                sent[npu] = false;
+            } else {
+                frontier.insert(frontier.end(), npu_arrivals.begin(), npu_arrivals.end());
+            }
+            npu_arrivals.clear();
+        }
+    }
+
+    /**
+     * Emit a send of the current step.
+     *
+     * @param src source NPU
+     * @param dest destination NPU
+     * @param size size of the send
+     */
+    void send(const DeviceId src, const DeviceId dest, const double size) noexcept {
+        assert(src != dest);
+
+        const auto node = static_cast<int>(schedule.nodes.size());
+        const auto bytes = std::max(static_cast<ChunkSize>(std::ceil(size)), ChunkSize{1});
+        schedule.nodes.push_back({src, dest, bytes});
+        for (const auto dependency : frontiers[src]) {
+            schedule.edges.emplace_back(dependency, node);
+        }
+
+        sent[src] = true;
+        arrivals[dest].push_back(node);
+    }
+
+    /**
+     * Close the lane.
+     *
+     * @return final frontier of each NPU
+     */
+    [[nodiscard]] std::vector<std::vector<int>> finish() noexcept {
+        step();
+        return std::move(frontiers);
+    }
+
+  private:
+    /// schedule to append the sends to
+    CollectiveSchedule& schedule;
+
+    /// sends the next sends of each NPU wait for
+    std::vector<std::vector<int>> frontiers;
+
+    /// sends each NPU received during the current step
+    std::vector<std::vector<int>> arrivals;
+
+    /// whether each NPU sent since its frontier was formed
+    std::vector<bool> sent;
+};
+
+CollectiveGenerator::CollectiveGenerator(std::shared_ptr<const Topology> topology,
+                                         const int chunks_count,
+                                         const int pipeline_depth) noexcept
+    : topology(std::move(topology)),
+      chunks_count(chunks_count),
+      pipeline_depth(pipeline_depth) {
+    assert(this->topology != nullptr);
+    assert(chunks_count > 0);
+    assert(pipeline_depth > 0);
+
+    const auto npus_count = this->topology->get_npus_count();
+    const auto npus_count_per_dim = this->topology->get_npus_count_per_dim();
+
+    // one group per dimension, instantiated at every NPU whose coordinate of the dimension is 0
+    auto stride = DeviceId{1};
+    for (const auto dim_npus_count : npus_count_per_dim) {
+        auto group = Group{dim_npus_count, stride, {}};
+        for (auto base = DeviceId{0}; base < npus_count; base++) {
+            if ((base / stride) % dim_npus_count == 0) {
+                group.bases.push_back(base);
+            }
+        }
+
+        group_per_dim.push_back(std::move(group));
+        stride *= dim_npus_count;
+    }
+
+    // all NPUs
+    flat_group = Group{npus_count, 1, {0}};
+}
+
+CollectiveSchedule CollectiveGenerator::generate(const CollectiveOperation operation,
+                                                 const CollectiveAlgorithm algorithm,
+                                                 const ChunkSize collective_size) const noexcept {
+    assert(collective_size > 0);
+
+    if (algorithm == CollectiveAlgorithm::Hierarchical) {
+        const auto algorithm_per_dim =
+            std::vector<CollectiveAlgorithm>(topology->get_dims_count(), CollectiveAlgorithm::Ring);
+        return generate_hierarchical(operation, algorithm_per_dim, collective_size);
+    }
+
+    if (algorithm == CollectiveAlgorithm::DoubleBinaryTree) {
+        if (operation != CollectiveOperation::AllReduce) {
+            collective_error("DoubleBinaryTree only supports AllReduce");
+        }
+
+        // each tree carries half of the buffer, and both trees run concurrently
+        const auto emit_lane = [this](LaneBuilder& builder, const int tree, const double chunk_size) {
+            emit_tree(builder, flat_group, tree, chunk_size / 2);
+        };
+        return generate_lanes(2, emit_lane, collective_size);
+    }
+
+    const auto emit_lane = [this, operation, algorithm](LaneBuilder& builder, int, const double chunk_size) {
+        emit_group(builder, flat_group, operation, algorithm, chunk_size);
+    };
+    return generate_lanes(1, emit_lane, collective_size);
+}
+
+CollectiveSchedule CollectiveGenerator::generate_hierarchical(
+    const CollectiveOperation operation,
+    const std::vector<CollectiveAlgorithm>& algorithm_per_dim,
+    const ChunkSize collective_size) const noexcept {
+    assert(collective_size > 0);
+
+    const auto dims_count = static_cast<int>(group_per_dim.size());
+    if (static_cast<int>(algorithm_per_dim.size()) != dims_count) {
+        collective_error("one algorithm per dimension is required");
+    }
+
+    const auto emit_lane = [this, operation, &algorithm_per_dim, dims_count](LaneBuilder& builder, int,
+                                                                             const double chunk_size) {
+        // buffer size each dimension works on: shrinks by npus_count after each ReduceScatter
+        auto size_per_dim = std::vector<double>(dims_count);
+        auto size = chunk_size;
+        for (auto dim = 0; dim < dims_count; dim++) {
+            size_per_dim[dim] = size;
+            size /= group_per_dim[dim].npus_count;
+        }
+
+        switch (operation) {
+        case CollectiveOperation::ReduceScatter:
+            for (auto dim = 0; dim < dims_count; dim++) {
+                emit_group(builder, group_per_dim[dim], operation, algorithm_per_dim[dim], size_per_dim[dim]);
+            }
+            break;
+        case CollectiveOperation::AllGather:
+            for (auto dim = dims_count - 1; dim >= 0; dim--) {
+                emit_group(builder, group_per_dim[dim], operation, algorithm_per_dim[dim], size_per_dim[dim]);
+            }
+            break;
+        case CollectiveOperation::AllReduce:
+            for (auto dim = 0; dim < dims_count; dim++) {
+                emit_group(builder, group_per_dim[dim], CollectiveOperation::ReduceScatter, algorithm_per_dim[dim],
+                           size_per_dim[dim]);
+            }
+            for (auto dim = dims_count - 1; dim >= 0; dim--) {
+                emit_group(builder, group_per_dim[dim], CollectiveOperation::AllGather, algorithm_per_dim[dim],
+                           size_per_dim[dim]);
+            }
+            break;
+        case CollectiveOperation::AllToAll:
+            // the whole buffer moves through every dimension
+            for (auto dim = 0; dim < dims_count; dim++) {
+                emit_group(builder, group_per_dim[dim], operation, algorithm_per_dim[dim], chunk_size);
+            }
+            break;
+        case CollectiveOperation::Broadcast:
+            collective_error("Broadcast is not supported");
+        }
+    };
+    return generate_lanes(1, emit_lane, collective_size);
+}
+
+template <typename EmitLane>
+CollectiveSchedule CollectiveGenerator::generate_lanes(const int lanes_per_chunk,
+                                                       const EmitLane& emit_lane,
+                                                       const ChunkSize collective_size) const noexcept {
+    assert(lanes_per_chunk > 0);
+
+    const auto npus_count = topology->get_npus_count();
+    const auto chunk_size = static_cast<double>(collective_size) / chunks_count;
+
+    // final frontiers of every lane emitted so far: chunk c starts from those of chunk (c - pipeline_depth)
+    auto schedule = CollectiveSchedule();
+    auto final_frontiers = std::vector<std::vector<std::vector<int>>>();
+    final_frontiers.reserve(chunks_count * lanes_per_chunk);
+
+    for (auto chunk = 0; chunk < chunks_count; chunk++) {
+        for (auto lane = 0; lane < lanes_per_chunk; lane++) {
+            auto frontiers = std::vector<std::vector<int>>(npus_count);
+            if (chunk >= pipeline_depth) {
+                frontiers = std::move(final_frontiers[((chunk - pipeline_depth) * lanes_per_chunk) + lane]);
+            }
+
+            auto builder = LaneBuilder(schedule, std::move(frontiers));
+            emit_lane(builder, lane, chunk_size);
+            final_frontiers.push_back(builder.finish());
+        }
+    }
+
+    return schedule;
+}
+
+void CollectiveGenerator::emit_group(LaneBuilder& builder,
+                                     const Group& group,
+                                     const CollectiveOperation operation,
+                                     const CollectiveAlgorithm algorithm,
+                                     const double collective_size) const noexcept {
+    const auto npus_count = group.npus_count;
+    if (npus_count <= 1) {
+        // nothing to communicate
+        return;
+    }
+    const auto shard_size = collective_size / npus_count;
+    const auto stride = group.stride;
+
+    // every member of every instance of the group sends bytes to the member peer_of(index) of its instance
+    const auto emit_step = [&builder, &group, npus_count, stride](const auto& peer_of, const double bytes) {
+        builder.step();
+        for (const auto base : group.bases) {
+            for (auto index = 0; index < npus_count; index++) {
+                builder.send(base + (index * stride), base + (peer_of(index) * stride), bytes);
+            }
+        }
+    };
+    const auto ring_peer = [npus_count](const int index) { return (index + 1) % npus_count; };
+
+    switch (algorithm) {
+    case CollectiveAlgorithm::Ring:
+        switch (operation) {
+        case CollectiveOperation::ReduceScatter:
+        case CollectiveOperation::AllGather:
+            for (auto step = 0; step < npus_count - 1; step++) {
+                emit_step(ring_peer, shard_size);
+            }
+            return;
+        case CollectiveOperation::AllReduce:
+            for (auto step = 0; step < 2 * (npus_count - 1); step++) {
+                emit_step(ring_peer, shard_size);
+            }
+            return;
+        case CollectiveOperation::AllToAll:
+            // step i relays the (n - i) shards not delivered yet
+            for (auto step = 1; step < npus_count; step++) {
+                emit_step(ring_peer, (npus_count - step) * shard_size);
+            }
+            return;
+        case CollectiveOperation::Broadcast:
+            break;
+        }
+        break;
+
+    case CollectiveAlgorithm::Direct: {
+        // every member sends a shard to every other member
+        const auto emit_direct_step = [&builder, &group, npus_count, stride, shard_size]() {
+            builder.step();
+            for (const auto base : group.bases) {
+                for (auto index = 0; index < npus_count; index++) {
+                    for (auto offset = 1; offset < npus_count; offset++) {
+                        const auto peer = (index + offset) % npus_count;
+                        builder.send(base + (index * stride), base + (peer * stride), shard_size);
+                    }
+                }
+            }
+        };
+
+        switch (operation) {
+        case CollectiveOperation::ReduceScatter:
+        case CollectiveOperation::AllGather:
+        case CollectiveOperation::AllToAll:
+            emit_direct_step();
+            return;
+        case CollectiveOperation::AllReduce:
+            emit_direct_step();
+            emit_direct_step();
+            return;
+        case CollectiveOperation::Broadcast:
+            break;
+        }
+        break;
+    }
+
+    case CollectiveAlgorithm::HalvingDoubling: {
+        const auto steps_count = ceil_log2(npus_count);
+
+        if (operation == CollectiveOperation::AllToAll) {
+            // Bruck: half of the buffer moves at every step
+            for (auto step = 0; step < steps_count; step++) {
+                const auto distance = 1 << step;
+                emit_step([npus_count, distance](const int index) { return (index + distance) % npus_count; },
+                          collective_size / 2);
+            }
+            return;
+        }
+        if (operation == CollectiveOperation::Broadcast) {
+            break;
+        }
+
+        if ((1 << steps_count) != npus_count) {
+            collective_error("HalvingDoubling needs a power-of-two group, got " + std::to_string(npus_count));
+        }
+
+        // recursive halving: the farthest peer first, exchanging half of the remaining buffer
+        if (operation != CollectiveOperation::AllGather) {
+            for (auto step = 0; step < steps_count; step++) {
+                const auto distance = 1 << (steps_count - 1 - step);
+                emit_step([distance](const int index) { return index ^ distance; }, collective_size / (2 << step));
+            }
+        }
+        // recursive doubling: the nearest peer first, exchanging everything gathered so far
+        if (operation != CollectiveOperation::ReduceScatter) {
+            for (auto step = 0; step < steps_count; step++) {
+                const auto distance = 1 << step;
+                emit_step([distance](const int index) { return index ^ distance; },
+                          collective_size / (1 << (steps_count - step)));
+            }
+        }
+        return;
+    }
+
+    case CollectiveAlgorithm::DoubleBinaryTree:
+        collective_error("DoubleBinaryTree cannot be used as a per-dimension algorithm");
+
+    case CollectiveAlgorithm::Hierarchical:
+        collective_error("Hierarchical cannot be used as a per-dimension algorithm");
+    }
+
+    // only Broadcast reaches here
+    collective_error("Broadcast is not supported");
+}
+
+void CollectiveGenerator::emit_tree(LaneBuilder& builder,
+                                    const Group& group,
+                                    const int tree,
+                                    const double tree_size) const noexcept {
+    assert(tree == 0 || tree == 1);
+
+    const auto npus_count = group.npus_count;
+    if (npus_count <= 1) {
+        // nothing to communicate
+        return;
+    }
+
+    // in-order binary tree over positions [1, npus_count]: position p has height trailing_zeros(p),
+    // and the root is the largest power of two within the range
+    const auto root = 1 << floor_log2(npus_count);
+    const auto parent_of = [](const int position) {
+        const auto height = trailing_zeros(position);
+        const auto is_left_child = ((position >> (height + 1)) & 1) == 0;
+        return is_left_child ? position + (1 << height) : position - (1 << height);
+    };
+
+    // the second tree shifts the members by one, so that the leaves of one tree are inner nodes of the other
+    const auto member_of = [npus_count, tree](const int position) { return (position - 1 + tree) % npus_count; };
+
+    // parent position of each position (0 for the root), skipping ancestors beyond npus_count
+    auto parents = std::vector<int>(npus_count + 1, 0);
+    for (auto position = 1; position <= npus_count; position++) {
+        if (position == root) {
+            continue;
+        }
+        auto parent = parent_of(position);
+        while (parent > npus_count) {
+            parent = parent_of(parent);
+        }
+        parents[position] = parent;
+    }
+
+    const auto stride = group.stride;
+    const auto root_height = trailing_zeros(root);
+    const auto emit_edges = [&](const int height, const bool upward) {
+        builder.step();
+        for (const auto base : group.bases) {
+            for (auto position = 1; position <= npus_count; position++) {
+                const auto parent = parents[position];
+                if (parent == 0) {
+                    continue;
+                }
+                const auto child_npu = base + (member_of(position) * stride);
+                const auto parent_npu = base + (member_of(parent) * stride);
+                if (upward && trailing_zeros(position) == height) {
+                    builder.send(child_npu, parent_npu, tree_size);
+                } else if (!upward && trailing_zeros(parent) == height) {
+                    builder.send(parent_npu, child_npu, tree_size);
+                }
+            }
+        }
+    };
+
+    // reduce: nodes of height h send to their parents at step h
+    for (auto height = 0; height < root_height; height++) {
+        emit_edges(height, true);
+    }
+    // broadcast: nodes of height h send to their children, from the root down
+    for (auto height = root_height; height > 0; height--) {
+        emit_edges(height, false);
+    }
+}
@@ -0,0 +1,193 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/DagExecutor.h"
+#include "congestion_aware/Chunk.h"
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+
+namespace {
+
+[[noreturn]] void dag_error(const std::string& message) noexcept {
+    std::cerr << "[Error] (network/analytical/congestion_aware/DagExecutor): " << message << std::endl;
+    std::exit(-1);
+}
+
+}  // namespace
+
+DagExecutor::DagExecutor(std::shared_ptr<Topology> topology,
+                         std::shared_ptr<EventQueue> event_queue,
+                         std::vector<DagNode> nodes,
+                         const std::vector<std::pair<int, int>>& edges) noexcept
+    : topology(std::move(topology)),
+      event_queue(std::move(event_queue)),
+      nodes(std::move(nodes)),
+      ready_queue_head(0),
+      ready_queue_tail(0),
+      completed_count(0) {
+    assert(this->topology != nullptr);
+    assert(this->event_queue != nullptr);
+
+    const auto nodes_count = static_cast<int>(this->nodes.size());
+    const auto npus_count = this->topology->get_npus_count();
+
+    // check the validity of the nodes
+    for (const auto& node : this->nodes) {
+        if (node.src < 0 || node.src >= npus_count || node.dest < 0 || node.dest >= npus_count) {
+            dag_error("NPU out of range");
+        }
+        if (node.src != node.dest && node.bytes == 0) {
+            dag_error("sends should have a positive size");
+        }
+    }
+
+    // count the successors and dependencies of each node
+    successor_offsets.assign(nodes_count + 1, 0);
+    pending_dependencies_count.assign(nodes_count, 0);
+    for (const auto& [predecessor, successor] : edges) {
+        if (predecessor < 0 || predecessor >= nodes_count || successor < 0 || successor >= nodes_count) {
+            dag_error("edge (" + std::to_string(predecessor) + ", " + std::to_string(successor) + ") out of range");
+        }
+        successor_offsets[predecessor + 1]++;
+        pending_dependencies_count[successor]++;
+    }
+
+    // compact the edges into CSR arrays
+    for (int node = 0; node < nodes_count; node++) {
+        successor_offsets[node + 1] += successor_offsets[node];
+    }
+    successors.resize(edges.size());
+    auto insert_positions = std::vector<int>(successor_offsets.begin(), successor_offsets.end() - 1);
+    for (const auto& [predecessor, successor] : edges) {
+        successors[insert_positions[predecessor]++] = successor;
+    }
+    check_acyclic();
+
+    // preallocate the runtime state
+    completion_times.assign(nodes_count, 0);
+    node_contexts.assign(nodes_count, this);
+    ready_queue.resize(nodes_count);
+}
+
+void DagExecutor::start() noexcept {
+    // release the sources of the DAG
+    for (int node = 0; node < static_cast<int>(nodes.size()); node++) {
+        if (pending_dependencies_count[node] == 0) {
+            release(node);
+        }
+    }
+    issue_ready_nodes();
+}
+
+bool DagExecutor::finished() const noexcept {
+    return completed_count == static_cast<int>(nodes.size());
+}
+
+int DagExecutor::get_completed_count() const noexcept {
+    return completed_count;
+}
+
+EventTime DagExecutor::get_completion_time(const int node) const noexcept {
+    assert(0 <= node && node < static_cast<int>(nodes.size()));
+
+    return completion_times[node];
+}
+
+void DagExecutor::node_ready(void* const node_context_ptr) noexcept {
+    const auto [executor, node] = decode(node_context_ptr);
+
+    executor->ready_queue[executor->ready_queue_tail++] = node;
+    executor->issue_ready_nodes();
+}
+
+void DagExecutor::node_completed(void* const node_context_ptr) noexcept {
+    const auto [executor, node] = decode(node_context_ptr);
+
+    executor->complete(node);
+    executor->issue_ready_nodes();
+}
+
+std::pair<DagExecutor*, int> DagExecutor::decode(void* const node_context_ptr) noexcept {
+    assert(node_context_ptr != nullptr);
+
+    auto* const node_context = static_cast<DagExecutor**>(node_context_ptr);
+    auto* const executor = *node_context;
+    const auto node = static_cast<int>(node_context - executor->node_contexts.data());
+    assert(0 <= node && node < static_cast<int>(executor->nodes.size()));
+
+    return {executor, node};
+}
+
+void DagExecutor::release(const int node) noexcept {
+    const auto delay = nodes[node].delay;
+    if (delay > 0) {
+        auto* const node_context_ptr = static_cast<void*>(&node_contexts[node]);
+        event_queue->schedule_event(event_queue->get_current_time() + delay, node_ready, node_context_ptr);
+        return;
+    }
+
+    ready_queue[ready_queue_tail++] = node;
+}
+
+void DagExecutor::complete(const int node) noexcept {
+    completion_times[node] = event_queue->get_current_time();
+    completed_count++;
+
+    // release the successors whose last dependency this was
+    for (auto i = successor_offsets[node]; i < successor_offsets[node + 1]; i++) {
+        const auto successor = successors[i];
+        assert(pending_dependencies_count[successor] > 0);
+        if (--pending_dependencies_count[successor] == 0) {
+            release(successor);
+        }
+    }
+}
+
+void DagExecutor::issue_ready_nodes() noexcept {
+    while (ready_queue_head < ready_queue_tail) {
+        const auto node = ready_queue[ready_queue_head++];
+        const auto& dag_node = nodes[node];
+
+        // local nodes complete right away, possibly releasing more nodes
+        if (dag_node.src == dag_node.dest) {
+            complete(node);
+            continue;
+        }
+
+        auto route = topology->route_chunk(dag_node.src, dag_node.dest, node);
+        auto* const node_context_ptr = static_cast<void*>(&node_contexts[node]);
+        topology->send(std::make_unique<Chunk>(dag_node.bytes, std::move(route), node_completed, node_context_ptr));
+    }
+}
+
+void DagExecutor::check_acyclic() const noexcept {
+    const auto nodes_count = static_cast<int>(nodes.size());
+
+    // Kahn's algorithm: repeatedly drop nodes without remaining dependencies
+    auto remaining_dependencies_count = pending_dependencies_count;
+    auto queue = std::vector<int>();
+    queue.reserve(nodes_count);
+    for (int node = 0; node < nodes_count; node++) {
+        if (remaining_dependencies_count[node] == 0) {
+            queue.push_back(node);
+        }
+    }
+    for (size_t head = 0; head < queue.size(); head++) {
+        const auto node = queue[head];
+        for (auto i = successor_offsets[node]; i < successor_offsets[node + 1]; i++) {
+            if (--remaining_dependencies_count[successors[i]] == 0) {
+                queue.push_back(successors[i]);
+            }
+        }
+    }
+
+    if (static_cast<int>(queue.size()) != nodes_count) {
+        dag_error("dependencies contain a cycle");
+    }
+}
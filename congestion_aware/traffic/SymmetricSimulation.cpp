@@ -0,0 +1,466 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/SymmetricSimulation.h"
+#include "congestion_aware/Link.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <map>
+#include <numeric>
+#include <set>
+#include <tuple>
+#include <unordered_set>
+#include <utility>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+
+namespace {
+
+/**
+ * Cyclic translations of the NPU addresses of a topology.
+ * A translation is identified by the NPU it moves NPU 0 to.
+ */
+class Translations {
+  public:
+    explicit Translations(std::vector<int> npus_count_per_dim) noexcept
+        : npus_count_per_dim(std::move(npus_count_per_dim)) {
+        // NPU stride of each dimension
+        auto stride = DeviceId{1};
+        for (const auto dim_npus_count : this->npus_count_per_dim) {
+            strides.push_back(stride);
+            stride *= dim_npus_count;
+        }
+    }
+
+    /// translations by one NPU along each dimension
+    [[nodiscard]] std::vector<DeviceId> generators() const noexcept {
+        auto generators = std::vector<DeviceId>();
+        for (size_t dim = 0; dim < npus_count_per_dim.size(); dim++) {
+            if (npus_count_per_dim[dim] > 1) {
+                generators.push_back(strides[dim]);
+            }
+        }
+        return generators;
+    }
+
+    /// translation moving npu to NPU 0
+    [[nodiscard]] DeviceId inverse(const DeviceId npu) const noexcept {
+        auto translation = DeviceId{0};
+        for (size_t dim = 0; dim < npus_count_per_dim.size(); dim++) {
+            const auto coordinate = (npu / strides[dim]) % npus_count_per_dim[dim];
+            translation += ((npus_count_per_dim[dim] - coordinate) % npus_count_per_dim[dim]) * strides[dim];
+        }
+        return translation;
+    }
+
+    /// translate an NPU
+    [[nodiscard]] DeviceId translate(const DeviceId npu, const DeviceId translation) const noexcept {
+        auto translated = DeviceId{0};
+        for (size_t dim = 0; dim < npus_count_per_dim.size(); dim++) {
+            const auto coordinate = ((npu / strides[dim]) % npus_count_per_dim[dim]) +
+                                    ((translation / strides[dim]) % npus_count_per_dim[dim]);
+            translated += (coordinate % npus_count_per_dim[dim]) * strides[dim];
+        }
+        return translated;
+    }
+
+  private:
+    /// number of NPUs per each dimension
+    std::vector<int> npus_count_per_dim;
+
+    /// NPU stride of each dimension
+    std::vector<DeviceId> strides;
+};
+
+/**
+ * Translations of every device of a topology.
+ * Switches are identified by the NPUs they link to,
+ * so a translated switch is the switch linking to the translated NPUs.
+ */
+class DeviceTranslations {
+  public:
+    DeviceTranslations(const Topology& topology, const Translations& translations) noexcept
+        : topology(topology),
+          translations(translations),
+          npus_count(topology.get_npus_count()),
+          valid(true) {
+        // devices linked to the NPUs (devices_count may overcount the instantiated switches)
+        auto switches = std::set<DeviceId>();
+        for (auto npu = 0; npu < npus_count; npu++) {
+            for (const auto& [dest, link] : topology.get_device(npu)->get_links()) {
+                if (dest >= npus_count) {
+                    switches.insert(dest);
+                }
+            }
+        }
+
+        for (const auto id : switches) {
+            auto neighbours = std::vector<DeviceId>();
+            for (const auto& [dest, link] : topology.get_device(id)->get_links()) {
+                neighbours.push_back(dest);
+            }
+            if (neighbours.empty() || neighbours.back() >= npus_count) {
+                // switches linking to other switches are not supported
+                valid = false;
+                return;
+            }
+            switch_of_neighbours.emplace(std::move(neighbours), id);
+        }
+
+        devices.resize(npus_count);
+        std::iota(devices.begin(), devices.end(), 0);
+        devices.insert(devices.end(), switches.begin(), switches.end());
+    }
+
+    /// every device linked to the NPUs, NPUs first
+    [[nodiscard]] const std::vector<DeviceId>& get_devices() const noexcept {
+        return devices;
+    }
+
+    /// whether every device can be translated
+    [[nodiscard]] bool is_valid() const noexcept {
+        return valid;
+    }
+
+    /// translate a device, -1 if the translated switch does not exist
+    [[nodiscard]] DeviceId translate(const DeviceId device, const DeviceId translation) const noexcept {
+        if (device < npus_count) {
+            return translations.translate(device, translation);
+        }
+
+        auto neighbours = std::vector<DeviceId>();
+        for (const auto& [dest, link] : topology.get_device(device)->get_links()) {
+            neighbours.push_back(translations.translate(dest, translation));
+        }
+        std::sort(neighbours.begin(), neighbours.end());
+
+        const auto it = switch_of_neighbours.find(neighbours);
+        return (it == switch_of_neighbours.end()) ? -1 : it->second;
+    }
+
+  private:
+    /// topology to translate
+    const Topology& topology;
+
+    /// translations of the NPUs
+    const Translations& translations;
+
+    /// number of NPUs in the topology
+    int npus_count;
+
+    /// switch linking to each (sorted) set of NPUs
+    std::map<std::vector<DeviceId>, DeviceId> switch_of_neighbours;
+
+    /// every device linked to the NPUs, NPUs first
+    std::vector<DeviceId> devices;
+
+    /// whether every device can be translated
+    bool valid;
+};
+
+/**
+ * Quotient network of a translation-invariant topology, as seen from NPU 0.
+ *
+ * Each orbit of links is a device (whose id is the orbit index) holding the link of the orbit,
+ * and a route is the sequence of orbits the route from NPU 0 crosses, followed by a sink device.
+ * A device links to every device that follows it in some route through the same link,
+ * so every send crossing an orbit queues on the same link.
+ *
+ * NPU IDs are those of the original topology, so schedules run unchanged;
+ * devices_count is raised to npus_count to keep them valid.
+ */
+class QuotientTopology final : public Topology {
+  public:
+    QuotientTopology(const Topology& topology,
+                     const std::vector<std::shared_ptr<Link>>& orbit_links,
+                     std::vector<std::vector<int>> orbits_per_offset) noexcept
+        : Topology(),
+          translations(topology.get_npus_count_per_dim()),
+          orbits_per_offset(std::move(orbits_per_offset)) {
+        npus_count = topology.get_npus_count();
+        dims_count = topology.get_dims_count();
+        npus_count_per_dim = topology.get_npus_count_per_dim();
+        bandwidth_per_dim = topology.get_bandwidth_per_dim();
+
+        // one device per orbit, followed by the sink
+        const auto orbits_count = static_cast<int>(orbit_links.size());
+        sink = orbits_count;
+        devices_count = std::max(npus_count, orbits_count + 1);
+        for (auto id = 0; id <= orbits_count; id++) {
+            devices.push_back(std::make_shared<Device>(id));
+        }
+
+        for (const auto& orbits : this->orbits_per_offset) {
+            for (size_t hop = 0; hop < orbits.size(); hop++) {
+                const auto next = (hop + 1 < orbits.size()) ? orbits[hop + 1] : sink;
+                devices[orbits[hop]]->connect(next, orbit_links[orbits[hop]]);
+            }
+        }
+    }
+
+    [[nodiscard]] Route route(const DeviceId src, const DeviceId dest) const noexcept override {
+        assert(0 <= src && src < npus_count);
+        assert(0 <= dest && dest < npus_count);
+
+        // translate the route to start from NPU 0
+        const auto offset = translations.translate(dest, translations.inverse(src));
+        const auto& orbits = orbits_per_offset[offset];
+        assert(!orbits.empty());
+
+        auto route = Route();
+        for (const auto orbit : orbits) {
+            route.push_back(devices[orbit]);
+        }
+        route.push_back(devices[sink]);
+        return route;
+    }
+
+  private:
+    /// translations of the original topology
+    Translations translations;
+
+    /// orbits crossed by the route from NPU 0 to each NPU (empty if no send takes it)
+    std::vector<std::vector<int>> orbits_per_offset;
+
+    /// device every route ends at
+    DeviceId sink;
+};
+
+/// union-find root of a node, with path halving
+int find_root(std::vector<int>& parents, int node) noexcept {
+    while (parents[node] != node) {
+        parents[node] = parents[parents[node]];
+        node = parents[node];
+    }
+    return node;
+}
+
+}  // namespace
+
+SymmetricSimulation::SymmetricSimulation(std::shared_ptr<Topology> topology,
+                                         std::shared_ptr<EventQueue> event_queue,
+                                         const CollectiveSchedule& schedule) noexcept {
+    assert(topology != nullptr);
+    assert(event_queue != nullptr);
+
+    auto simulated_schedule = CollectiveSchedule();
+    simulated_topology = reduce(*topology, schedule, simulated_schedule);
+
+    reduced = (simulated_topology != nullptr);
+    if (reduced) {
+        simulated_nodes_count = static_cast<int>(simulated_schedule.nodes.size());
+        dag_executor = std::make_unique<DagExecutor>(simulated_topology, std::move(event_queue),
+                                                     std::move(simulated_schedule.nodes), simulated_schedule.edges);
+        return;
+    }
+
+    // fall back to the whole schedule
+    simulated_topology = std::move(topology);
+    simulated_nodes_count = static_cast<int>(schedule.nodes.size());
+    simulated_node_of.resize(schedule.nodes.size());
+    std::iota(simulated_node_of.begin(), simulated_node_of.end(), 0);
+    dag_executor =
+        std::make_unique<DagExecutor>(simulated_topology, std::move(event_queue), schedule.nodes, schedule.edges);
+}
+
+void SymmetricSimulation::start() noexcept {
+    dag_executor->start();
+}
+
+bool SymmetricSimulation::finished() const noexcept {
+    return dag_executor->finished();
+}
+
+bool SymmetricSimulation::is_reduced() const noexcept {
+    return reduced;
+}
+
+int SymmetricSimulation::get_simulated_nodes_count() const noexcept {
+    return simulated_nodes_count;
+}
+
+EventTime SymmetricSimulation::get_completion_time(const int node) const noexcept {
+    assert(0 <= node && node < static_cast<int>(simulated_node_of.size()));
+
+    return dag_executor->get_completion_time(simulated_node_of[node]);
+}
+
+std::shared_ptr<Topology> SymmetricSimulation::reduce(const Topology& topology,
+                                                      const CollectiveSchedule& schedule,
+                                                      CollectiveSchedule& simulated_schedule) noexcept {
+    const auto npus_count = topology.get_npus_count();
+    const auto nodes_count = static_cast<int>(schedule.nodes.size());
+    if (npus_count <= 1 || nodes_count == 0 || nodes_count % npus_count != 0) {
+        return nullptr;
+    }
+
+    const auto translations = Translations(topology.get_npus_count_per_dim());
+    const auto device_translations = DeviceTranslations(topology, translations);
+    if (!device_translations.is_valid()) {
+        return nullptr;
+    }
+    const auto generators = translations.generators();
+
+    // (1) topology: every translated link exists, with the same bandwidth and latency
+    const auto& devices = device_translations.get_devices();
+    auto translated_devices = std::vector<DeviceId>(devices.back() + 1, -1);
+    for (const auto generator : generators) {
+        for (const auto device : devices) {
+            translated_devices[device] = device_translations.translate(device, generator);
+            if (translated_devices[device] < 0) {
+                return nullptr;
+            }
+        }
+
+        for (const auto src : devices) {
+            for (const auto& [dest, link] : topology.get_device(src)->get_links()) {
+                const auto translated_src = translated_devices[src];
+                const auto translated_dest = translated_devices[dest];
+
+                const auto& translated_links = topology.get_device(translated_src)->get_links();
+                const auto it = translated_links.find(translated_dest);
+                if (it == translated_links.end() || it->second->get_bandwidth() != link->get_bandwidth() ||
+                    it->second->get_latency() != link->get_latency()) {
+                    return nullptr;
+                }
+            }
+        }
+    }
+
+    // (2) schedule: identical sends are told apart by their occurrence order,
+    // and every translation maps the sends and dependencies onto themselves
+    using NodeKey = std::tuple<DeviceId, DeviceId, ChunkSize, EventTime>;
+    auto nodes_of_key = std::map<NodeKey, std::vector<int>>();
+    auto occurrences = std::vector<int>(nodes_count);
+    for (auto node = 0; node < nodes_count; node++) {
+        const auto& dag_node = schedule.nodes[node];
+        auto& nodes = nodes_of_key[{dag_node.src, dag_node.dest, dag_node.bytes, dag_node.delay}];
+        occurrences[node] = static_cast<int>(nodes.size());
+        nodes.push_back(node);
+    }
+
+    const auto edge_key = [](const int predecessor, const int successor) {
+        return (static_cast<uint64_t>(predecessor) << 32) | static_cast<uint32_t>(successor);
+    };
+    auto edges = std::unordered_set<uint64_t>();
+    edges.reserve(schedule.edges.size());
+    for (const auto& [predecessor, successor] : schedule.edges) {
+        edges.insert(edge_key(predecessor, successor));
+    }
+
+    // orbits of nodes are the connected components of the translations
+    auto parents = std::vector<int>(nodes_count);
+    std::iota(parents.begin(), parents.end(), 0);
+    auto translated_nodes = std::vector<int>(nodes_count);
+    for (const auto generator : generators) {
+        for (auto node = 0; node < nodes_count; node++) {
+            const auto& dag_node = schedule.nodes[node];
+            const auto key = NodeKey{translations.translate(dag_node.src, generator),
+                                     translations.translate(dag_node.dest, generator), dag_node.bytes,
+                                     dag_node.delay};
+            const auto it = nodes_of_key.find(key);
+            if (it == nodes_of_key.end() || static_cast<int>(it->second.size()) <= occurrences[node]) {
+                return nullptr;
+            }
+            translated_nodes[node] = it->second[occurrences[node]];
+            parents[find_root(parents, node)] = find_root(parents, translated_nodes[node]);
+        }
+
+        for (const auto& [predecessor, successor] : schedule.edges) {
+            if (edges.find(edge_key(translated_nodes[predecessor], translated_nodes[successor])) == edges.end()) {
+                return nullptr;
+            }
+        }
+    }
+
+    // every orbit is represented by its send from NPU 0
+    auto representative_of_root = std::vector<int>(nodes_count, -1);
+    for (auto node = 0; node < nodes_count; node++) {
+        if (schedule.nodes[node].src != 0) {
+            continue;
+        }
+        auto& representative = representative_of_root[find_root(parents, node)];
+        if (representative >= 0) {
+            return nullptr;
+        }
+        representative = static_cast<int>(simulated_schedule.nodes.size());
+        simulated_schedule.nodes.push_back(schedule.nodes[node]);
+    }
+    if (static_cast<int>(simulated_schedule.nodes.size()) * npus_count != nodes_count) {
+        return nullptr;
+    }
+
+    simulated_node_of.resize(nodes_count);
+    for (auto node = 0; node < nodes_count; node++) {
+        simulated_node_of[node] = representative_of_root[find_root(parents, node)];
+        assert(simulated_node_of[node] >= 0);
+    }
+
+    // a representative waits for the representatives of the translates it depends on
+    for (const auto& [predecessor, successor] : schedule.edges) {
+        if (schedule.nodes[successor].src == 0) {
+            simulated_schedule.edges.emplace_back(simulated_node_of[predecessor], simulated_node_of[successor]);
+        }
+    }
+    std::sort(simulated_schedule.edges.begin(), simulated_schedule.edges.end());
+    simulated_schedule.edges.erase(std::unique(simulated_schedule.edges.begin(), simulated_schedule.edges.end()),
+                                   simulated_schedule.edges.end());
+
+    // (3) routes from NPU 0: each hop is translated to its orbit representative,
+    // which starts or ends at NPU 0
+    auto orbit_of_link = std::map<std::pair<DeviceId, DeviceId>, int>();
+    auto orbit_links = std::vector<std::shared_ptr<Link>>();
+    auto orbits_per_offset = std::vector<std::vector<int>>(npus_count);
+    for (const auto& dag_node : simulated_schedule.nodes) {
+        const auto offset = dag_node.dest;
+        if (offset == 0 || !orbits_per_offset[offset].empty()) {
+            continue;
+        }
+
+        auto route = std::vector<DeviceId>();
+        for (const auto& device : topology.route(0, offset)) {
+            route.push_back(device->get_id());
+        }
+
+        // the route should translate along with its endpoints
+        for (const auto generator : generators) {
+            const auto translated_route = topology.route(generator, translations.translate(offset, generator));
+            if (translated_route.size() != route.size()) {
+                return nullptr;
+            }
+            auto hop = size_t{0};
+            for (const auto& device : translated_route) {
+                if (device->get_id() != device_translations.translate(route[hop++], generator)) {
+                    return nullptr;
+                }
+            }
+        }
+
+        for (size_t hop = 0; hop + 1 < route.size(); hop++) {
+            const auto src = route[hop];
+            const auto dest = route[hop + 1];
+            auto link = std::pair<DeviceId, DeviceId>();
+            if (src < npus_count) {
+                link = {0, device_translations.translate(dest, translations.inverse(src))};
+            } else if (dest < npus_count) {
+                link = {device_translations.translate(src, translations.inverse(dest)), 0};
+            } else {
+                return nullptr;
+            }
+
+            const auto [it, inserted] = orbit_of_link.emplace(link, static_cast<int>(orbit_links.size()));
+            if (inserted) {
+                const auto& representative_link = topology.get_device(link.first)->get_links().at(link.second);
+                orbit_links.push_back(
+                    std::make_shared<Link>(representative_link->get_bandwidth(), representative_link->get_latency()));
+            }
+            orbits_per_offset[offset].push_back(it->second);
+        }
+    }
+
+    return std::make_shared<QuotientTopology>(topology, orbit_links, std::move(orbits_per_offset));
+}
@@ -0,0 +1,165 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/TraceReader.h"
+#include <cassert>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+
+namespace {
+
+/// identifies a binary trace file
+constexpr char trace_magic[8] = {'A', 'N', 'A', 'T', 'R', 'A', 'C', 'E'};
+
+/// bump whenever the record layout changes
+constexpr uint32_t trace_version = 1;
+
+[[noreturn]] void trace_error(const std::string& path, const std::string& message) noexcept {
+    std::cerr << "[Error] (network/analytical/congestion_aware/TraceReader): "
+              << "trace " << path << ": " << message << std::endl;
+    std::exit(-1);
+}
+
+}  // namespace
+
+std::unique_ptr<TraceReader> TraceReader::open(const std::string& path) noexcept {
+    // pick the format from the extension
+    const auto binary_suffix = std::string(".bin");
+    const auto is_binary = path.size() >= binary_suffix.size() &&
+                           path.compare(path.size() - binary_suffix.size(), binary_suffix.size(), binary_suffix) == 0;
+
+    if (is_binary) {
+        return std::make_unique<BinaryTraceReader>(path);
+    }
+    return std::make_unique<CsvTraceReader>(path);
+}
+
+CsvTraceReader::CsvTraceReader(const std::string& path) noexcept : path(path), file(path), lines_count(0) {
+    if (!file) {
+        trace_error(path, "cannot open for reading");
+    }
+}
+
+bool CsvTraceReader::next(TraceRecord& record) noexcept {
+    while (std::getline(file, line)) {
+        lines_count++;
+
+        // skip empty lines and the header
+        if (line.empty() || line == "\r") {
+            continue;
+        }
+        if (lines_count == 1 && !(std::isdigit(static_cast<unsigned char>(line[0])) || line[0] == '-')) {
+            continue;
+        }
+
+        // issue_time,depends_on,src,dest,bytes
+        auto* cursor = line.c_str();
+        char* end = nullptr;
+        record.issue_time = std::strtoull(cursor, &end, 10);
+        auto valid = (end != cursor && *end == ',');
+        if (valid) {
+            cursor = end + 1;
+            record.depends_on = std::strtoll(cursor, &end, 10);
+            valid = (end != cursor && *end == ',');
+        }
+        if (valid) {
+            cursor = end + 1;
+            record.src = static_cast<DeviceId>(std::strtol(cursor, &end, 10));
+            valid = (end != cursor && *end == ',');
+        }
+        if (valid) {
+            cursor = end + 1;
+            record.dest = static_cast<DeviceId>(std::strtol(cursor, &end, 10));
+            valid = (end != cursor && *end == ',');
+        }
+        if (valid) {
+            cursor = end + 1;
+            record.bytes = std::strtoull(cursor, &end, 10);
+            valid = (end != cursor && (*end == '\0' || *end == '\r'));
+        }
+        if (!valid) {
+            trace_error(path, "malformed line " + std::to_string(lines_count) + ": " + line);
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+void BinaryTraceReader::write_binary_trace(const std::string& path, const std::vector<TraceRecord>& records) noexcept {
+    auto file = std::ofstream(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        trace_error(path, "cannot open for writing");
+    }
+
+    // header
+    file.write(trace_magic, sizeof(trace_magic));
+    file.write(reinterpret_cast<const char*>(&trace_version), sizeof(trace_version));
+
+    // records
+    for (const auto& record : records) {
+        const auto binary_record = BinaryRecord{record.issue_time, record.depends_on, record.src, record.dest,
+                                                record.bytes};
+        file.write(reinterpret_cast<const char*>(&binary_record), sizeof(binary_record));
+    }
+
+    if (!file) {
+        trace_error(path, "write failed");
+    }
+}
+
+BinaryTraceReader::BinaryTraceReader(const std::string& path, const size_t block_records_count) noexcept
+    : path(path),
+      file(path, std::ios::binary),
+      block(block_records_count),
+      block_size(0),
+      block_index(0) {
+    assert(block_records_count > 0);
+
+    if (!file) {
+        trace_error(path, "cannot open for reading");
+    }
+
+    // validate header
+    char magic[sizeof(trace_magic)];
+    auto version = uint32_t{0};
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(&version), sizeof(version));
+    if (!file || std::memcmp(magic, trace_magic, sizeof(trace_magic)) != 0) {
+        trace_error(path, "not a binary trace");
+    }
+    if (version != trace_version) {
+        trace_error(path, "unsupported version " + std::to_string(version) + " (expected " +
+                              std::to_string(trace_version) + ")");
+    }
+}
+
+bool BinaryTraceReader::next(TraceRecord& record) noexcept {
+    // read the next block
+    if (block_index == block_size) {
+        file.read(reinterpret_cast<char*>(block.data()),
+                  static_cast<std::streamsize>(block.size() * sizeof(BinaryRecord)));
+        const auto read_bytes = static_cast<size_t>(file.gcount());
+        if (read_bytes % sizeof(BinaryRecord) != 0) {
+            trace_error(path, "truncated record");
+        }
+        block_size = read_bytes / sizeof(BinaryRecord);
+        block_index = 0;
+        if (block_size == 0) {
+            return false;
+        }
+    }
+
+    const auto& binary_record = block[block_index++];
+    record = {binary_record.issue_time, binary_record.depends_on, binary_record.src, binary_record.dest,
+              binary_record.bytes};
+    return true;
+}
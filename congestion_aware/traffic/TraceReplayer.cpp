@@ -0,0 +1,203 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/TraceReplayer.h"
+#include "congestion_aware/Chunk.h"
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+
+namespace {
+
+[[noreturn]] void replay_error(const int64_t id, const std::string& message) noexcept {
+    std::cerr << "[Error] (network/analytical/congestion_aware/TraceReplayer): "
+              << "message " << id << ": " << message << std::endl;
+    std::exit(-1);
+}
+
+}  // namespace
+
+TraceReplayer::TraceReplayer(std::shared_ptr<Topology> topology,
+                             std::shared_ptr<EventQueue> event_queue,
+                             std::unique_ptr<TraceReader> trace_reader,
+                             const int window,
+                             const std::string& output_path) noexcept
+    : topology(std::move(topology)),
+      event_queue(std::move(event_queue)),
+      trace_reader(std::move(trace_reader)),
+      next_id(0),
+      trace_ended(false),
+      incomplete_count(0),
+      stats() {
+    assert(this->topology != nullptr);
+    assert(this->event_queue != nullptr);
+    assert(this->trace_reader != nullptr);
+    assert(window > 0);
+
+    // preallocate the message slots
+    message_slots.resize(window);
+    for (auto& message_slot : message_slots) {
+        message_slot.replayer = this;
+        message_slot.state = MessageState::Empty;
+    }
+
+    // open the per-message output
+    if (!output_path.empty()) {
+        output.open(output_path);
+        if (!output) {
+            std::cerr << "[Error] (network/analytical/congestion_aware/TraceReplayer): "
+                      << "cannot open " << output_path << " to write completions" << std::endl;
+            std::exit(-1);
+        }
+        output << "id,src,dest,bytes,issue_time,completion_time\n";
+    }
+}
+
+void TraceReplayer::start() noexcept {
+    read_messages();
+}
+
+bool TraceReplayer::finished() const noexcept {
+    return trace_ended && incomplete_count == 0;
+}
+
+const ReplayStats& TraceReplayer::get_stats() const noexcept {
+    return stats;
+}
+
+void TraceReplayer::message_due(void* const message_slot_ptr) noexcept {
+    assert(message_slot_ptr != nullptr);
+
+    auto& message_slot = *static_cast<MessageSlot*>(message_slot_ptr);
+    assert(message_slot.state == MessageState::Scheduled);
+
+    message_slot.replayer->issue(message_slot);
+}
+
+void TraceReplayer::message_completed(void* const message_slot_ptr) noexcept {
+    assert(message_slot_ptr != nullptr);
+
+    auto& message_slot = *static_cast<MessageSlot*>(message_slot_ptr);
+    auto* const replayer = message_slot.replayer;
+    assert(message_slot.state == MessageState::InFlight);
+
+    // account the completed message
+    const auto current_time = replayer->event_queue->get_current_time();
+    message_slot.state = MessageState::Completed;
+    message_slot.completion_time = current_time;
+    replayer->incomplete_count--;
+
+    auto& stats = replayer->stats;
+    stats.messages_count++;
+    stats.bytes += message_slot.record.bytes;
+    stats.finish_time = current_time;
+
+    if (replayer->output.is_open()) {
+        const auto& record = message_slot.record;
+        replayer->output << message_slot.id << "," << record.src << "," << record.dest << "," << record.bytes << ","
+                         << message_slot.issue_time << "," << current_time << "\n";
+    }
+
+    // release the messages waiting for this one
+    auto dependent = message_slot.first_dependent;
+    while (dependent >= 0) {
+        auto& dependent_slot = replayer->message_slots[dependent];
+        dependent = dependent_slot.next_dependent;
+        replayer->schedule_issue(dependent_slot, current_time + dependent_slot.record.issue_time);
+    }
+
+    // the slot may take the next message
+    replayer->read_messages();
+}
+
+void TraceReplayer::read_messages() noexcept {
+    const auto window = static_cast<int64_t>(message_slots.size());
+    const auto npus_count = topology->get_npus_count();
+
+    while (!trace_ended) {
+        // stop once the slot is still taken by an incomplete message
+        auto& message_slot = slot_of(next_id);
+        if (message_slot.state != MessageState::Empty && message_slot.state != MessageState::Completed) {
+            return;
+        }
+
+        auto record = TraceRecord();
+        if (!trace_reader->next(record)) {
+            trace_ended = true;
+            return;
+        }
+
+        // check the validity of the record
+        const auto id = next_id++;
+        if (record.src < 0 || record.src >= npus_count || record.dest < 0 || record.dest >= npus_count) {
+            replay_error(id, "NPU out of range");
+        }
+        if (record.src == record.dest || record.bytes == 0) {
+            replay_error(id, "src and dest should differ and bytes should be positive");
+        }
+        if (record.depends_on >= id || (record.depends_on >= 0 && id - record.depends_on >= window)) {
+            replay_error(id, "depends on message " + std::to_string(record.depends_on) +
+                                 ", which should be among the " + std::to_string(window - 1) + " previous messages");
+        }
+
+        message_slot = {this, id, record, MessageState::Waiting, 0, 0, -1, -1, -1};
+        incomplete_count++;
+
+        if (record.depends_on < 0) {
+            schedule_issue(message_slot, record.issue_time);
+            continue;
+        }
+
+        auto& dependency_slot = slot_of(record.depends_on);
+        assert(dependency_slot.id == record.depends_on);
+        if (dependency_slot.state == MessageState::Completed) {
+            schedule_issue(message_slot, dependency_slot.completion_time + record.issue_time);
+            continue;
+        }
+
+        // wait for the dependency, in trace order
+        const auto slot_index = static_cast<int>(id % window);
+        if (dependency_slot.first_dependent < 0) {
+            dependency_slot.first_dependent = slot_index;
+        } else {
+            message_slots[dependency_slot.last_dependent].next_dependent = slot_index;
+        }
+        dependency_slot.last_dependent = slot_index;
+    }
+}
+
+void TraceReplayer::schedule_issue(MessageSlot& message_slot, const EventTime issue_time) noexcept {
+    const auto current_time = event_queue->get_current_time();
+
+    if (issue_time > current_time) {
+        message_slot.state = MessageState::Scheduled;
+        event_queue->schedule_event(issue_time, message_due, &message_slot);
+        return;
+    }
+
+    // due already: the window held the message back
+    if (issue_time < current_time) {
+        stats.late_messages_count++;
+    }
+    issue(message_slot);
+}
+
+void TraceReplayer::issue(MessageSlot& message_slot) noexcept {
+    message_slot.state = MessageState::InFlight;
+    message_slot.issue_time = event_queue->get_current_time();
+
+    const auto& record = message_slot.record;
+    auto route = topology->route_chunk(record.src, record.dest, message_slot.id);
+    topology->send(std::make_unique<Chunk>(record.bytes, std::move(route), message_completed, &message_slot));
+}
+
+TraceReplayer::MessageSlot& TraceReplayer::slot_of(const int64_t id) noexcept {
+    assert(id >= 0);
+
+    return message_slots[id % static_cast<int64_t>(message_slots.size())];
+}
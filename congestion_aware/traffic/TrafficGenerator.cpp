@@ -0,0 +1,290 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/TrafficGenerator.h"
+#include "congestion_aware/Chunk.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+
+namespace {
+
+[[noreturn]] void traffic_error(const std::string& message) noexcept {
+    std::cerr << "[Error] (network/analytical/congestion_aware/TrafficGenerator): " << message << std::endl;
+    std::exit(-1);
+}
+
+}  // namespace
+
+double TrafficStats::mean_latency() const noexcept {
+    if (messages_count == 0) {
+        return 0.0;
+    }
+
+    return static_cast<double>(total_latency) / static_cast<double>(messages_count);
+}
+
+double TrafficStats::throughput() const noexcept {
+    if (finish_time == 0) {
+        return 0.0;
+    }
+
+    // B/ns to GB/s (1 GB = 2^30 B)
+    return static_cast<double>(bytes) / static_cast<double>(finish_time) * 1'000'000'000 / (1 << 30);
+}
+
+TrafficPattern TrafficGenerator::parse_traffic_pattern(const std::string& pattern_name) noexcept {
+    if (pattern_name == "UniformRandom") {
+        return TrafficPattern::UniformRandom;
+    }
+
+    if (pattern_name == "Permutation") {
+        return TrafficPattern::Permutation;
+    }
+
+    if (pattern_name == "Transpose") {
+        return TrafficPattern::Transpose;
+    }
+
+    if (pattern_name == "Hotspot") {
+        return TrafficPattern::Hotspot;
+    }
+
+    if (pattern_name == "AllToAll") {
+        return TrafficPattern::AllToAll;
+    }
+
+    if (pattern_name == "RingNeighbour") {
+        return TrafficPattern::RingNeighbour;
+    }
+
+    if (pattern_name == "BitComplement") {
+        return TrafficPattern::BitComplement;
+    }
+
+    // shouldn't reach here
+    traffic_error("traffic pattern " + pattern_name + " not supported");
+}
+
+TrafficGenerator::TrafficGenerator(std::shared_ptr<Topology> topology,
+                                   std::shared_ptr<EventQueue> event_queue,
+                                   const TrafficConfig& config) noexcept
+    : topology(std::move(topology)),
+      event_queue(std::move(event_queue)),
+      config(config),
+      grid_side(0),
+      random_engine(config.seed),
+      in_flight_count(0),
+      stats() {
+    assert(this->topology != nullptr);
+    assert(this->event_queue != nullptr);
+
+    npus_count = this->topology->get_npus_count();
+    messages_per_npu = config.messages_per_npu;
+    if (config.pattern == TrafficPattern::AllToAll && messages_per_npu == 0) {
+        messages_per_npu = npus_count - 1;
+    }
+
+    // check the validity of the settings
+    if (npus_count < 2) {
+        traffic_error("at least 2 NPUs are required");
+    }
+    if (config.message_size == 0 || messages_per_npu <= 0 || config.window <= 0) {
+        traffic_error("message_size, messages_per_npu, and window should be positive");
+    }
+    if (config.pattern == TrafficPattern::Transpose) {
+        grid_side = static_cast<int>(std::lround(std::sqrt(npus_count)));
+        if (grid_side * grid_side != npus_count) {
+            traffic_error("Transpose requires a square NPUs count, got " + std::to_string(npus_count));
+        }
+    }
+    if (config.pattern == TrafficPattern::BitComplement && (npus_count & (npus_count - 1)) != 0) {
+        traffic_error("BitComplement requires a power-of-2 NPUs count, got " + std::to_string(npus_count));
+    }
+    if (config.pattern == TrafficPattern::Hotspot) {
+        if (config.hotspot_npu < 0 || config.hotspot_npu >= npus_count) {
+            traffic_error("hotspot NPU " + std::to_string(config.hotspot_npu) + " out of range");
+        }
+        if (config.hotspot_fraction < 0.0 || config.hotspot_fraction > 1.0) {
+            traffic_error("hotspot fraction should be within [0, 1]");
+        }
+    }
+    if (config.pattern == TrafficPattern::Permutation) {
+        build_permutation();
+    }
+
+    // preallocate the per-NPU state and message slots
+    npu_states.resize(npus_count);
+    message_slots.resize(static_cast<size_t>(npus_count) * config.window);
+    for (int npu = 0; npu < npus_count; npu++) {
+        auto& npu_state = npu_states[npu];
+        npu_state = {this, npu, 0, 0, 0, false, {}};
+        npu_state.free_slots.reserve(config.window);
+        for (int i = config.window - 1; i >= 0; i--) {
+            npu_state.free_slots.push_back((npu * config.window) + i);
+        }
+    }
+}
+
+void TrafficGenerator::start() noexcept {
+    for (auto& npu_state : npu_states) {
+        inject(npu_state);
+    }
+}
+
+bool TrafficGenerator::finished() const noexcept {
+    if (in_flight_count > 0) {
+        return false;
+    }
+
+    return std::none_of(npu_states.begin(), npu_states.end(),
+                        [this](const NpuState& npu_state) { return has_messages_left(npu_state); });
+}
+
+const TrafficStats& TrafficGenerator::get_stats() const noexcept {
+    return stats;
+}
+
+void TrafficGenerator::message_arrived(void* const message_slot_ptr) noexcept {
+    assert(message_slot_ptr != nullptr);
+
+    auto* const message_slot = static_cast<MessageSlot*>(message_slot_ptr);
+    auto& npu_state = *message_slot->npu_state;
+    auto* const generator = npu_state.generator;
+
+    // account the delivered message
+    const auto current_time = generator->event_queue->get_current_time();
+    const auto latency = current_time - message_slot->injection_time;
+    auto& stats = generator->stats;
+    stats.messages_count++;
+    stats.bytes += generator->config.message_size;
+    stats.finish_time = current_time;
+    stats.total_latency += latency;
+    stats.max_latency = std::max(stats.max_latency, latency);
+
+    // free the slot, and inject the next message
+    npu_state.in_flight_count--;
+    generator->in_flight_count--;
+    npu_state.free_slots.push_back(message_slot->slot);
+    generator->inject(npu_state);
+}
+
+void TrafficGenerator::injection_ready(void* const npu_state_ptr) noexcept {
+    assert(npu_state_ptr != nullptr);
+
+    auto& npu_state = *static_cast<NpuState*>(npu_state_ptr);
+    npu_state.injection_scheduled = false;
+    npu_state.generator->inject(npu_state);
+}
+
+void TrafficGenerator::inject(NpuState& npu_state) noexcept {
+    while (has_messages_left(npu_state) && npu_state.in_flight_count < config.window) {
+        const auto current_time = event_queue->get_current_time();
+
+        // respect the injection interval
+        if (npu_state.injected_count > 0 && config.injection_interval > 0) {
+            const auto next_injection_time = npu_state.last_injection_time + config.injection_interval;
+            if (current_time < next_injection_time) {
+                if (!npu_state.injection_scheduled) {
+                    npu_state.injection_scheduled = true;
+                    event_queue->schedule_event(next_injection_time, injection_ready, &npu_state);
+                }
+                return;
+            }
+        }
+
+        // take a slot
+        assert(!npu_state.free_slots.empty());
+        const auto slot = npu_state.free_slots.back();
+        npu_state.free_slots.pop_back();
+        auto& message_slot = message_slots[slot];
+        message_slot = {&npu_state, slot, current_time};
+
+        // send the message
+        const auto src = npu_state.npu;
+        const auto dest = pick_destination(src, npu_state.injected_count);
+        const auto chunk_id = npu_state.injected_count;
+        assert(dest != src);
+        npu_state.injected_count++;
+        npu_state.in_flight_count++;
+        npu_state.last_injection_time = current_time;
+        in_flight_count++;
+        stats.max_in_flight = std::max(stats.max_in_flight, in_flight_count);
+
+        auto route = topology->route_chunk(src, dest, chunk_id);
+        topology->send(std::make_unique<Chunk>(config.message_size, std::move(route), message_arrived, &message_slot));
+    }
+}
+
+bool TrafficGenerator::has_messages_left(const NpuState& npu_state) const noexcept {
+    if (config.pattern == TrafficPattern::Transpose) {
+        // NPUs on the diagonal would send to themselves
+        const auto row = npu_state.npu / grid_side;
+        const auto col = npu_state.npu % grid_side;
+        if (row == col) {
+            return false;
+        }
+    }
+
+    return npu_state.injected_count < messages_per_npu;
+}
+
+DeviceId TrafficGenerator::pick_destination(const DeviceId src, const int message_index) noexcept {
+    assert(0 <= src && src < npus_count);
+
+    switch (config.pattern) {
+    case TrafficPattern::UniformRandom:
+        return random_destination(src);
+    case TrafficPattern::Permutation:
+        return permutation[src];
+    case TrafficPattern::Transpose:
+        return ((src % grid_side) * grid_side) + (src / grid_side);
+    case TrafficPattern::Hotspot: {
+        auto hotspot_distribution = std::bernoulli_distribution(config.hotspot_fraction);
+        if (src != config.hotspot_npu && hotspot_distribution(random_engine)) {
+            return config.hotspot_npu;
+        }
+        return random_destination(src);
+    }
+    case TrafficPattern::AllToAll: {
+        // every other NPU in ascending order, wrapping around for more messages
+        const auto peer = message_index % (npus_count - 1);
+        return (peer < src) ? peer : peer + 1;
+    }
+    case TrafficPattern::RingNeighbour:
+        return (src + 1) % npus_count;
+    case TrafficPattern::BitComplement:
+        return ~src & (npus_count - 1);
+    default:
+        // shouldn't reach here
+        traffic_error("traffic pattern not supported");
+    }
+}
+
+DeviceId TrafficGenerator::random_destination(const DeviceId src) noexcept {
+    // draw among the other NPUs, skipping src
+    auto distribution = std::uniform_int_distribution<DeviceId>(0, npus_count - 2);
+    const auto dest = distribution(random_engine);
+    return (dest < src) ? dest : dest + 1;
+}
+
+void TrafficGenerator::build_permutation() noexcept {
+    permutation.resize(npus_count);
+    std::iota(permutation.begin(), permutation.end(), 0);
+    std::shuffle(permutation.begin(), permutation.end(), random_engine);
+
+    // break fixed points by swapping with the next NPU's destination
+    for (int npu = 0; npu < npus_count; npu++) {
+        if (permutation[npu] == npu) {
+            std::swap(permutation[npu], permutation[(npu + 1) % npus_count]);
+        }
+    }
+}
@@ -0,0 +1,108 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/EventQueue.h"
+#include "common/NetworkParser.h"
+#include "common/OptionParser.h"
+#include "congestion_aware/Helper.h"
+#include "congestion_aware/TrafficGenerator.h"
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+
+namespace {
+
+void print_usage(const char* const program) {
+    std::cerr << "Usage: " << program << " <network.yml> <pattern> [options]" << std::endl
+              << "  pattern: UniformRandom, Permutation, Transpose, Hotspot, AllToAll, RingNeighbour, BitComplement"
+              << std::endl
+              << "  --message-size <bytes>     size of each message (default: 1048576)" << std::endl
+              << "  --messages <count>         messages per NPU (default: 1, AllToAll: npus_count - 1)" << std::endl
+              << "  --window <count>           messages in flight per NPU (default: 1)" << std::endl
+              << "  --interval <ns>            minimum gap between injections of an NPU (default: 0)" << std::endl
+              << "  --hotspot-npu <id>         hotspot NPU (default: 0)" << std::endl
+              << "  --hotspot-fraction <p>     probability of targeting the hotspot (default: 0.5)" << std::endl
+              << "  --seed <seed>              seed of the random patterns (default: 0)" << std::endl
+              << "  --hybrid                   enable hybrid simulation" << std::endl;
+}
+
+}  // namespace
+
+int main(const int argc, const char* const argv[]) {
+    if (argc < 3) {
+        print_usage(argv[0]);
+        return -1;
+    }
+
+    // parse arguments
+    const auto network_config_path = std::string(argv[1]);
+    auto config = TrafficConfig();
+    config.pattern = TrafficGenerator::parse_traffic_pattern(argv[2]);
+    config.messages_per_npu = (config.pattern == TrafficPattern::AllToAll) ? 0 : 1;
+    auto hybrid_mode = false;
+
+    for (int i = 3; i < argc; i++) {
+        const auto option = std::string(argv[i]);
+        if (option == "--hybrid") {
+            hybrid_mode = true;
+            continue;
+        }
+        if (i + 1 == argc) {
+            print_usage(argv[0]);
+            return -1;
+        }
+
+        const auto value = std::string(argv[++i]);
+        if (option == "--message-size") {
+            parse_number(argv[0], option, value, config.message_size, print_usage);
+        } else if (option == "--messages") {
+            parse_number(argv[0], option, value, config.messages_per_npu, print_usage);
+        } else if (option == "--window") {
+            parse_number(argv[0], option, value, config.window, print_usage);
+        } else if (option == "--interval") {
+            parse_number(argv[0], option, value, config.injection_interval, print_usage);
+        } else if (option == "--hotspot-npu") {
+            parse_number(argv[0], option, value, config.hotspot_npu, print_usage);
+        } else if (option == "--hotspot-fraction") {
+            parse_number(argv[0], option, value, config.hotspot_fraction, print_usage);
+        } else if (option == "--seed") {
+            parse_number(argv[0], option, value, config.seed, print_usage);
+        } else {
+            print_usage(argv[0]);
+            return -1;
+        }
+    }
+
+    // Instantiate shared resources
+    const auto event_queue = std::make_shared<EventQueue>();
+    Topology::set_event_queue(event_queue);
+
+    // Parse network config and create topology
+    const auto network_parser = NetworkParser(network_config_path);
+    const auto topology = construct_topology(network_parser);
+    topology->set_hybrid_mode(hybrid_mode);
+
+    // Run the traffic
+    auto traffic_generator = TrafficGenerator(topology, event_queue, config);
+    traffic_generator.start();
+    while (!event_queue->finished()) {
+        event_queue->proceed();
+    }
+
+    // Print simulation result
+    const auto& stats = traffic_generator.get_stats();
+    std::cout << "Total NPUs Count: " << topology->get_npus_count() << std::endl;
+    std::cout << "Messages delivered: " << stats.messages_count << std::endl;
+    std::cout << "Bytes delivered: " << stats.bytes << std::endl;
+    std::cout << "Simulation finished at time: " << stats.finish_time << " ns" << std::endl;
+    std::cout << "Throughput: " << stats.throughput() << " GB/s" << std::endl;
+    std::cout << "Mean message latency: " << stats.mean_latency() << " ns" << std::endl;
+    std::cout << "Max message latency: " << stats.max_latency << " ns" << std::endl;
+
+    return 0;
+}
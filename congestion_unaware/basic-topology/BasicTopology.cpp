@@ -5,7 +5,9 @@ LICENSE file in the root directory of this source tree.
 
 #include "congestion_unaware/BasicTopology.h"
 #include "common/NetworkFunction.h"
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
 
 using namespace NetworkAnalytical;
 using namespace NetworkAnalyticalCongestionUnaware;
@@ -13,6 +15,9 @@ using namespace NetworkAnalyticalCongestionUnaware;
 BasicTopology::BasicTopology(const int npus_count, const Bandwidth bandwidth, const Latency latency) noexcept
     : latency(latency),
       basic_topology_type(TopologyBuildingBlock::Undefined),
+      congestion_model(CongestionModel::None),
+      replicas_count(1),
+      capacity_Bpns(0.0),
       Topology() {
     assert(npus_count > 0);
     assert(bandwidth > 0);
@@ -45,16 +50,133 @@ EventTime BasicTopology::send(const DeviceId src, const DeviceId dest, const Chu
     return compute_communication_delay(hops_count, chunk_size);
 }
 
-EventTime BasicTopology::compute_communication_delay(const int hops_count, const ChunkSize chunk_size) const noexcept {
+void BasicTopology::send_batch(const DeviceId* const src,
+                               const DeviceId* const dest,
+                               const ChunkSize* const chunk_size,
+                               EventTime* const comms_delay,
+                               const size_t count) const noexcept {
+    int hops_count[batch_block_size];
+
+    for (size_t block_start = 0; block_start < count; block_start += batch_block_size) {
+        const auto block_count = std::min(batch_block_size, count - block_start);
+
+        // hops count of the block
+        compute_hops_count_batch(src + block_start, dest + block_start, hops_count, block_count);
+
+        // communication delay of the block, same arithmetic as compute_communication_delay;
+        // sizes and delays stay below 2^63, so converting through int64_t gives the same values
+        // with the cheaper signed conversions
+        const auto* const block_chunk_size = chunk_size + block_start;
+        auto* const block_comms_delay = comms_delay + block_start;
+        for (size_t i = 0; i < block_count; i++) {
+            assert(hops_count[i] > 0);
+            assert(0 < block_chunk_size[i] && block_chunk_size[i] <= INT64_MAX);
+
+            const auto link_delay = hops_count[i] * latency;
+            const auto chunk_size_B = static_cast<double>(static_cast<int64_t>(block_chunk_size[i]));
+            const auto serialization_delay = chunk_size_B / bandwidth_Bpns;
+            block_comms_delay[i] = static_cast<EventTime>(static_cast<int64_t>(link_delay + serialization_delay));
+        }
+    }
+}
+
+void BasicTopology::compute_hops_count_batch(const DeviceId* const src,
+                                             const DeviceId* const dest,
+                                             int* const hops_count,
+                                             const size_t count) const noexcept {
+    for (size_t i = 0; i < count; i++) {
+        hops_count[i] = compute_hops_count(src[i], dest[i]);
+    }
+}
+
+EventTime BasicTopology::send_at(const DeviceId src,
+                                 const DeviceId dest,
+                                 const ChunkSize chunk_size,
+                                 const EventTime send_time) noexcept {
+    assert(0 <= src && src < npus_count);
+    assert(0 <= dest && dest < npus_count);
+    assert(src != dest);
+    assert(chunk_size > 0);
+
+    // get hops count
+    const auto hops_count = compute_hops_count(src, dest);
+
+    // return communication delay, with the queueing term of the recent load
+    const auto queueing_delay = compute_queueing_delay(hops_count, chunk_size, send_time);
+    return compute_communication_delay(hops_count, chunk_size, queueing_delay);
+}
+
+void BasicTopology::enable_congestion_estimation(const CongestionModel congestion_model,
+                                                 const EventTime window) noexcept {
+    assert(window > 0);
+
+    this->congestion_model = congestion_model;
+    load_window.emplace(window);
+    capacity_Bpns = bandwidth_Bpns * get_links_count() * replicas_count;
+}
+
+void BasicTopology::set_replicas_count(const int replicas_count) noexcept {
+    assert(replicas_count > 0);
+
+    this->replicas_count = replicas_count;
+    capacity_Bpns = bandwidth_Bpns * get_links_count() * replicas_count;
+}
+
+double BasicTopology::estimate_queueing_delay(const DeviceId src,
+                                              const DeviceId dest,
+                                              const ChunkSize chunk_size,
+                                              const EventTime send_time) noexcept {
+    assert(0 <= src && src < npus_count);
+    assert(0 <= dest && dest < npus_count);
+    assert(src != dest);
+    assert(chunk_size > 0);
+
+    return compute_queueing_delay(compute_hops_count(src, dest), chunk_size, send_time);
+}
+
+double BasicTopology::compute_queueing_delay(const int hops_count,
+                                             const ChunkSize chunk_size,
+                                             const EventTime send_time) noexcept {
+    if (congestion_model == CongestionModel::None) {
+        return 0.0;
+    }
+    assert(load_window.has_value());
+
+    // utilization of the links by the load offered before this chunk
+    const auto window = static_cast<double>(load_window->get_window());
+    const auto offered_bytes = load_window->get_bytes(send_time);
+    const auto utilization = std::min(offered_bytes / (capacity_Bpns * window), max_utilization);
+
+    // the chunk occupies every link on its path
+    load_window->add(send_time, static_cast<double>(chunk_size) * hops_count);
+
+    // deterministic service: serialization time of the chunk
+    const auto service_time = static_cast<double>(chunk_size) / bandwidth_Bpns;
+    switch (congestion_model) {
+    case CongestionModel::MD1:
+        // Pollaczek-Khinchine with deterministic service, at every hop
+        return hops_count * service_time * utilization / (2 * (1 - utilization));
+    case CongestionModel::BandwidthShare:
+        // serialization at bandwidth * (1 - utilization)
+        return service_time * utilization / (1 - utilization);
+    default:
+        return 0.0;
+    }
+}
+
+EventTime BasicTopology::compute_communication_delay(const int hops_count,
+                                                     const ChunkSize chunk_size,
+                                                     const double queueing_delay) const noexcept {
     assert(hops_count > 0);
     assert(chunk_size > 0);
+    assert(queueing_delay >= 0);
 
     // compute link delay and serialization delay
     auto link_delay = hops_count * latency;
     auto serialization_delay = static_cast<double>(chunk_size) / bandwidth_Bpns;
 
-    // comms_delay is the summation of the two
-    auto comms_delay = link_delay + serialization_delay;
+    // comms_delay is the summation of the two, plus queueing when congestion is estimated
+    auto comms_delay = link_delay + serialization_delay + queueing_delay;
 
     // return EventTime type of comms_delay
     return static_cast<EventTime>(comms_delay);
@@ -65,3 +187,12 @@ TopologyBuildingBlock BasicTopology::get_basic_topology_type() const noexcept {
 
     return basic_topology_type;
 }
+
+double BasicTopology::compute_path_latency(const DeviceId src, const DeviceId dest) const noexcept {
+    assert(0 <= src && src < npus_count);
+    assert(0 <= dest && dest < npus_count);
+    assert(src != dest);
+
+    // same link delay as compute_communication_delay
+    return compute_hops_count(src, dest) * latency;
+}
@@ -0,0 +1,49 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_unaware/Dragonfly.h"
+#include <cassert>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionUnaware;
+
+Dragonfly::Dragonfly(const int groups,
+                     const int routers_per_group,
+                     const int global_links_per_router,
+                     const int npus_per_router,
+                     const DragonflyArrangement arrangement,
+                     const DragonflyRouting routing,
+                     const Bandwidth bandwidth,
+                     const Latency latency) noexcept
+    : BasicTopology(groups * routers_per_group * npus_per_router, bandwidth, latency),
+      layout(groups, routers_per_group, global_links_per_router, npus_per_router, arrangement),
+      routing(routing),
+      global_links_per_router(global_links_per_router),
+      routers_per_group(routers_per_group) {
+    assert(bandwidth > 0);
+    assert(latency >= 0);
+
+    // set the building block type
+    basic_topology_type = TopologyBuildingBlock::Dragonfly;
+}
+
+int Dragonfly::compute_hops_count(const DeviceId src, const DeviceId dest) const noexcept {
+    assert(0 <= src && src < npus_count);
+    assert(0 <= dest && dest < npus_count);
+    assert(src != dest);
+
+    // one hop less than the devices on the route
+    DeviceId route[DragonflyLayout::max_route_length];
+    const auto hash = DragonflyLayout::hash(src, dest, 0);
+    const auto length = (routing == DragonflyRouting::Valiant) ? layout.valiant_route(src, dest, hash, route)
+                                                               : layout.minimal_route(src, dest, hash, route);
+    return length - 1;
+}
+
+int Dragonfly::get_links_count() const noexcept {
+    // npu-router links in both directions, local links within groups, and one global link per global port
+    const auto routers_count = layout.get_routers_count();
+    return (2 * npus_count) + (routers_count * (routers_per_group - 1)) + (routers_count * global_links_per_router);
+}
@@ -0,0 +1,82 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_unaware/FatTree.h"
+#include <cassert>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionUnaware;
+
+namespace {
+
+/// uplinks per leaf switch (none for a single-tier fat-tree)
+int get_leaf_uplinks_count(const int radix, const int tiers, const int oversubscription) noexcept {
+    return (tiers == 1) ? 0 : radix / (oversubscription + 1);
+}
+
+/// number of NPUs: NPUs per leaf times arity^(tiers - 1) leaves
+int get_fat_tree_npus_count(const int radix, const int tiers, const int oversubscription) noexcept {
+    auto npus_count = radix - get_leaf_uplinks_count(radix, tiers, oversubscription);
+    for (auto tier = 1; tier < tiers; tier++) {
+        npus_count *= radix / 2;
+    }
+    return npus_count;
+}
+
+}  // namespace
+
+FatTree::FatTree(const int radix,
+                 const int tiers,
+                 const int oversubscription,
+                 const Bandwidth bandwidth,
+                 const Latency latency) noexcept
+    : BasicTopology(get_fat_tree_npus_count(radix, tiers, oversubscription), bandwidth, latency),
+      tiers(tiers),
+      arity(radix / 2),
+      leaf_npus_count(radix - get_leaf_uplinks_count(radix, tiers, oversubscription)),
+      leaf_uplinks_count(get_leaf_uplinks_count(radix, tiers, oversubscription)) {
+    assert(radix >= 2 && radix % 2 == 0);
+    assert(tiers >= 1);
+    assert(oversubscription >= 1);
+    assert(tiers == 1 || radix % (oversubscription + 1) == 0);
+    assert(bandwidth > 0);
+    assert(latency >= 0);
+
+    // set the building block type
+    basic_topology_type = TopologyBuildingBlock::FatTree;
+}
+
+int FatTree::compute_hops_count(const DeviceId src, const DeviceId dest) const noexcept {
+    assert(0 <= src && src < npus_count);
+    assert(0 <= dest && dest < npus_count);
+    assert(src != dest);
+
+    // src -> leaf -> dest
+    auto src_leaf = src / leaf_npus_count;
+    auto dest_leaf = dest / leaf_npus_count;
+    if (src_leaf == dest_leaf) {
+        return 2;
+    }
+
+    // the turn is one tier above the highest digit where the leaves differ
+    auto top_tier = 0;
+    while (src_leaf != dest_leaf) {
+        src_leaf /= arity;
+        dest_leaf /= arity;
+        top_tier++;
+    }
+
+    // npu and leaf links on both ends, and top_tier hops up and down
+    return 2 * (top_tier + 1);
+}
+
+int FatTree::get_links_count() const noexcept {
+    // every pair of adjacent tiers has leaf_uplinks_count links per leaf
+    const auto leaves_count = npus_count / leaf_npus_count;
+    const auto switch_links_count = (tiers - 1) * leaf_uplinks_count * leaves_count;
+
+    // npu-leaf and switch-switch links, both directions
+    return 2 * (npus_count + switch_links_count);
+}
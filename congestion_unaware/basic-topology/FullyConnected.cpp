@@ -4,6 +4,7 @@ LICENSE file in the root directory of this source tree.
 *******************************************************************************/
 
 #include "congestion_unaware/FullyConnected.h"
+#include <algorithm>
 #include <cassert>
 
 using namespace NetworkAnalytical;
@@ -27,3 +28,16 @@ int FullyConnected::compute_hops_count(const DeviceId src, const DeviceId dest)
     // for FullyConnected, hops_count is always 1 (src -> dest)
     return 1;
 }
+
+void FullyConnected::compute_hops_count_batch(const DeviceId* const src,
+                                              const DeviceId* const dest,
+                                              int* const hops_count,
+                                              const size_t count) const noexcept {
+    // src -> dest for every pair
+    std::fill(hops_count, hops_count + count, 1);
+}
+
+int FullyConnected::get_links_count() const noexcept {
+    // one link per ordered pair
+    return npus_count * (npus_count - 1);
+}
@@ -6,6 +6,7 @@ LICENSE file in the root directory of this source tree.
 #include "congestion_unaware/HyperCube.h"
 #include <bitset>
 #include <cassert>
+#include <cstdint>
 
 using namespace NetworkAnalytical;
 using namespace NetworkAnalyticalCongestionUnaware;
@@ -42,3 +43,26 @@ int HyperCube::compute_hops_count(const DeviceId src, const DeviceId dest) const
 
     return hops;
 }
+
+void HyperCube::compute_hops_count_batch(const DeviceId* const src,
+                                         const DeviceId* const dest,
+                                         int* const hops_count,
+                                         const size_t count) const noexcept {
+    // Hamming distance with a branchless (SWAR) popcount
+    for (size_t i = 0; i < count; i++) {
+        auto diff = static_cast<uint32_t>(src[i] ^ dest[i]);
+        diff = diff - ((diff >> 1) & 0x55555555U);
+        diff = (diff & 0x33333333U) + ((diff >> 2) & 0x33333333U);
+        diff = (diff + (diff >> 4)) & 0x0F0F0F0FU;
+        hops_count[i] = static_cast<int>((diff * 0x01010101U) >> 24);
+    }
+}
+
+int HyperCube::get_links_count() const noexcept {
+    // one link per NPU per bit
+    auto log_npus_count = 0;
+    while ((1 << log_npus_count) < npus_count) {
+        log_npus_count++;
+    }
+    return npus_count * log_npus_count;
+}
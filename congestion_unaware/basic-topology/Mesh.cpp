@@ -28,3 +28,20 @@ int Mesh::compute_hops_count(const DeviceId src, const DeviceId dest) const noex
     // bidirectional: return shorter distance
     return (src < dest) ? dest - src : src - dest;
 }
+
+void Mesh::compute_hops_count_batch(const DeviceId* const src,
+                                    const DeviceId* const dest,
+                                    int* const hops_count,
+                                    const size_t count) const noexcept {
+    // branchless absolute difference
+    for (size_t i = 0; i < count; i++) {
+        const auto difference = dest[i] - src[i];
+        const auto sign = difference >> 31;
+        hops_count[i] = (difference ^ sign) - sign;
+    }
+}
+
+int Mesh::get_links_count() const noexcept {
+    // one link per direction between neighbours, no wrap-around
+    return bidirectional ? (2 * (npus_count - 1)) : (npus_count - 1);
+}
@@ -4,6 +4,7 @@ LICENSE file in the root directory of this source tree.
 *******************************************************************************/
 
 #include "congestion_unaware/Ring.h"
+#include <algorithm>
 #include <cassert>
 
 using namespace NetworkAnalytical;
@@ -47,3 +48,30 @@ int Ring::compute_hops_count(const DeviceId src, const DeviceId dest) const noex
     // bidirectional: return shorter distance
     return (clockwise_distance < anticlockwise_distance) ? clockwise_distance : anticlockwise_distance;
 }
+
+void Ring::compute_hops_count_batch(const DeviceId* const src,
+                                    const DeviceId* const dest,
+                                    int* const hops_count,
+                                    const size_t count) const noexcept {
+    // branchless clockwise distance: wrap negative differences around the ring
+    if (!bidirectional) {
+        for (size_t i = 0; i < count; i++) {
+            const auto difference = dest[i] - src[i];
+            hops_count[i] = difference + (npus_count & -(difference < 0));
+        }
+        return;
+    }
+
+    // bidirectional: shorter of clockwise and anticlockwise distance
+    for (size_t i = 0; i < count; i++) {
+        const auto difference = dest[i] - src[i];
+        const auto clockwise_distance = difference + (npus_count & -(difference < 0));
+        const auto anticlockwise_distance = npus_count - clockwise_distance;
+        hops_count[i] = std::min(clockwise_distance, anticlockwise_distance);
+    }
+}
+
+int Ring::get_links_count() const noexcept {
+    // one link per direction between neighbours
+    return bidirectional ? (2 * npus_count) : npus_count;
+}
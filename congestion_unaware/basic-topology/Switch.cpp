@@ -4,6 +4,7 @@ LICENSE file in the root directory of this source tree.
 *******************************************************************************/
 
 #include "congestion_unaware/Switch.h"
+#include <algorithm>
 #include <cassert>
 
 using namespace NetworkAnalytical;
@@ -27,3 +28,16 @@ int Switch::compute_hops_count(const DeviceId src, const DeviceId dest) const no
     // for switch, hops_count is always 2 (src -> switch -> dest)
     return 2;
 }
+
+void Switch::compute_hops_count_batch(const DeviceId* const src,
+                                      const DeviceId* const dest,
+                                      int* const hops_count,
+                                      const size_t count) const noexcept {
+    // src -> switch -> dest for every pair
+    std::fill(hops_count, hops_count + count, 2);
+}
+
+int Switch::get_links_count() const noexcept {
+    // uplink and downlink per NPU
+    return 2 * npus_count;
+}
@@ -0,0 +1,104 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_unaware/TorusND.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionUnaware;
+
+namespace {
+
+/// product of the axis sizes
+int get_shape_npus_count(const std::vector<int>& shape) noexcept {
+    auto npus_count = 1;
+    for (const auto axis_npus_count : shape) {
+        npus_count *= axis_npus_count;
+    }
+    return npus_count;
+}
+
+}  // namespace
+
+TorusND::TorusND(const std::vector<int>& shape,
+                 const Bandwidth bandwidth,
+                 const Latency latency,
+                 const std::vector<bool>& wraparound,
+                 const bool bidirectional) noexcept
+    : BasicTopology(get_shape_npus_count(shape), bandwidth, latency),
+      shape(shape),
+      wraparound(wraparound),
+      bidirectional(bidirectional) {
+    assert(!shape.empty());
+    assert(shape.size() == wraparound.size());
+    assert(bandwidth > 0);
+    assert(latency >= 0);
+
+    auto wraps_every_axis = true;
+    auto stride = DeviceId{1};
+    for (size_t axis = 0; axis < shape.size(); axis++) {
+        assert(shape[axis] > 0);
+        if (!bidirectional && !wraparound[axis] && shape[axis] > 1) {
+            // unidirectional links can't route back along an axis that doesn't wrap around
+            std::cerr << "[Error] (network/analytical/congestion_unaware/TorusND): "
+                      << "axis " << axis << " doesn't wrap around, which unidirectional links do not support"
+                      << std::endl;
+            std::exit(-1);
+        }
+        strides.push_back(stride);
+        stride *= shape[axis];
+        wraps_every_axis = wraps_every_axis && wraparound[axis];
+    }
+
+    // set the building block type
+    basic_topology_type = wraps_every_axis ? TopologyBuildingBlock::TorusND : TopologyBuildingBlock::MeshND;
+}
+
+int TorusND::compute_hops_count(const DeviceId src, const DeviceId dest) const noexcept {
+    assert(0 <= src && src < npus_count);
+    assert(0 <= dest && dest < npus_count);
+    assert(src != dest);
+
+    // sum of the distances along every axis
+    auto hops_count = 0;
+    for (size_t axis = 0; axis < shape.size(); axis++) {
+        const auto axis_npus_count = shape[axis];
+        const auto src_coordinate = (src / strides[axis]) % axis_npus_count;
+        const auto dest_coordinate = (dest / strides[axis]) % axis_npus_count;
+
+        if (wraparound[axis]) {
+            // forward distance, or the shorter one if bidirectional
+            const auto forward = (dest_coordinate - src_coordinate + axis_npus_count) % axis_npus_count;
+            hops_count += bidirectional ? std::min(forward, axis_npus_count - forward) : forward;
+        } else {
+            assert(bidirectional || src_coordinate <= dest_coordinate);
+            hops_count += (src_coordinate < dest_coordinate) ? dest_coordinate - src_coordinate
+                                                             : src_coordinate - dest_coordinate;
+        }
+    }
+
+    return hops_count;
+}
+
+int TorusND::get_links_count() const noexcept {
+    // links of every line of NPUs along every axis
+    auto links_count = 0;
+    for (size_t axis = 0; axis < shape.size(); axis++) {
+        const auto axis_npus_count = shape[axis];
+        const auto lines_count = npus_count / axis_npus_count;
+
+        // an axis of two NPUs wrapping around has a single bidirectional link
+        auto line_links_count = axis_npus_count - 1;
+        if (wraparound[axis] && (axis_npus_count > 2 || (axis_npus_count == 2 && !bidirectional))) {
+            line_links_count++;
+        }
+        links_count += lines_count * (bidirectional ? 2 * line_links_count : line_links_count);
+    }
+
+    return links_count;
+}
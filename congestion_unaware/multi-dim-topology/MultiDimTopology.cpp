@@ -4,14 +4,17 @@ LICENSE file in the root directory of this source tree.
 *******************************************************************************/
 
 #include "congestion_unaware/MultiDimTopology.h"
+#include "common/NetworkFunction.h"
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
 #include <iostream>
+#include <limits>
 
 using namespace NetworkAnalytical;
 using namespace NetworkAnalyticalCongestionUnaware;
 
-MultiDimTopology::MultiDimTopology() noexcept : Topology() {
+MultiDimTopology::MultiDimTopology() noexcept : send_mode(MultiDimSendMode::FirstDim), Topology() {
     // initialize values
     topology_per_dim.clear();
     npus_count_per_dim = {};
@@ -22,23 +25,108 @@ MultiDimTopology::MultiDimTopology() noexcept : Topology() {
 }
 
 EventTime MultiDimTopology::send(const DeviceId src, const DeviceId dest, const ChunkSize chunk_size) const noexcept {
-    // translate src and dest to multi-dim address
-    const auto src_address = translate_address(src);
-    const auto dest_address = translate_address(dest);
+    if (send_mode != MultiDimSendMode::FirstDim) {
+        return send_across_dims(src, dest, chunk_size);
+    }
 
-    // get dim to transfer
-    const auto dim_to_transfer = get_dim_to_transfer(src_address, dest_address);
+    assert(0 <= src && src < npus_count);
+    assert(0 <= dest && dest < npus_count);
+    assert(src != dest);
 
-    // prepare localized topology and address info
-    auto* const topology = topology_per_dim[dim_to_transfer].get();
-    const auto src_local_id = src_address[dim_to_transfer];
-    const auto dest_local_id = dest_address[dim_to_transfer];
+    // the transfer happens in the lowest dimension where the addresses differ,
+    // decoded with npus_stride_per_dim (without allocation)
+    for (auto dim = 0; dim < dims_count; dim++) {
+        const auto src_local_id = (src / npus_stride_per_dim[dim]) % npus_count_per_dim[dim];
+        const auto dest_local_id = (dest / npus_stride_per_dim[dim]) % npus_count_per_dim[dim];
+        if (src_local_id != dest_local_id) {
+            // run localized communication
+            return topology_per_dim[dim]->send(src_local_id, dest_local_id, chunk_size);
+        }
+    }
 
-    // run localized communication
-    const auto comms_delay = topology->send(src_local_id, dest_local_id, chunk_size);
+    // shouldn't reach here
+    std::cerr << "[Error] (network/analytical/congestion_unaware): " << "src and dest have the same address"
+              << std::endl;
+    std::exit(-1);
+}
 
-    // return communication delay
-    return comms_delay;
+void MultiDimTopology::send_batch(const DeviceId* const src,
+                                  const DeviceId* const dest,
+                                  const ChunkSize* const chunk_size,
+                                  EventTime* const comms_delay,
+                                  const size_t count) const noexcept {
+    if (send_mode != MultiDimSendMode::FirstDim) {
+        Topology::send_batch(src, dest, chunk_size, comms_delay, count);
+        return;
+    }
+
+    // per-chunk dimension and local ids
+    int dim_to_transfer[batch_block_size];
+    DeviceId src_local_id[batch_block_size];
+    DeviceId dest_local_id[batch_block_size];
+
+    // chunks of a single dimension, packed
+    size_t packed_index[batch_block_size];
+    DeviceId packed_src[batch_block_size];
+    DeviceId packed_dest[batch_block_size];
+    ChunkSize packed_chunk_size[batch_block_size];
+    EventTime packed_comms_delay[batch_block_size];
+
+    for (size_t block_start = 0; block_start < count; block_start += batch_block_size) {
+        const auto block_count = std::min(batch_block_size, count - block_start);
+        const auto* const block_src = src + block_start;
+        const auto* const block_dest = dest + block_start;
+
+        // the transfer happens in the lowest dimension where the addresses differ:
+        // scan from the lowest dimension up and stop there, as most chunks differ in the first ones
+        for (size_t i = 0; i < block_count; i++) {
+            assert(0 <= block_src[i] && block_src[i] < npus_count);
+            assert(0 <= block_dest[i] && block_dest[i] < npus_count);
+            assert(block_src[i] != block_dest[i]);
+
+            auto src_remaining = block_src[i];
+            auto dest_remaining = block_dest[i];
+            auto dim = 0;
+            while (true) {
+                assert(dim < dims_count);
+                const auto count_in_dim = npus_count_per_dim[dim];
+                const auto src_address = src_remaining % count_in_dim;
+                const auto dest_address = dest_remaining % count_in_dim;
+                if (src_address != dest_address) {
+                    src_local_id[i] = src_address;
+                    dest_local_id[i] = dest_address;
+                    break;
+                }
+                src_remaining /= count_in_dim;
+                dest_remaining /= count_in_dim;
+                dim++;
+            }
+            dim_to_transfer[i] = dim;
+        }
+
+        // run each dimension's batched kernel on its chunks
+        for (auto dim = 0; dim < dims_count; dim++) {
+            auto packed_count = size_t{0};
+            for (size_t i = 0; i < block_count; i++) {
+                if (dim_to_transfer[i] == dim) {
+                    packed_index[packed_count] = i;
+                    packed_src[packed_count] = src_local_id[i];
+                    packed_dest[packed_count] = dest_local_id[i];
+                    packed_chunk_size[packed_count] = chunk_size[block_start + i];
+                    packed_count++;
+                }
+            }
+            if (packed_count == 0) {
+                continue;
+            }
+
+            topology_per_dim[dim]->send_batch(packed_src, packed_dest, packed_chunk_size, packed_comms_delay,
+                                              packed_count);
+            for (size_t j = 0; j < packed_count; j++) {
+                comms_delay[block_start + packed_index[j]] = packed_comms_delay[j];
+            }
+        }
+    }
 }
 
 void MultiDimTopology::append_dimension(std::unique_ptr<BasicTopology> topology) noexcept {
@@ -47,66 +135,91 @@ void MultiDimTopology::append_dimension(std::unique_ptr<BasicTopology> topology)
 
     // increase npus_count
     const auto topology_size = topology->get_npus_count();
+    npus_stride_per_dim.push_back(npus_count);
     npus_count *= topology_size;
 
     // append bandwidth
     const auto bandwidth = topology->get_bandwidth_per_dim()[0];
     bandwidth_per_dim.push_back(bandwidth);
+    bandwidth_Bpns_per_dim.push_back(bw_GBps_to_Bpns(bandwidth));
 
     // push back topology and npus_count
     topology_per_dim.push_back(std::move(topology));
     npus_count_per_dim.push_back(topology_size);
 }
 
-MultiDimAddress MultiDimTopology::translate_address(const DeviceId npu_id) const noexcept {
-    // If units-count if [2, 8, 4], and the given id is 47, then the id should be
-    // 47 // 16 = 2, leftover = 47 % 16 = 15
-    // 15 // 2 = 7, leftover = 15 % 2 = 1
-    // 1 // 1 = 1, leftover = 0
-    // therefore the address is [1, 7, 2]
-
-    // create empty address
-    auto multi_dim_address = MultiDimAddress();
-    for (auto i = 0; i < dims_count; i++) {
-        multi_dim_address.push_back(-1);
-    }
+void MultiDimTopology::set_send_mode(const MultiDimSendMode send_mode) noexcept {
+    this->send_mode = send_mode;
+}
 
-    auto leftover = npu_id;
-    auto denominator = npus_count;
+EventTime MultiDimTopology::send_at(const DeviceId src,
+                                    const DeviceId dest,
+                                    const ChunkSize chunk_size,
+                                    const EventTime send_time) noexcept {
+    assert(0 <= src && src < npus_count);
+    assert(0 <= dest && dest < npus_count);
+    assert(src != dest);
 
-    for (auto dim = dims_count - 1; dim >= 0; dim--) {
-        // change denominator
-        denominator /= npus_count_per_dim[dim];
+    auto queueing_delay = 0.0;
+    for (auto dim = 0; dim < dims_count; dim++) {
+        const auto src_local_id = (src / npus_stride_per_dim[dim]) % npus_count_per_dim[dim];
+        const auto dest_local_id = (dest / npus_stride_per_dim[dim]) % npus_count_per_dim[dim];
+        if (src_local_id == dest_local_id) {
+            continue;
+        }
 
-        // get and update address
-        const auto quotient = leftover / denominator;
-        leftover %= denominator;
+        // FirstDim: the lowest differing dimension carries the whole transfer
+        if (send_mode == MultiDimSendMode::FirstDim) {
+            return topology_per_dim[dim]->send_at(src_local_id, dest_local_id, chunk_size, send_time);
+        }
 
-        // update address
-        multi_dim_address[dim] = quotient;
+        queueing_delay += topology_per_dim[dim]->estimate_queueing_delay(src_local_id, dest_local_id, chunk_size,
+                                                                         send_time);
     }
 
-    // check address translation
-    for (auto i = 0; i < dims_count; i++) {
-        assert(0 <= multi_dim_address[i]);
-        assert(multi_dim_address[i] < npus_count_per_dim[i]);
-    }
+    return send_across_dims(src, dest, chunk_size, queueing_delay);
+}
 
-    // return retrieved address
-    return multi_dim_address;
+void MultiDimTopology::enable_congestion_estimation(const CongestionModel congestion_model,
+                                                    const EventTime window) noexcept {
+    for (auto dim = 0; dim < dims_count; dim++) {
+        topology_per_dim[dim]->set_replicas_count(npus_count / npus_count_per_dim[dim]);
+        topology_per_dim[dim]->enable_congestion_estimation(congestion_model, window);
+    }
 }
 
-int MultiDimTopology::get_dim_to_transfer(const MultiDimAddress& src_address,
-                                          const MultiDimAddress& dest_address) const noexcept {
+EventTime MultiDimTopology::send_across_dims(const DeviceId src,
+                                             const DeviceId dest,
+                                             const ChunkSize chunk_size,
+                                             const double queueing_delay) const noexcept {
+    assert(0 <= src && src < npus_count);
+    assert(0 <= dest && dest < npus_count);
+    assert(src != dest);
+    assert(chunk_size > 0);
+
+    auto link_delay = 0.0;
+    auto serialization_delay = 0.0;
+    auto slowest_bandwidth_Bpns = std::numeric_limits<Bandwidth>::max();
+
     for (auto dim = 0; dim < dims_count; dim++) {
-        // check the dim that has different address
-        if (src_address[dim] != dest_address[dim]) {
-            return dim;
+        const auto src_local_id = (src / npus_stride_per_dim[dim]) % npus_count_per_dim[dim];
+        const auto dest_local_id = (dest / npus_stride_per_dim[dim]) % npus_count_per_dim[dim];
+        if (src_local_id == dest_local_id) {
+            continue;
         }
+
+        // every crossed dimension adds its hops
+        link_delay += topology_per_dim[dim]->compute_path_latency(src_local_id, dest_local_id);
+
+        // store-and-forward serializes on every dimension, cut-through only on the slowest one
+        serialization_delay += static_cast<double>(chunk_size) / bandwidth_Bpns_per_dim[dim];
+        slowest_bandwidth_Bpns = std::min(slowest_bandwidth_Bpns, bandwidth_Bpns_per_dim[dim]);
     }
 
-    // shouldn't reach here
-    std::cerr << "[Error] (network/analytical/congestion_unaware): " << "src and dest have the same address"
-              << std::endl;
-    std::exit(-1);
+    if (send_mode == MultiDimSendMode::Pipelined) {
+        serialization_delay = static_cast<double>(chunk_size) / slowest_bandwidth_Bpns;
+    }
+
+    // single-dimension transfers match BasicTopology::send() in both modes
+    return static_cast<EventTime>(link_delay + serialization_delay + queueing_delay);
 }
@@ -0,0 +1,294 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_unaware/CollectiveModel.h"
+#include "common/NetworkFunction.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionUnaware;
+
+CollectiveModel::CollectiveModel(std::shared_ptr<const Topology> topology, const int pipeline_chunks_count) noexcept
+    : topology(std::move(topology)),
+      pipeline_chunks_count(pipeline_chunks_count) {
+    assert(this->topology != nullptr);
+    assert(pipeline_chunks_count > 0);
+
+    const auto npus_count = this->topology->get_npus_count();
+    const auto npus_count_per_dim = this->topology->get_npus_count_per_dim();
+    const auto dims_count = this->topology->get_dims_count();
+
+    // one group per dimension
+    auto stride = DeviceId{1};
+    auto farthest_npu = DeviceId{0};
+    for (auto dim = 0; dim < dims_count; dim++) {
+        const auto dim_npus_count = npus_count_per_dim[dim];
+        auto group = Group{dim_npus_count, stride, {}, {}};
+
+        if (dim_npus_count > 1) {
+            // the ring closes with the (n-1) -> 0 edge, which is not a neighbour on Mesh
+            group.ring_edges.emplace_back(0, stride);
+            group.ring_edges.emplace_back((dim_npus_count - 1) * stride, 0);
+
+            // the farthest member only depends on the basic topology of the dimension
+            auto farthest_index = 1;
+            auto farthest_delay = send(0, stride, 1);
+            for (auto index = 2; index < dim_npus_count; index++) {
+                const auto delay = send(0, index * stride, 1);
+                if (delay > farthest_delay) {
+                    farthest_index = index;
+                    farthest_delay = delay;
+                }
+            }
+            group.farthest_npus.push_back(farthest_index * stride);
+            farthest_npu += farthest_index * stride;
+        }
+
+        group_per_dim.push_back(std::move(group));
+        stride *= dim_npus_count;
+    }
+
+    // all NPUs: ring neighbours cross every dimension once, and the farthest NPU is in any dimension
+    flat_group = Group{npus_count, 1, {}, {}};
+    if (npus_count > 1) {
+        flat_group.ring_edges.emplace_back(0, 1);
+        for (auto dim = 1; dim < dims_count; dim++) {
+            const auto dim_stride = group_per_dim[dim].stride;
+            if (npus_count_per_dim[dim] > 1 && dim_stride > 1) {
+                flat_group.ring_edges.emplace_back(dim_stride - 1, dim_stride);
+            }
+        }
+        flat_group.ring_edges.emplace_back(npus_count - 1, 0);
+
+        for (const auto& group : group_per_dim) {
+            flat_group.farthest_npus.insert(flat_group.farthest_npus.end(), group.farthest_npus.begin(),
+                                            group.farthest_npus.end());
+        }
+        flat_group.farthest_npus.push_back(farthest_npu);
+    }
+}
+
+EventTime CollectiveModel::estimate(const CollectiveOperation operation,
+                                    const CollectiveAlgorithm algorithm,
+                                    const ChunkSize collective_size) const noexcept {
+    assert(collective_size > 0);
+
+    if (algorithm == CollectiveAlgorithm::Hierarchical) {
+        const auto algorithm_per_dim =
+            std::vector<CollectiveAlgorithm>(topology->get_dims_count(), CollectiveAlgorithm::Ring);
+        return estimate_hierarchical(operation, algorithm_per_dim, collective_size);
+    }
+
+    const auto time = estimate_group(flat_group, operation, algorithm, static_cast<double>(collective_size));
+    return static_cast<EventTime>(time);
+}
+
+EventTime CollectiveModel::estimate_hierarchical(const CollectiveOperation operation,
+                                                 const std::vector<CollectiveAlgorithm>& algorithm_per_dim,
+                                                 const ChunkSize collective_size) const noexcept {
+    assert(collective_size > 0);
+    assert(algorithm_per_dim.size() == group_per_dim.size());
+
+    const auto dims_count = static_cast<int>(group_per_dim.size());
+
+    // buffer size each dimension works on: shrinks by npus_count after each ReduceScatter
+    auto size_per_dim = std::vector<double>(dims_count);
+    auto size = static_cast<double>(collective_size);
+    for (auto dim = 0; dim < dims_count; dim++) {
+        size_per_dim[dim] = size;
+        size /= group_per_dim[dim].npus_count;
+    }
+
+    auto time = 0.0;
+    switch (operation) {
+    case CollectiveOperation::ReduceScatter:
+        for (auto dim = 0; dim < dims_count; dim++) {
+            time += estimate_group(group_per_dim[dim], operation, algorithm_per_dim[dim], size_per_dim[dim]);
+        }
+        break;
+    case CollectiveOperation::AllGather:
+        for (auto dim = dims_count - 1; dim >= 0; dim--) {
+            time += estimate_group(group_per_dim[dim], operation, algorithm_per_dim[dim], size_per_dim[dim]);
+        }
+        break;
+    case CollectiveOperation::AllReduce:
+        for (auto dim = 0; dim < dims_count; dim++) {
+            time += estimate_group(group_per_dim[dim], CollectiveOperation::ReduceScatter, algorithm_per_dim[dim],
+                                   size_per_dim[dim]);
+        }
+        for (auto dim = dims_count - 1; dim >= 0; dim--) {
+            time += estimate_group(group_per_dim[dim], CollectiveOperation::AllGather, algorithm_per_dim[dim],
+                                   size_per_dim[dim]);
+        }
+        break;
+    case CollectiveOperation::AllToAll:
+    case CollectiveOperation::Broadcast:
+        // the whole buffer moves through every dimension
+        for (auto dim = 0; dim < dims_count; dim++) {
+            time += estimate_group(group_per_dim[dim], operation, algorithm_per_dim[dim],
+                                   static_cast<double>(collective_size));
+        }
+        break;
+    }
+
+    return static_cast<EventTime>(time);
+}
+
+double CollectiveModel::estimate_group(const Group& group,
+                                       const CollectiveOperation operation,
+                                       const CollectiveAlgorithm algorithm,
+                                       const double collective_size) const noexcept {
+    const auto npus_count = group.npus_count;
+    if (npus_count <= 1) {
+        // nothing to communicate
+        return 0.0;
+    }
+    const auto shard_size = collective_size / npus_count;
+
+    switch (algorithm) {
+    case CollectiveAlgorithm::Ring:
+        switch (operation) {
+        case CollectiveOperation::ReduceScatter:
+        case CollectiveOperation::AllGather:
+            return (npus_count - 1) * ring_step(group, shard_size);
+        case CollectiveOperation::AllReduce:
+            return 2 * (npus_count - 1) * ring_step(group, shard_size);
+        case CollectiveOperation::AllToAll:
+            // step i relays (n - i) shards; send() is affine in size, so this averages to half a buffer per step
+            return (npus_count - 1) * ring_step(group, collective_size / 2);
+        case CollectiveOperation::Broadcast:
+            // pipelined scatter followed by AllGather
+            return 2 * (npus_count - 1) * ring_step(group, shard_size);
+        }
+        break;
+
+    case CollectiveAlgorithm::Direct:
+        switch (operation) {
+        case CollectiveOperation::ReduceScatter:
+        case CollectiveOperation::AllGather:
+        case CollectiveOperation::AllToAll:
+            return direct_step(group, shard_size);
+        case CollectiveOperation::AllReduce:
+            return 2 * direct_step(group, shard_size);
+        case CollectiveOperation::Broadcast:
+            return direct_step(group, collective_size);
+        }
+        break;
+
+    case CollectiveAlgorithm::HalvingDoubling: {
+        const auto steps_count = ceil_log2(npus_count);
+        auto time = 0.0;
+        switch (operation) {
+        case CollectiveOperation::ReduceScatter:
+        case CollectiveOperation::AllGather:
+        case CollectiveOperation::AllReduce:
+            // recursive halving: the farthest peer first, exchanging half of the remaining buffer
+            if (operation != CollectiveOperation::AllGather) {
+                for (auto step = 0; step < steps_count; step++) {
+                    time += partner_step(group, 1 << (steps_count - 1 - step), collective_size / (2 << step));
+                }
+            }
+            // recursive doubling: the nearest peer first, exchanging everything gathered so far
+            if (operation != CollectiveOperation::ReduceScatter) {
+                for (auto step = 0; step < steps_count; step++) {
+                    time += partner_step(group, 1 << step, collective_size / (1 << (steps_count - step)));
+                }
+            }
+            return time;
+        case CollectiveOperation::AllToAll:
+            // Bruck: half of the buffer moves at every step
+            for (auto step = 0; step < steps_count; step++) {
+                time += partner_step(group, 1 << step, collective_size / 2);
+            }
+            return time;
+        case CollectiveOperation::Broadcast:
+            // binomial tree
+            for (auto step = 0; step < steps_count; step++) {
+                time += partner_step(group, 1 << (steps_count - 1 - step), collective_size);
+            }
+            return time;
+        }
+        break;
+    }
+
+    case CollectiveAlgorithm::DoubleBinaryTree:
+        // each tree carries half of the buffer, and both trees run concurrently
+        switch (operation) {
+        case CollectiveOperation::AllReduce:
+            // reduce to the roots, then broadcast back
+            return 2 * tree_pass(group, collective_size / 2);
+        case CollectiveOperation::Broadcast:
+            return tree_pass(group, collective_size / 2);
+        default:
+            std::cerr << "[Error] (network/analytical/congestion_unaware): "
+                      << "DoubleBinaryTree only supports AllReduce and Broadcast" << std::endl;
+            std::exit(-1);
+        }
+
+    case CollectiveAlgorithm::Hierarchical:
+        std::cerr << "[Error] (network/analytical/congestion_unaware): "
+                  << "Hierarchical cannot be used as a per-dimension algorithm" << std::endl;
+        std::exit(-1);
+    }
+
+    // shouldn't reach here
+    std::cerr << "[Error] (network/analytical/congestion_unaware): " << "Not supported collective" << std::endl;
+    std::exit(-1);
+}
+
+double CollectiveModel::ring_step(const Group& group, const double chunk_size) const noexcept {
+    assert(!group.ring_edges.empty());
+
+    auto time = 0.0;
+    for (const auto& [src, dest] : group.ring_edges) {
+        time = std::max(time, send(src, dest, chunk_size));
+    }
+    return time;
+}
+
+double CollectiveModel::direct_step(const Group& group, const double chunk_size) const noexcept {
+    assert(!group.farthest_npus.empty());
+
+    auto time = 0.0;
+    for (const auto dest : group.farthest_npus) {
+        time = std::max(time, send(0, dest, chunk_size));
+    }
+    return time;
+}
+
+double CollectiveModel::partner_step(const Group& group, const int distance, const double chunk_size) const noexcept {
+    assert(distance > 0);
+
+    // non-power-of-two groups: the last steps pair up with the farthest member
+    const auto clamped_distance = std::min(distance, group.npus_count - 1);
+    return send(0, clamped_distance * group.stride, chunk_size);
+}
+
+double CollectiveModel::tree_pass(const Group& group, const double chunk_size) const noexcept {
+    // in-order binary tree over the members: a node of height h links to children 2^(h-1) apart
+    const auto depth = std::max(floor_log2(group.npus_count), 1);
+    const auto pipeline_chunk_size = chunk_size / pipeline_chunks_count;
+
+    // the first chunk crosses every level, the others follow one slowest level apart
+    auto time = 0.0;
+    auto slowest_level_time = 0.0;
+    for (auto level = 0; level < depth; level++) {
+        const auto level_time = partner_step(group, 1 << level, pipeline_chunk_size);
+        time += level_time;
+        slowest_level_time = std::max(slowest_level_time, level_time);
+    }
+    return time + ((pipeline_chunks_count - 1) * slowest_level_time);
+}
+
+double CollectiveModel::send(const DeviceId src, const DeviceId dest, const double chunk_size) const noexcept {
+    assert(src != dest);
+
+    const auto size = std::max(static_cast<ChunkSize>(std::ceil(chunk_size)), ChunkSize{1});
+    return static_cast<double>(topology->send(src, dest, size));
+}
@@ -5,12 +5,15 @@ LICENSE file in the root directory of this source tree.
 
 #include "congestion_unaware/Helper.h"
 #include "congestion_unaware/BasicTopology.h"
+#include "congestion_unaware/Dragonfly.h"
+#include "congestion_unaware/FatTree.h"
 #include "congestion_unaware/FullyConnected.h"
 #include "congestion_unaware/HyperCube.h"
 #include "congestion_unaware/Mesh.h"
 #include "congestion_unaware/MultiDimTopology.h"
 #include "congestion_unaware/Ring.h"
 #include "congestion_unaware/Switch.h"
+#include "congestion_unaware/TorusND.h"
 #include <cstdlib>
 #include <iostream>
 
@@ -46,6 +49,19 @@ std::shared_ptr<Topology> NetworkAnalyticalCongestionUnaware::construct_topology
             return std::make_shared<Mesh>(npus_count, bandwidth, latency);
         case TopologyBuildingBlock::HyperCube:
             return std::make_shared<HyperCube>(npus_count, bandwidth, latency);
+        case TopologyBuildingBlock::TorusND:
+        case TopologyBuildingBlock::MeshND:
+            return std::make_shared<TorusND>(network_parser.get_shape(), bandwidth, latency,
+                                             network_parser.get_wraparound());
+        case TopologyBuildingBlock::FatTree:
+            return std::make_shared<FatTree>(network_parser.get_radix(), network_parser.get_tiers(),
+                                             network_parser.get_oversubscription(), bandwidth, latency);
+        case TopologyBuildingBlock::Dragonfly:
+            return std::make_shared<Dragonfly>(
+                network_parser.get_groups(), network_parser.get_routers_per_group(),
+                network_parser.get_global_links_per_router(),
+                npus_count / (network_parser.get_groups() * network_parser.get_routers_per_group()),
+                network_parser.get_dragonfly_arrangement(), network_parser.get_dragonfly_routing(), bandwidth, latency);
         default:
             // shouldn't reach here
             std::cerr << "[Error] (network/analytical/congestion_unaware)" << "Not supported topology" << std::endl;
@@ -55,6 +71,7 @@ std::shared_ptr<Topology> NetworkAnalyticalCongestionUnaware::construct_topology
 
     // otherwise, create multi-dim basic-topology
     const auto multi_dim_topology = std::make_shared<MultiDimTopology>();
+    multi_dim_topology->set_send_mode(network_parser.get_multi_dim_send_mode());
 
     // create and append dims
     for (auto dim = 0; dim < dims_count; dim++) {
@@ -0,0 +1,62 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_unaware/LoadWindow.h"
+#include <algorithm>
+#include <cassert>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionUnaware;
+
+LoadWindow::LoadWindow(const EventTime window, const int buckets_count) noexcept
+    : bucket_width(std::max(window / buckets_count, EventTime{1})),
+      bucket_bytes(buckets_count, 0.0),
+      newest_bucket(0),
+      window_bytes(0.0) {
+    assert(window > 0);
+    assert(buckets_count > 0);
+}
+
+void LoadWindow::add(const EventTime time, const double bytes) noexcept {
+    assert(bytes >= 0);
+
+    advance(time);
+    bucket_bytes[newest_bucket % bucket_bytes.size()] += bytes;
+    window_bytes += bytes;
+}
+
+double LoadWindow::get_bytes(const EventTime time) noexcept {
+    advance(time);
+
+    // clamp rounding drift of the running sum
+    return std::max(window_bytes, 0.0);
+}
+
+EventTime LoadWindow::get_window() const noexcept {
+    return bucket_width * bucket_bytes.size();
+}
+
+void LoadWindow::advance(const EventTime time) noexcept {
+    const auto bucket = time / bucket_width;
+    if (bucket <= newest_bucket) {
+        // still within (or before) the newest bucket
+        return;
+    }
+
+    const auto buckets_count = static_cast<EventTime>(bucket_bytes.size());
+    if (bucket - newest_bucket >= buckets_count) {
+        // the whole window expired
+        std::fill(bucket_bytes.begin(), bucket_bytes.end(), 0.0);
+        window_bytes = 0.0;
+    } else {
+        // expire the buckets the window slid over
+        for (auto expired = newest_bucket + 1; expired <= bucket; expired++) {
+            auto& bytes = bucket_bytes[expired % buckets_count];
+            window_bytes -= bytes;
+            bytes = 0.0;
+        }
+    }
+    newest_bucket = bucket;
+}
@@ -5,12 +5,39 @@ LICENSE file in the root directory of this source tree.
 
 #include "congestion_unaware/Topology.h"
 #include <cassert>
+#include <cstdlib>
+#include <iostream>
 
 using namespace NetworkAnalytical;
 using namespace NetworkAnalyticalCongestionUnaware;
 
 Topology::Topology() noexcept : npus_count(-1), dims_count(-1) {}
 
+void Topology::send_batch(const DeviceId* const src,
+                          const DeviceId* const dest,
+                          const ChunkSize* const chunk_size,
+                          EventTime* const comms_delay,
+                          const size_t count) const noexcept {
+    // fallback: one send per chunk
+    for (size_t i = 0; i < count; i++) {
+        comms_delay[i] = send(src[i], dest[i], chunk_size[i]);
+    }
+}
+
+EventTime Topology::send_at(const DeviceId src,
+                            const DeviceId dest,
+                            const ChunkSize chunk_size,
+                            const EventTime send_time) noexcept {
+    // no load tracking: same as send()
+    return send(src, dest, chunk_size);
+}
+
+void Topology::enable_congestion_estimation(const CongestionModel congestion_model, const EventTime window) noexcept {
+    std::cerr << "[Error] (network/analytical/congestion_unaware): "
+              << "congestion estimation is not supported by this topology" << std::endl;
+    std::exit(-1);
+}
+
 int Topology::get_npus_count() const noexcept {
     assert(npus_count > 0);
 
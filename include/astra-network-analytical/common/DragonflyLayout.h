@@ -0,0 +1,159 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/Type.h"
+#include <cstdint>
+#include <vector>
+
+namespace NetworkAnalytical {
+
+/**
+ * DragonflyLayout numbers the NPUs and routers of a Dragonfly topology and routes between them arithmetically,
+ * shared by the congestion-aware and congestion-unaware Dragonfly.
+ *
+ * A Dragonfly has groups of fully-connected routers, each router owning npus_per_router NPUs.
+ * The global_links_per_router global ports of every router link the groups:
+ * global port j of a group is port j % global_links_per_router of router j / global_links_per_router,
+ * and the arrangement picks the group each port links to.
+ * Every group links to every other group by the same number of global links (its copies).
+ *
+ * NPU IDs come first, followed by the router IDs group by group,
+ * e.g., router r of group g is npus_count + (g * routers_per_group) + r.
+ *
+ * Routes are written as device IDs into a caller-provided buffer of max_route_length,
+ * so that routing decisions never allocate.
+ */
+class DragonflyLayout {
+  public:
+    /// most devices on a route (NPU, 6 routers of a Valiant route, NPU)
+    static constexpr int max_route_length = 8;
+
+    /**
+     * Constructor.
+     *
+     * @param groups number of groups
+     * @param routers_per_group number of routers per group
+     * @param global_links_per_router number of global links per router
+     * @param npus_per_router number of NPUs per router
+     * @param arrangement how the global links of a group spread over the other groups
+     */
+    DragonflyLayout(int groups,
+                    int routers_per_group,
+                    int global_links_per_router,
+                    int npus_per_router,
+                    DragonflyArrangement arrangement) noexcept;
+
+    /**
+     * Get the number of NPUs.
+     *
+     * @return number of NPUs
+     */
+    [[nodiscard]] int get_npus_count() const noexcept;
+
+    /**
+     * Get the number of routers.
+     *
+     * @return number of routers
+     */
+    [[nodiscard]] int get_routers_count() const noexcept;
+
+    /**
+     * Write the minimal route from src to dest, which takes at most one global link.
+     * The global link is one of the copies between the groups, picked by hash.
+     *
+     * @param src src NPU id
+     * @param dest dest NPU id
+     * @param hash random bits picking the global link
+     * @param route buffer of max_route_length device IDs the route is written into
+     * @return number of devices on the route
+     */
+    [[nodiscard]] int minimal_route(DeviceId src, DeviceId dest, uint64_t hash, DeviceId* route) const noexcept;
+
+    /**
+     * Write the Valiant route from src to dest,
+     * minimally to an intermediate group and then minimally to dest (both picked by hash).
+     * Within a group, the route goes through an intermediate router instead.
+     * Falls back to the minimal route if there is nothing in between.
+     *
+     * @param src src NPU id
+     * @param dest dest NPU id
+     * @param hash random bits picking the intermediate group or router and the global links
+     * @param route buffer of max_route_length device IDs the route is written into
+     * @return number of devices on the route
+     */
+    [[nodiscard]] int valiant_route(DeviceId src, DeviceId dest, uint64_t hash, DeviceId* route) const noexcept;
+
+    /**
+     * Get every link between routers, in both directions:
+     * the local links within every group and the global links between groups.
+     *
+     * @return router links as connection policies
+     */
+    [[nodiscard]] std::vector<ConnectionPolicy> get_router_links() const noexcept;
+
+    /**
+     * Mix (src, dest, chunk_id) into the random bits routing decisions are picked by.
+     *
+     * @param src src NPU id
+     * @param dest dest NPU id
+     * @param chunk_id id of the chunk
+     * @return hash of the arguments
+     */
+    [[nodiscard]] static uint64_t hash(DeviceId src, DeviceId dest, uint64_t chunk_id) noexcept;
+
+  private:
+    /// number of groups
+    int groups;
+
+    /// number of routers per group
+    int routers_per_group;
+
+    /// number of global links per router
+    int global_links_per_router;
+
+    /// number of NPUs per router
+    int npus_per_router;
+
+    /// number of global links between every two groups
+    int copies_count;
+
+    /// how the global links of a group spread over the other groups
+    DragonflyArrangement arrangement;
+
+    /**
+     * Get the group a global port of a group links to.
+     *
+     * @param group group of the port
+     * @param offset port index modulo (groups - 1)
+     * @return linked group
+     */
+    [[nodiscard]] int peer_group(int group, int offset) const noexcept;
+
+    /**
+     * Get the port offset of a group linking to another group (the inverse of peer_group).
+     *
+     * @param group group of the port
+     * @param peer linked group
+     * @return port index modulo (groups - 1)
+     */
+    [[nodiscard]] int offset_to(int group, int peer) const noexcept;
+
+    /**
+     * Append the routers a route takes from a router to another group over one of its global links:
+     * the gateway router (if not the router itself) and the router the global link arrives at.
+     *
+     * @param router router ID the route is at
+     * @param peer group to go to
+     * @param copy which of the global links between the groups to take
+     * @param route route buffer
+     * @param length number of devices on the route, updated
+     * @return router ID the route arrives at
+     */
+    DeviceId append_global_hop(DeviceId router, int peer, int copy, DeviceId* route, int& length) const noexcept;
+};
+
+}  // namespace NetworkAnalytical
@@ -7,6 +7,7 @@ LICENSE file in the root directory of this source tree.
 
 #include "common/Event.h"
 #include "common/Type.h"
+#include <cstdint>
 #include <list>
 
 namespace NetworkAnalytical {
@@ -39,9 +40,12 @@ class EventList {
     void add_event(Callback callback, CallbackArg callback_arg) noexcept;
 
     /**
-     * Invoke all events in the event list.
+     * Invoke all events in the event list,
+     * including events added to this list while invoking.
+     *
+     * @return number of events invoked
      */
-    void invoke_events() noexcept;
+    uint64_t invoke_events() noexcept;
 
   private:
     /// event time of the event list
@@ -6,7 +6,10 @@ LICENSE file in the root directory of this source tree.
 #pragma once
 
 #include "common/EventList.h"
+#include "common/ProgressReporter.h"
 #include "common/Type.h"
+#include <cstdint>
+#include <memory>
 
 namespace NetworkAnalytical {
 
@@ -29,9 +32,10 @@ class EventQueue {
 
     /**
      * Check all registered events are invoked.
-     * i.e., check if the event queue is empty.
+     * i.e., check if the event queue is empty,
+     * or if the current progress reporter stopped the run early.
      *
-     * @return true if the event queue is empty, false otherwise
+     * @return true if the event queue is empty or stopped, false otherwise
      */
     [[nodiscard]] bool finished() const noexcept;
 
@@ -52,12 +56,44 @@ class EventQueue {
      */
     void schedule_event(EventTime event_time, Callback callback, CallbackArg callback_arg) noexcept;
 
+    /**
+     * Get the number of events invoked so far.
+     *
+     * @return number of invoked events
+     */
+    [[nodiscard]] uint64_t get_invoked_events_count() const noexcept;
+
+    /**
+     * Get the number of events scheduled but not yet invoked.
+     *
+     * @return number of pending events
+     */
+    [[nodiscard]] uint64_t get_pending_events_count() const noexcept;
+
+    /**
+     * Set the reporter notified after every proceed.
+     *
+     * A run stopped by the previous reporter resumes.
+     *
+     * @param progress_reporter pointer to the reporter, nullptr to stop reporting
+     */
+    void set_progress_reporter(std::shared_ptr<ProgressReporter> progress_reporter) noexcept;
+
   private:
     /// current time of the event queue
     EventTime current_time;
 
     /// list of EventLists
     std::list<EventList> event_queue;
+
+    /// number of events invoked so far
+    uint64_t invoked_events_count;
+
+    /// number of events scheduled but not yet invoked
+    uint64_t pending_events_count;
+
+    /// reporter notified after every proceed (nullptr if none)
+    std::shared_ptr<ProgressReporter> progress_reporter;
 };
 
 }  // namespace NetworkAnalytical
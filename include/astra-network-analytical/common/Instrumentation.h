@@ -0,0 +1,110 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+namespace NetworkAnalytical {
+
+/**
+ * Counters collected by an instrumentation policy.
+ */
+struct InstrumentationCounters {
+    /// number of events scheduled to the EventQueue
+    uint64_t events_scheduled = 0;
+
+    /// number of distinct event times the EventQueue proceeded to
+    uint64_t event_times_proceeded = 0;
+
+    /// number of chunks created
+    uint64_t chunks_created = 0;
+
+    /// number of chunk hops forwarded by devices
+    uint64_t hops_forwarded = 0;
+
+    /// number of link queue depth samples (one per chunk reaching a link)
+    uint64_t queue_depth_samples = 0;
+
+    /// sum of the sampled link queue depths
+    uint64_t queue_depth_sum = 0;
+
+    /// largest sampled link queue depth
+    uint64_t max_queue_depth = 0;
+};
+
+/**
+ * Instrumentation policy recording nothing.
+ * Every hook is an empty inline function, so the optimizer removes the calls entirely.
+ */
+struct NullInstrumentation {
+    static void event_scheduled() noexcept {}
+
+    static void event_time_proceeded() noexcept {}
+
+    static void chunk_created() noexcept {}
+
+    static void hop_forwarded() noexcept {}
+
+    static void queue_depth_sampled(uint64_t /* queue_depth */) noexcept {}
+
+    [[nodiscard]] static InstrumentationCounters get_counters() noexcept {
+        return {};
+    }
+
+    static void reset() noexcept {}
+};
+
+/**
+ * Instrumentation policy counting hot-path activity into process-wide counters.
+ * The simulation is single-threaded, so the counters are plain integers.
+ */
+struct CountingInstrumentation {
+    static void event_scheduled() noexcept {
+        counters.events_scheduled++;
+    }
+
+    static void event_time_proceeded() noexcept {
+        counters.event_times_proceeded++;
+    }
+
+    static void chunk_created() noexcept {
+        counters.chunks_created++;
+    }
+
+    static void hop_forwarded() noexcept {
+        counters.hops_forwarded++;
+    }
+
+    static void queue_depth_sampled(const uint64_t queue_depth) noexcept {
+        counters.queue_depth_samples++;
+        counters.queue_depth_sum += queue_depth;
+        if (queue_depth > counters.max_queue_depth) {
+            counters.max_queue_depth = queue_depth;
+        }
+    }
+
+    [[nodiscard]] static InstrumentationCounters get_counters() noexcept {
+        return counters;
+    }
+
+    static void reset() noexcept {
+        counters = InstrumentationCounters();
+    }
+
+  private:
+    /// counters collected so far
+    inline static InstrumentationCounters counters = {};
+};
+
+/// instrumentation policy used by EventQueue, Chunk, Device and Link,
+/// selected by the NETWORK_BACKEND_INSTRUMENTATION CMake option
+#ifdef NETWORK_BACKEND_INSTRUMENTATION_COUNTERS
+using Instrumentation = CountingInstrumentation;
+#else
+using Instrumentation = NullInstrumentation;
+#endif
+
+}  // namespace NetworkAnalytical
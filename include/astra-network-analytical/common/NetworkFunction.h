@@ -19,4 +19,20 @@ namespace NetworkAnalytical {
  */
 Bandwidth bw_GBps_to_Bpns(Bandwidth bw_GBps) noexcept;
 
+/**
+ * Compute ceil(log2(value)).
+ *
+ * @param value value, at least 1
+ * @return ceil(log2(value))
+ */
+int ceil_log2(int value) noexcept;
+
+/**
+ * Compute floor(log2(value)).
+ *
+ * @param value value, at least 1
+ * @return floor(log2(value))
+ */
+int floor_log2(int value) noexcept;
+
 }  // namespace NetworkAnalytical
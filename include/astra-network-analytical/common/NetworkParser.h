@@ -63,6 +63,83 @@ class NetworkParser {
     [[nodiscard]] std::vector<std::tuple<int, int, double>> get_faulty_links() const noexcept;
     [[nodiscard]] std::vector<int> get_non_recursive_topo() const noexcept;
 
+    /**
+     * Read "multi_dim_send" value (FirstDim if not given)
+     *
+     * @return how the congestion-unaware backend charges multi-dimension transfers
+     */
+    [[nodiscard]] MultiDimSendMode get_multi_dim_send_mode() const noexcept;
+
+    /**
+     * Read "shape" value: number of NPUs along each axis of a TorusND or MeshND topology
+     *
+     * @return number of NPUs per each axis (empty if not given)
+     */
+    [[nodiscard]] std::vector<int> get_shape() const noexcept;
+
+    /**
+     * Read "wraparound" value: whether each axis of a TorusND or MeshND topology wraps around
+     * (every axis of TorusND and no axis of MeshND if not given)
+     *
+     * @return wraparound per each axis
+     */
+    [[nodiscard]] std::vector<bool> get_wraparound() const noexcept;
+
+    /**
+     * Read "radix" value: number of ports per switch of a FatTree topology
+     *
+     * @return radix (0 if not given)
+     */
+    [[nodiscard]] int get_radix() const noexcept;
+
+    /**
+     * Read "tiers" value: number of switch tiers of a FatTree topology
+     *
+     * @return tiers (0 if not given)
+     */
+    [[nodiscard]] int get_tiers() const noexcept;
+
+    /**
+     * Read "oversubscription" value: ratio of endpoints to uplinks of a FatTree leaf switch
+     *
+     * @return oversubscription (1 if not given)
+     */
+    [[nodiscard]] int get_oversubscription() const noexcept;
+
+    /**
+     * Read "groups" value: number of groups of a Dragonfly topology
+     *
+     * @return groups (0 if not given)
+     */
+    [[nodiscard]] int get_groups() const noexcept;
+
+    /**
+     * Read "routers_per_group" value: number of routers per group of a Dragonfly topology
+     *
+     * @return routers per group (0 if not given)
+     */
+    [[nodiscard]] int get_routers_per_group() const noexcept;
+
+    /**
+     * Read "global_links_per_router" value: number of global links per router of a Dragonfly topology
+     *
+     * @return global links per router (0 if not given)
+     */
+    [[nodiscard]] int get_global_links_per_router() const noexcept;
+
+    /**
+     * Read "arrangement" value: global link arrangement of a Dragonfly topology (Absolute if not given)
+     *
+     * @return global link arrangement
+     */
+    [[nodiscard]] DragonflyArrangement get_dragonfly_arrangement() const noexcept;
+
+    /**
+     * Read "routing" value: routing of a Dragonfly topology (Minimal if not given)
+     *
+     * @return routing
+     */
+    [[nodiscard]] DragonflyRouting get_dragonfly_routing() const noexcept;
 
   private:
     /// number of network dimensions
@@ -85,6 +162,39 @@ class NetworkParser {
     /// topology building block per each dimension
     std::vector<TopologyBuildingBlock> topology_per_dim;
 
+    /// how the congestion-unaware backend charges multi-dimension transfers
+    MultiDimSendMode multi_dim_send_mode;
+
+    /// NPUs count per each axis of a TorusND or MeshND topology
+    std::vector<int> shape;
+
+    /// wraparound per each axis of a TorusND or MeshND topology
+    std::vector<bool> wraparound;
+
+    /// ports per switch of a FatTree topology
+    int radix;
+
+    /// switch tiers of a FatTree topology
+    int tiers;
+
+    /// ratio of endpoints to uplinks of a FatTree leaf switch
+    int oversubscription;
+
+    /// groups of a Dragonfly topology
+    int groups;
+
+    /// routers per group of a Dragonfly topology
+    int routers_per_group;
+
+    /// global links per router of a Dragonfly topology
+    int global_links_per_router;
+
+    /// global link arrangement of a Dragonfly topology
+    DragonflyArrangement dragonfly_arrangement;
+
+    /// routing of a Dragonfly topology
+    DragonflyRouting dragonfly_routing;
+
     /**
      * Parse topology name (in string) into TopologyBuildingBlock enum
      *
@@ -94,6 +204,33 @@ class NetworkParser {
      */
     [[nodiscard]] static TopologyBuildingBlock parse_topology_name(const std::string& topology_name) noexcept;
 
+    /**
+     * Parse multi-dimension send mode name (in string) into MultiDimSendMode enum
+     *
+     * @param mode_name mode name in string
+     *    which can be "FirstDim", "Accumulate", or "Pipelined"
+     * @return parsed MultiDimSendMode enum class value
+     */
+    [[nodiscard]] static MultiDimSendMode parse_multi_dim_send_mode(const std::string& mode_name) noexcept;
+
+    /**
+     * Parse Dragonfly arrangement name (in string) into DragonflyArrangement enum
+     *
+     * @param arrangement_name arrangement name in string
+     *    which can be "Absolute", "Relative", or "Circulant"
+     * @return parsed DragonflyArrangement enum class value
+     */
+    [[nodiscard]] static DragonflyArrangement parse_dragonfly_arrangement(const std::string& arrangement_name) noexcept;
+
+    /**
+     * Parse Dragonfly routing name (in string) into DragonflyRouting enum
+     *
+     * @param routing_name routing name in string
+     *    which can be "Minimal", "Valiant", or "UGAL"
+     * @return parsed DragonflyRouting enum class value
+     */
+    [[nodiscard]] static DragonflyRouting parse_dragonfly_routing(const std::string& routing_name) noexcept;
+
     /**
      * Parse the given YAML node and retrieve network configuration values
      *
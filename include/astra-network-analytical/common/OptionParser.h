@@ -0,0 +1,41 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include <charconv>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <system_error>
+
+namespace NetworkAnalytical {
+
+/**
+ * Parse the value of a numeric command-line option,
+ * printing the usage and exiting if it is not a number of type T.
+ *
+ * @param program program name
+ * @param option option the value belongs to
+ * @param value value to parse
+ * @param number parsed value
+ * @param print_usage prints the usage of the program
+ */
+template <typename T>
+void parse_number(const char* const program,
+                  const std::string& option,
+                  const std::string& value,
+                  T& number,
+                  void (*const print_usage)(const char*)) {
+    const auto* const value_end = value.data() + value.size();
+    const auto [parsed_end, error] = std::from_chars(value.data(), value_end, number);
+    if (error != std::errc() || parsed_end != value_end) {
+        std::cerr << "[Error] (network/analytical) " << "invalid value '" << value << "' for " << option << std::endl;
+        print_usage(program);
+        std::exit(-1);
+    }
+}
+
+}  // namespace NetworkAnalytical
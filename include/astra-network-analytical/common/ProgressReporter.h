@@ -0,0 +1,156 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/Type.h"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+namespace NetworkAnalytical {
+
+/**
+ * A snapshot of simulation progress.
+ */
+struct ProgressSample {
+    /// current simulated time in ns
+    EventTime simulated_time;
+
+    /// wall time since the reporter was created, in seconds
+    double wall_time;
+
+    /// number of events invoked so far
+    uint64_t events_count;
+
+    /// events invoked per wall-clock second since the previous sample
+    double events_per_second;
+
+    /// number of events scheduled but not yet invoked
+    uint64_t pending_events_count;
+
+    /// number of chunks in flight (0 if no counter is set)
+    uint64_t chunks_in_flight;
+};
+
+/**
+ * ProgressReporter samples simulation progress while the EventQueue proceeds,
+ * every N invoked events or every T wall-clock seconds, whichever comes first.
+ * Each sample is handed to a callback, which prints it by default,
+ * and to an optional stop condition, which ends the run early (EventQueue::finished() turns true).
+ *
+ * e.g., with the congestion_aware backend:
+ *   auto reporter = std::make_shared<ProgressReporter>(1'000'000, 5.0);
+ *   reporter->set_chunks_in_flight_counter(Chunk::get_chunks_in_flight);
+ *   event_queue->set_progress_reporter(reporter);
+ */
+class ProgressReporter {
+  public:
+    /// callback invoked with every sample
+    using ProgressCallback = std::function<void(const ProgressSample&)>;
+
+    /// source of the number of chunks in flight
+    using ChunksInFlightCounter = std::function<uint64_t()>;
+
+    /// condition checked with every sample, true to stop the run
+    using StopCondition = std::function<bool(const ProgressSample&)>;
+
+    /**
+     * Print a sample to stdout.
+     *
+     * @param sample sample to print
+     */
+    static void print_sample(const ProgressSample& sample) noexcept;
+
+    /**
+     * Constructor.
+     *
+     * @param events_interval sample every this many invoked events (0 to disable)
+     * @param wall_time_interval sample every this many wall-clock seconds (0 to disable)
+     * @param callback callback invoked with every sample
+     */
+    ProgressReporter(uint64_t events_interval,
+                     double wall_time_interval,
+                     ProgressCallback callback = print_sample) noexcept;
+
+    /**
+     * Set the source of the number of chunks in flight.
+     *
+     * @param chunks_in_flight_counter function returning the number of chunks in flight
+     */
+    void set_chunks_in_flight_counter(ChunksInFlightCounter chunks_in_flight_counter) noexcept;
+
+    /**
+     * Set the condition checked with every sample to stop the run early.
+     *
+     * @param stop_condition function returning true if the run should stop
+     */
+    void set_stop_condition(StopCondition stop_condition) noexcept;
+
+    /**
+     * Check whether a sample met the stop condition.
+     * Checked by EventQueue::proceed().
+     *
+     * @return true if the run should stop, false otherwise
+     */
+    [[nodiscard]] bool stop_requested() const noexcept;
+
+    /**
+     * Notify the reporter that the EventQueue proceeded.
+     * Invoked by EventQueue::proceed().
+     *
+     * @param simulated_time current simulated time
+     * @param events_count number of events invoked so far
+     * @param pending_events_count number of events still scheduled
+     */
+    void on_proceed(EventTime simulated_time, uint64_t events_count, uint64_t pending_events_count) noexcept;
+
+    /**
+     * Take a sample now, regardless of the intervals (e.g., at the end of a run).
+     *
+     * @param simulated_time current simulated time
+     * @param events_count number of events invoked so far
+     * @param pending_events_count number of events still scheduled
+     */
+    void sample(EventTime simulated_time, uint64_t events_count, uint64_t pending_events_count) noexcept;
+
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    /// number of proceeds between two wall clock reads
+    static constexpr uint64_t wall_time_check_period = 256;
+
+    /// sample every this many invoked events (0 if disabled)
+    uint64_t events_interval;
+
+    /// sample every this many wall-clock seconds (0 if disabled)
+    double wall_time_interval;
+
+    /// callback invoked with every sample
+    ProgressCallback callback;
+
+    /// source of the number of chunks in flight
+    ChunksInFlightCounter chunks_in_flight_counter;
+
+    /// condition checked with every sample (none if not set)
+    StopCondition stop_condition;
+
+    /// whether a sample met the stop condition
+    bool stopped;
+
+    /// time the reporter was created
+    Clock::time_point start_time;
+
+    /// wall time of the previous sample
+    Clock::time_point last_sample_time;
+
+    /// events count at the previous sample
+    uint64_t last_sample_events_count;
+
+    /// number of proceeds since the last wall clock read
+    uint64_t proceeds_since_wall_time_check;
+};
+
+}  // namespace NetworkAnalytical
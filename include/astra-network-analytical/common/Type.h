@@ -44,9 +44,47 @@ enum class TopologyBuildingBlock {
     HyperCube,
     Torus2D,
     Mesh2D,
-    KingMesh2D
+    KingMesh2D,
+    TorusND,
+    MeshND,
+    FatTree,
+    Dragonfly
 };
 
+/// How the congestion-unaware backend charges a chunk crossing multiple dimensions
+enum class MultiDimSendMode {
+    FirstDim,    ///< only the lowest dimension where src and dest differ
+    Accumulate,  ///< store-and-forward: latency and serialization of every crossed dimension
+    Pipelined    ///< cut-through: latency of every crossed dimension, serialized once on the slowest one
+};
+
+/// How a Dragonfly spreads the global links of a group over the other groups
+enum class DragonflyArrangement {
+    Absolute,  ///< global port j of every group links to group j (skipping itself)
+    Relative,  ///< global port j of group g links to group g + j + 1
+    Circulant  ///< global ports link to groups g + 1, g - 1, g + 2, g - 2, ...
+};
+
+/// How a Dragonfly routes a chunk
+enum class DragonflyRouting {
+    Minimal,  ///< at most one global link
+    Valiant,  ///< through a random intermediate group (or router, within a group)
+    UGAL      ///< Minimal or Valiant, whichever has the shorter link queues weighted by hops
+};
+
+/// Queueing term the congestion-unaware backend adds for the recently offered load
+enum class CongestionModel {
+    None,           ///< no queueing term
+    MD1,            ///< M/D/1 waiting time at every hop
+    BandwidthShare  ///< serialization at the bandwidth left over by the load
+};
+
+/// Collective communication operations
+enum class CollectiveOperation { AllReduce, AllGather, ReduceScatter, AllToAll, Broadcast };
+
+/// Collective communication algorithms
+enum class CollectiveAlgorithm { Ring, Direct, HalvingDoubling, DoubleBinaryTree, Hierarchical };
+
 /// Multi-dimensional address of a device.
 /// Each NPU ID can be broken down into multiple dimensions.
 /// for example, if the topology size is [2, 8, 4] and the NPU ID is 31,
@@ -6,7 +6,9 @@ LICENSE file in the root directory of this source tree.
 #pragma once
 
 #include "common/Type.h"
+#include "congestion_aware/IntrusiveList.h"
 #include "congestion_aware/Type.h"
+#include <cstdint>
 #include <memory>
 
 using namespace NetworkAnalytical;
@@ -16,11 +18,13 @@ namespace NetworkAnalyticalCongestionAware {
 /**
  * Chunk class represents a chunk.
  * Chunk is a basic unit of transmission.
+ * While a link transmits the chunk, the chunk is linked into the link's list of chunks in transmission.
  */
-class Chunk {
+class Chunk : public IntrusiveListNode<Chunk> {
   public:
     /**
      * Callback to be invoked when a chunk arrives at the next device.
+     * The chunk leaves the list of chunks in transmission of the link it came through.
      *   - if the chunk arrived at its destination, the final callback is invoked
      *   - if not, the chunk is sent to the next device as designated by the route
      *
@@ -38,6 +42,22 @@ class Chunk {
      */
     Chunk(ChunkSize chunk_size, Route route, Callback callback, CallbackArg callback_arg) noexcept;
 
+    /**
+     * Destructor.
+     */
+    ~Chunk() noexcept;
+
+    Chunk(const Chunk&) = delete;
+    Chunk& operator=(const Chunk&) = delete;
+
+    /**
+     * Get the number of chunks in flight,
+     * i.e., chunks created but not yet arrived at their destination.
+     *
+     * @return number of chunks in flight
+     */
+    [[nodiscard]] static uint64_t get_chunks_in_flight() noexcept;
+
     /**
      * Get the current sitting device of the chunk
      *
@@ -73,6 +93,21 @@ class Chunk {
      */
     [[nodiscard]] ChunkSize get_size() const noexcept;
 
+    /**
+     * Get the id of the chunk.
+     * Ids are assigned in creation order, starting from 0.
+     *
+     * @return id of the chunk
+     */
+    [[nodiscard]] uint64_t get_id() const noexcept;
+
+    /**
+     * Get the remaining route of the chunk, starting from its current device.
+     *
+     * @return remaining route of the chunk
+     */
+    [[nodiscard]] const Route& get_route() const noexcept;
+
     /**
      * Invoke the registered callback
      * i.e., this method should be called when the chunk arrives its destination.
@@ -80,6 +115,15 @@ class Chunk {
     void invoke_callback() noexcept;
 
   private:
+    /// id to assign to the next created chunk
+    static uint64_t next_chunk_id;
+
+    /// number of chunks alive
+    static uint64_t chunks_in_flight;
+
+    /// id of the chunk
+    uint64_t chunk_id;
+
     /// size of the chunk
     ChunkSize chunk_size;
 
@@ -0,0 +1,121 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/Type.h"
+#include "congestion_aware/Type.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionAware {
+
+/// whether Link records chunk transmissions (NETWORK_BACKEND_ENABLE_CHUNK_TRACE CMake option);
+/// when false, the tracing code is compiled out of the hot path
+#ifdef NETWORK_BACKEND_ENABLE_CHUNK_TRACE
+constexpr bool chunk_trace_enabled = true;
+#else
+constexpr bool chunk_trace_enabled = false;
+#endif
+
+/**
+ * A single chunk transmission over a link.
+ */
+struct ChunkTraceRecord {
+    /// link that transmitted the chunk
+    const Link* link;
+
+    /// id of the chunk
+    uint64_t chunk_id;
+
+    /// size of the chunk
+    ChunkSize chunk_size;
+
+    /// time the link started serializing the chunk
+    EventTime start_time;
+
+    /// time the link finished serializing the chunk
+    EventTime end_time;
+
+    /// time the chunk waited in the link's pending queue
+    EventTime queueing_delay;
+};
+
+/**
+ * Endpoints of a link, used to name its track in the trace.
+ */
+struct LinkTrack {
+    DeviceId src;
+    DeviceId dest;
+    int dim;
+};
+
+/**
+ * ChunkTracer records chunk transmissions into a preallocated ring buffer,
+ * and writes them out as a Chrome trace (viewable in Perfetto or chrome://tracing).
+ * Once the buffer is full, the oldest records are overwritten.
+ */
+class ChunkTracer {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param capacity maximum number of records kept
+     */
+    explicit ChunkTracer(size_t capacity) noexcept;
+
+    /**
+     * Record a chunk transmission.
+     *
+     * @param record transmission to record
+     */
+    void record(const ChunkTraceRecord& record) noexcept;
+
+    /**
+     * Get the number of records currently kept.
+     *
+     * @return number of records kept
+     */
+    [[nodiscard]] size_t get_records_count() const noexcept;
+
+    /**
+     * Get the number of records overwritten because the buffer was full.
+     *
+     * @return number of dropped records
+     */
+    [[nodiscard]] uint64_t get_dropped_count() const noexcept;
+
+    /**
+     * Drop all records.
+     */
+    void clear() noexcept;
+
+    /**
+     * Write the records as a Chrome trace JSON file.
+     * Each network dimension is a process and each link is a thread (track) within it.
+     *
+     * @param path path of the output file
+     * @param link_tracks endpoints of every link that may appear in the records
+     */
+    void write_chrome_trace(const std::string& path,
+                            const std::unordered_map<const Link*, LinkTrack>& link_tracks) const noexcept;
+
+  private:
+    /// preallocated ring buffer of records
+    std::vector<ChunkTraceRecord> records;
+
+    /// index the next record is written to
+    size_t next_index;
+
+    /// total number of records ever written
+    uint64_t recorded_count;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
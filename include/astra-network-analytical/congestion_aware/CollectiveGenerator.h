@@ -0,0 +1,162 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/Type.h"
+#include "congestion_aware/DagExecutor.h"
+#include "congestion_aware/Topology.h"
+#include <memory>
+#include <utility>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionAware {
+
+/**
+ * Sends of a collective and their dependencies, to be run by a DagExecutor.
+ */
+struct CollectiveSchedule {
+    /// sends of the collective
+    std::vector<DagNode> nodes;
+
+    /// dependencies as (predecessor, successor) node indices
+    std::vector<std::pair<int, int>> edges;
+};
+
+/**
+ * CollectiveGenerator emits the chunk schedule of a collective over all NPUs of a congestion-aware topology.
+ *
+ * The algorithms follow the congestion-unaware CollectiveModel step by step,
+ * so both backends agree on uncontended topologies, while the congestion-aware run
+ * adds the contention the closed form ignores.
+ * Within a schedule, a send of an NPU waits for every send the NPU received since its previous sends:
+ * an NPU forwards (or reduces) data once it has arrived, without a global barrier between steps.
+ *
+ * The per-NPU buffer is split into chunks_count chunks, each running the whole algorithm.
+ * At most pipeline_depth chunks are in flight: an NPU starts chunk c
+ * once it received the last send of chunk (c - pipeline_depth).
+ *
+ * The collective size is the per-NPU buffer size:
+ * the input of AllReduce, ReduceScatter, and AllToAll, and the output of AllGather.
+ */
+class CollectiveGenerator {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param topology topology to run collectives on
+     * @param chunks_count number of chunks the buffer is split into
+     * @param pipeline_depth maximum number of chunks in flight
+     */
+    explicit CollectiveGenerator(std::shared_ptr<const Topology> topology,
+                                 int chunks_count = 1,
+                                 int pipeline_depth = 1) noexcept;
+
+    /**
+     * Generate the schedule of a collective over all NPUs.
+     * Ring, Direct, HalvingDoubling, and DoubleBinaryTree run flat over all NPUs;
+     * Hierarchical runs Ring on each dimension in turn.
+     *
+     * @param operation collective operation (Broadcast is not supported)
+     * @param algorithm collective algorithm
+     * @param collective_size per-NPU buffer size
+     * @return schedule of the collective
+     */
+    [[nodiscard]] CollectiveSchedule generate(CollectiveOperation operation,
+                                              CollectiveAlgorithm algorithm,
+                                              ChunkSize collective_size) const noexcept;
+
+    /**
+     * Generate the schedule of a hierarchical collective,
+     * which runs one algorithm per dimension, dimension by dimension.
+     * AllReduce is ReduceScatter from the lowest to the highest dimension
+     * followed by AllGather from the highest to the lowest dimension.
+     *
+     * @param operation collective operation (Broadcast is not supported)
+     * @param algorithm_per_dim algorithm of each dimension (Hierarchical and DoubleBinaryTree are not allowed)
+     * @param collective_size per-NPU buffer size
+     * @return schedule of the collective
+     */
+    [[nodiscard]] CollectiveSchedule generate_hierarchical(CollectiveOperation operation,
+                                                           const std::vector<CollectiveAlgorithm>& algorithm_per_dim,
+                                                           ChunkSize collective_size) const noexcept;
+
+  private:
+    /**
+     * NPUs taking part in a single-level collective:
+     * NPU (base + index * stride) for index in [0, npus_count), for every base in bases.
+     */
+    struct Group {
+        /// number of NPUs in the group
+        int npus_count;
+
+        /// distance of adjacent group members in the NPU ID space
+        DeviceId stride;
+
+        /// first member of every instance of the group
+        std::vector<DeviceId> bases;
+    };
+
+    class LaneBuilder;
+
+    /// topology to run collectives on
+    std::shared_ptr<const Topology> topology;
+
+    /// number of chunks the buffer is split into
+    int chunks_count;
+
+    /// maximum number of chunks in flight
+    int pipeline_depth;
+
+    /// group of all NPUs
+    Group flat_group;
+
+    /// groups of each dimension
+    std::vector<Group> group_per_dim;
+
+    /**
+     * Generate a schedule whose chunks are made of lanes_per_chunk lanes,
+     * each emitted by emit_lane(builder, lane_index_within_chunk, chunk_size).
+     *
+     * @param lanes_per_chunk number of lanes of a chunk
+     * @param emit_lane function emitting the sends of a lane
+     * @param collective_size per-NPU buffer size
+     * @return schedule of the collective
+     */
+    template <typename EmitLane>
+    [[nodiscard]] CollectiveSchedule generate_lanes(int lanes_per_chunk,
+                                                    const EmitLane& emit_lane,
+                                                    ChunkSize collective_size) const noexcept;
+
+    /**
+     * Emit a single-level collective over a group.
+     *
+     * @param builder lane to emit the sends into
+     * @param group NPUs taking part in the collective
+     * @param operation collective operation
+     * @param algorithm collective algorithm (Hierarchical and DoubleBinaryTree are not allowed)
+     * @param collective_size per-NPU buffer size
+     */
+    void emit_group(LaneBuilder& builder,
+                    const Group& group,
+                    CollectiveOperation operation,
+                    CollectiveAlgorithm algorithm,
+                    double collective_size) const noexcept;
+
+    /**
+     * Emit one of the two trees of a DoubleBinaryTree AllReduce over a group:
+     * a reduction to the root followed by a broadcast back.
+     *
+     * @param builder lane to emit the sends into
+     * @param group NPUs taking part in the collective
+     * @param tree 0 for the in-order tree over the members, 1 for the same tree shifted by one member
+     * @param tree_size size carried by the tree
+     */
+    void emit_tree(LaneBuilder& builder, const Group& group, int tree, double tree_size) const noexcept;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
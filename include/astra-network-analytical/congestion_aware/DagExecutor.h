@@ -0,0 +1,172 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/EventQueue.h"
+#include "common/Type.h"
+#include "congestion_aware/Topology.h"
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionAware {
+
+/**
+ * A send of a dependency DAG.
+ * src == dest makes a local node: it completes as soon as it is released, without using the network
+ * (e.g., to join several dependencies, or to model a computation through `delay`).
+ */
+struct DagNode {
+    /// source NPU
+    DeviceId src;
+
+    /// destination NPU
+    DeviceId dest;
+
+    /// size of the send
+    ChunkSize bytes;
+
+    /// delay between the completion of the last dependency and the issue of the send (ns)
+    EventTime delay = 0;
+};
+
+/**
+ * DagExecutor runs a DAG of dependent sends on a congestion-aware topology:
+ * a node is issued once every node it depends on completed (i.e., its chunk arrived).
+ *
+ * Dependencies are an edge list (predecessor, successor) compacted into CSR arrays at construction.
+ * Every per-node structure is preallocated there, so running the DAG allocates nothing per node
+ * besides the Chunk the backend creates for each send.
+ *
+ * e.g., step k + 1 of NPU i waits for step k of NPU (i - 1):
+ *   edges.emplace_back(step_k_node_of(i - 1), step_k_plus_1_node_of(i));
+ */
+class DagExecutor {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param topology topology to run the DAG on
+     * @param event_queue event queue the topology runs on
+     * @param nodes sends of the DAG
+     * @param edges dependencies as (predecessor, successor) node indices; should be acyclic
+     */
+    DagExecutor(std::shared_ptr<Topology> topology,
+                std::shared_ptr<EventQueue> event_queue,
+                std::vector<DagNode> nodes,
+                const std::vector<std::pair<int, int>>& edges) noexcept;
+
+    /**
+     * Release every node without dependencies.
+     * The rest is released as the simulation proceeds.
+     */
+    void start() noexcept;
+
+    /**
+     * Check whether every node completed.
+     *
+     * @return true if the DAG is done, false otherwise
+     */
+    [[nodiscard]] bool finished() const noexcept;
+
+    /**
+     * Get the number of completed nodes.
+     *
+     * @return number of completed nodes
+     */
+    [[nodiscard]] int get_completed_count() const noexcept;
+
+    /**
+     * Get the completion time of a node.
+     *
+     * @param node node index
+     * @return completion time of the node (0 if not completed yet)
+     */
+    [[nodiscard]] EventTime get_completion_time(int node) const noexcept;
+
+  private:
+    /// topology to run the DAG on
+    std::shared_ptr<Topology> topology;
+
+    /// event queue the topology runs on
+    std::shared_ptr<EventQueue> event_queue;
+
+    /// sends of the DAG
+    std::vector<DagNode> nodes;
+
+    /// successors of node i are successors[successor_offsets[i] .. successor_offsets[i + 1])
+    std::vector<int> successor_offsets;
+    std::vector<int> successors;
+
+    /// number of dependencies of each node not completed yet
+    std::vector<int> pending_dependencies_count;
+
+    /// completion time of each node
+    std::vector<EventTime> completion_times;
+
+    /// callback argument of each node: every entry points to this executor,
+    /// and the node index is the entry's offset within the array
+    std::vector<DagExecutor*> node_contexts;
+
+    /// nodes released but not issued yet, in release order (each node enters once)
+    std::vector<int> ready_queue;
+    size_t ready_queue_head;
+    size_t ready_queue_tail;
+
+    /// number of completed nodes
+    int completed_count;
+
+    /**
+     * Callback of a node whose delay elapsed.
+     *
+     * @param node_context_ptr pointer to the node's entry of node_contexts
+     */
+    static void node_ready(void* node_context_ptr) noexcept;
+
+    /**
+     * Callback of a node whose chunk arrived.
+     *
+     * @param node_context_ptr pointer to the node's entry of node_contexts
+     */
+    static void node_completed(void* node_context_ptr) noexcept;
+
+    /**
+     * Get the node index of a callback argument.
+     *
+     * @param node_context_ptr pointer to the node's entry of node_contexts
+     * @return executor and node index
+     */
+    [[nodiscard]] static std::pair<DagExecutor*, int> decode(void* node_context_ptr) noexcept;
+
+    /**
+     * Release a node whose dependencies completed: queue it, or schedule it after its delay.
+     *
+     * @param node node index
+     */
+    void release(int node) noexcept;
+
+    /**
+     * Mark a node completed, releasing its successors.
+     *
+     * @param node node index
+     */
+    void complete(int node) noexcept;
+
+    /**
+     * Issue every queued node.
+     */
+    void issue_ready_nodes() noexcept;
+
+    /**
+     * Check that the DAG is acyclic (Kahn's algorithm over the CSR arrays).
+     */
+    void check_acyclic() const noexcept;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
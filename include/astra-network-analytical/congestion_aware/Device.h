@@ -51,13 +51,21 @@ class Device {
      */
     void connect(DeviceId id, Bandwidth bandwidth, Latency latency) noexcept;
 
-  private:
-    /// device Id
-    DeviceId device_id;
+    /**
+     * Connect a device to another device through an existing link.
+     * Several destinations may share a link, and then share its transmission queue.
+     *
+     * @param id id of the device to connect this device to
+     * @param link link to send through
+     */
+    void connect(DeviceId id, std::shared_ptr<Link> link) noexcept;
 
-    /// links to other nodes
-    /// map[dest node node_id] -> link
-    std::map<DeviceId, std::shared_ptr<Link>> links;
+    /**
+     * Get the outgoing links of the device.
+     *
+     * @return map[dest device id] -> link
+     */
+    [[nodiscard]] const std::map<DeviceId, std::shared_ptr<Link>>& get_links() const noexcept;
 
     /**
      * Check if this device is connected to another device.
@@ -66,6 +74,19 @@ class Device {
      * @return true if connected to the given device, false otherwise
      */
     [[nodiscard]] bool connected(DeviceId dest) const noexcept;
+
+    /**
+     * Return every outgoing link to its idle state.
+     */
+    void reset() noexcept;
+
+  private:
+    /// device Id
+    DeviceId device_id;
+
+    /// links to other nodes
+    /// map[dest node node_id] -> link
+    std::map<DeviceId, std::shared_ptr<Link>> links;
 };
 
 }  // namespace NetworkAnalyticalCongestionAware
@@ -0,0 +1,109 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/DragonflyLayout.h"
+#include "common/Type.h"
+#include "congestion_aware/BasicTopology.h"
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionAware {
+
+/**
+ * Implements a Dragonfly topology: groups of fully-connected routers, linked by global links.
+ * Each NPU links to its router, and the arrangement picks the group each global link goes to
+ * (see DragonflyLayout for the numbering of NPUs, routers, and global ports).
+ *
+ * Dragonfly(groups=3, routers_per_group=2, global_links_per_router=1, npus_per_router=1) example:
+ *   0   1     2   3     4    5     <- NPUs
+ *   |   |     |   |     |    |
+ *   6 - 7     8 - 9     10 - 11    <- routers of groups 0, 1, and 2
+ * with global links 6 - 8, 7 - 10, and 9 - 11 in the Absolute arrangement.
+ *
+ * Routing is one of
+ *  - Minimal: at most one global link,
+ *  - Valiant: through a random intermediate group (or router, within a group),
+ *  - UGAL: Minimal or Valiant, whichever has the smaller (queue length + 1) * hops
+ *    at the first link between routers (the output queue of the src router).
+ * Random choices are picked by a hash of (src, dest, chunk_id), and routing decisions never allocate.
+ */
+class Dragonfly final : public BasicTopology {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param groups number of groups
+     * @param routers_per_group number of routers per group
+     * @param global_links_per_router number of global links per router
+     * @param npus_per_router number of NPUs per router
+     * @param arrangement how the global links of a group spread over the other groups
+     * @param routing how chunks are routed
+     * @param bandwidth bandwidth of link
+     * @param latency latency of link
+     * @param faulty_links list of faulty links as tuples (src, dst, weight)
+     */
+    Dragonfly(int groups,
+              int routers_per_group,
+              int global_links_per_router,
+              int npus_per_router,
+              DragonflyArrangement arrangement,
+              DragonflyRouting routing,
+              Bandwidth bandwidth,
+              Latency latency,
+              const std::vector<std::tuple<int, int, double>>& faulty_links = {}) noexcept;
+
+    /**
+     * Implementation of route function in Topology.
+     * Takes the route of chunk 0.
+     */
+    [[nodiscard]] Route route(DeviceId src, DeviceId dest) const noexcept override;
+
+    /**
+     * Implementation of route_chunk function in Topology.
+     */
+    [[nodiscard]] Route route_chunk(DeviceId src, DeviceId dest, uint64_t chunk_id) const noexcept override;
+
+    /**
+     * Write the route of a chunk as device IDs, without allocating.
+     *
+     * @param src src NPU id
+     * @param dest dest NPU id
+     * @param chunk_id id of the chunk
+     * @param route buffer of DragonflyLayout::max_route_length device IDs the route is written into
+     * @return number of devices on the route
+     */
+    [[nodiscard]] int route_device_ids(DeviceId src, DeviceId dest, uint64_t chunk_id, DeviceId* route) const noexcept;
+
+    /**
+     * Implementation of get_connection_policies function in BasicTopology.
+     */
+    [[nodiscard]] std::vector<ConnectionPolicy> get_connection_policies() const noexcept override;
+
+  private:
+    /// numbering and arithmetic routes of the NPUs and routers
+    DragonflyLayout layout;
+
+    /// how chunks are routed
+    DragonflyRouting routing;
+
+    /// number of NPUs per router
+    int npus_per_router;
+
+    /**
+     * Get the UGAL cost of a route: (queue length + 1) * hops at the first link between routers.
+     *
+     * @param route device IDs of the route
+     * @param length number of devices on the route
+     * @return UGAL cost of the route
+     */
+    [[nodiscard]] size_t ugal_cost(const DeviceId* route, int length) const noexcept;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
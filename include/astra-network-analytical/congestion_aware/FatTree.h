@@ -0,0 +1,128 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/Type.h"
+#include "congestion_aware/BasicTopology.h"
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionAware {
+
+/**
+ * Implements a k-ary fat-tree (folded Clos) of switches with the given radix and tiers.
+ *
+ * Switches of the upper tiers have k = radix / 2 down and k up ports (the top tier only k down ports).
+ * A leaf switch (tier 0) splits its radix into endpoints and uplinks by the oversubscription ratio:
+ * radix * o / (o + 1) NPUs and radix / (o + 1) uplinks, so o = 1 gives a full-bisection fat-tree.
+ * A single-tier fat-tree is a single switch of radix NPUs.
+ *
+ * Leaves are numbered by (tiers - 1) base-k digits, and so are the switches of the upper tiers,
+ * except for digit 0, which ranges over the leaf uplinks.
+ * Going up from tier t to tier t + 1 changes digit t of the switch, and going down changes it back,
+ * so routes are computed arithmetically: up to the lowest common tier, then down.
+ *
+ * FatTree(radix=4, tiers=2) example:
+ *   6     7        <- tier 1
+ *   | \ / |
+ *   | / \ |
+ *   4     5        <- tier 0 (leaves)
+ *  / \   / \
+ * 0   1 2   3      <- NPUs
+ *
+ * Switch IDs follow the NPU IDs, contiguous and tier by tier.
+ * Equal-cost routes are picked by a hash of (src, dest, chunk_id) (ECMP).
+ */
+class FatTree final : public BasicTopology {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param radix number of ports per switch
+     * @param tiers number of switch tiers
+     * @param oversubscription ratio of endpoints to uplinks of a leaf switch
+     * @param bandwidth bandwidth of link
+     * @param latency latency of link
+     * @param faulty_links list of faulty links as tuples (src, dst, weight)
+     */
+    FatTree(int radix,
+            int tiers,
+            int oversubscription,
+            Bandwidth bandwidth,
+            Latency latency,
+            const std::vector<std::tuple<int, int, double>>& faulty_links = {}) noexcept;
+
+    /**
+     * Implementation of route function in Topology.
+     * Takes the equal-cost route of chunk 0.
+     */
+    [[nodiscard]] Route route(DeviceId src, DeviceId dest) const noexcept override;
+
+    /**
+     * Implementation of route_chunk function in Topology.
+     */
+    [[nodiscard]] Route route_chunk(DeviceId src, DeviceId dest, uint64_t chunk_id) const noexcept override;
+
+    /**
+     * Implementation of get_connection_policies function in BasicTopology.
+     */
+    [[nodiscard]] std::vector<ConnectionPolicy> get_connection_policies() const noexcept override;
+
+    /**
+     * Get the number of NPUs of a fat-tree, without constructing it.
+     *
+     * @param radix number of ports per switch
+     * @param tiers number of switch tiers
+     * @param oversubscription ratio of endpoints to uplinks of a leaf switch
+     * @return number of NPUs
+     */
+    [[nodiscard]] static int compute_npus_count(int radix, int tiers, int oversubscription) noexcept;
+
+    /**
+     * Get the number of switches of a fat-tree, without constructing it.
+     *
+     * @param radix number of ports per switch
+     * @param tiers number of switch tiers
+     * @param oversubscription ratio of endpoints to uplinks of a leaf switch
+     * @return number of switches
+     */
+    [[nodiscard]] static int compute_switches_count(int radix, int tiers, int oversubscription) noexcept;
+
+  private:
+    /// number of switch tiers
+    int tiers;
+
+    /// arity of the upper tiers (radix / 2)
+    int arity;
+
+    /// NPUs per leaf switch
+    int leaf_npus_count;
+
+    /// uplinks per leaf switch
+    int leaf_uplinks_count;
+
+    /// device ID of the first switch of each tier
+    std::vector<DeviceId> first_switch_per_tier;
+
+    /// weight of each digit above digit 0 (arity^(digit - 1)), indexed by digit - 1
+    std::vector<int> digit_weights;
+
+    /**
+     * Get the device ID of a switch.
+     * Digit 0 of the switch is low, and the digits above it form high.
+     *
+     * @param tier tier of the switch
+     * @param low digit 0 of the switch
+     * @param high digits above digit 0 of the switch
+     * @return device ID of the switch
+     */
+    [[nodiscard]] DeviceId switch_id(int tier, int low, int high) const noexcept;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
@@ -6,6 +6,7 @@ LICENSE file in the root directory of this source tree.
 #pragma once
 
 #include "common/NetworkParser.h"
+#include "congestion_aware/BasicTopology.h"
 #include "congestion_aware/Topology.h"
 #include <memory>
 
@@ -17,9 +18,36 @@ namespace NetworkAnalyticalCongestionAware {
  * Construct a topology from a NetworkParser.
  *
  * @param network_parser NetworkParser to parse the network input file
+ * @param threads_count number of threads used to build a multi-dimensional topology
+ * @param lazy_links if true, links of a multi-dimensional topology are instantiated the first time a chunk crosses them
  * @return pointer to the constructed topology
  */
-[[nodiscard]] std::shared_ptr<Topology> construct_topology(const NetworkParser& network_parser) noexcept;
+[[nodiscard]] std::shared_ptr<Topology> construct_topology(const NetworkParser& network_parser,
+                                                           int threads_count = 1,
+                                                           bool lazy_links = false) noexcept;
+
+/**
+ * Construct a BasicTopology to be used as one dimension of a MultiDimTopology.
+ *
+ * @param topology_type building block of the dimension
+ * @param npus_count number of NPUs in the dimension
+ * @param bandwidth bandwidth of each link in the dimension
+ * @param latency latency of each link in the dimension
+ * @return pointer to the constructed dimension
+ */
+[[nodiscard]] std::unique_ptr<BasicTopology> construct_dim_topology(TopologyBuildingBlock topology_type,
+                                                                    int npus_count,
+                                                                    Bandwidth bandwidth,
+                                                                    Latency latency) noexcept;
+
+/**
+ * Construct a topology from a snapshot file written by MultiDimTopology::save_snapshot.
+ * Connection policies are not expanded again: links are restored as saved.
+ *
+ * @param path path of the snapshot file
+ * @return pointer to the restored topology
+ */
+[[nodiscard]] std::shared_ptr<Topology> construct_topology_from_snapshot(const std::string& path) noexcept;
 
 [[nodiscard]] std::vector<std::pair<MultiDimAddress, MultiDimAddress>> generateAddressPairs(
     const MultiDimAddress& upper, const ConnectionPolicy& policy, int dim) noexcept;
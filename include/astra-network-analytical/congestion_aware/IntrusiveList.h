@@ -0,0 +1,81 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include <cassert>
+
+namespace NetworkAnalyticalCongestionAware {
+
+/**
+ * IntrusiveListNode links an object into a doubly-linked list through the object itself,
+ * so that tracking it never allocates.
+ * A list is a plain head pointer (T*), nullptr when empty.
+ *
+ * T derives from IntrusiveListNode<T>; an object unlinks itself in O(1), and on destruction.
+ */
+template <typename T>
+class IntrusiveListNode {
+  public:
+    IntrusiveListNode(const IntrusiveListNode&) = delete;
+    IntrusiveListNode& operator=(const IntrusiveListNode&) = delete;
+
+    /**
+     * Link the object at the front of a list.
+     *
+     * @param head head of the list
+     */
+    void link_into(T*& head) noexcept {
+        assert(!linked());
+
+        next = head;
+        prev = &head;
+        if (next != nullptr) {
+            static_cast<IntrusiveListNode*>(next)->prev = &next;
+        }
+        head = static_cast<T*>(this);
+    }
+
+    /**
+     * Unlink the object from its list.
+     */
+    void unlink() noexcept {
+        assert(linked());
+
+        *prev = next;
+        if (next != nullptr) {
+            static_cast<IntrusiveListNode*>(next)->prev = prev;
+        }
+        next = nullptr;
+        prev = nullptr;
+    }
+
+    /**
+     * Check if the object is linked into a list.
+     *
+     * @return true if linked, false otherwise
+     */
+    [[nodiscard]] bool linked() const noexcept {
+        return prev != nullptr;
+    }
+
+  protected:
+    IntrusiveListNode() noexcept = default;
+
+    ~IntrusiveListNode() noexcept {
+        if (linked()) {
+            unlink();
+        }
+    }
+
+  private:
+    /// next object of the list
+    T* next = nullptr;
+
+    /// pointer pointing at this object (the head or the next of the previous object)
+    T** prev = nullptr;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
@@ -7,13 +7,46 @@ LICENSE file in the root directory of this source tree.
 
 #include "common/EventQueue.h"
 #include "common/Type.h"
+#include "congestion_aware/ChunkTracer.h"
 #include "congestion_aware/Type.h"
+#include <cstdint>
+#include <list>
 #include <memory>
 
 using namespace NetworkAnalytical;
 
 namespace NetworkAnalyticalCongestionAware {
 
+/**
+ * Statistics a Link accumulates over a run.
+ */
+struct LinkStats {
+    /// total time the link spent serializing chunks, in ns
+    EventTime busy_time = 0;
+
+    /// total bytes transmitted
+    uint64_t bytes = 0;
+
+    /// number of chunks transmitted
+    uint64_t chunks_count = 0;
+
+    /// largest number of chunks waiting in the pending queue
+    uint64_t max_pending_depth = 0;
+
+    /// sum of the pending queue depth seen by each chunk when its transmission started
+    uint64_t pending_depth_sum = 0;
+
+    /// total time chunks spent waiting in the pending queue, in ns
+    EventTime queueing_delay = 0;
+
+    /**
+     * Get the mean pending queue depth, sampled whenever a chunk starts transmission.
+     *
+     * @return mean pending queue depth
+     */
+    [[nodiscard]] double mean_pending_depth() const noexcept;
+};
+
 /**
  * Link models physical links between two devices.
  */
@@ -35,6 +68,21 @@ class Link {
      */
     static void set_event_queue(std::shared_ptr<EventQueue> event_queue_ptr) noexcept;
 
+    /**
+     * Set the tracer recording chunk transmissions of every link.
+     * Only effective when chunk tracing is compiled in (chunk_trace_enabled).
+     *
+     * @param chunk_tracer_ptr pointer to the tracer, nullptr to stop tracing
+     */
+    static void set_chunk_tracer(std::shared_ptr<ChunkTracer> chunk_tracer_ptr) noexcept;
+
+    /**
+     * Get the tracer recording chunk transmissions.
+     *
+     * @return pointer to the tracer, nullptr if not set
+     */
+    [[nodiscard]] static const std::shared_ptr<ChunkTracer>& get_chunk_tracer() noexcept;
+
     /**
      * Constructor.
      *
@@ -43,6 +91,15 @@ class Link {
      */
     Link(Bandwidth bandwidth, Latency latency) noexcept;
 
+    /**
+     * Destructor.
+     * Frees the chunks in transmission and the reserved chunks starting at the link.
+     */
+    ~Link() noexcept;
+
+    Link(const Link&) = delete;
+    Link& operator=(const Link&) = delete;
+
     /**
      * Try to send a chunk through the link.
      * - If the link is free, service the chunk immediately.
@@ -65,6 +122,13 @@ class Link {
      */
     [[nodiscard]] bool pending_chunk_exists() const noexcept;
 
+    /**
+     * Get the number of chunks queued at the link, counting the one in transmission.
+     *
+     * @return number of queued chunks
+     */
+    [[nodiscard]] size_t get_queue_length() const noexcept;
+
     /**
      * Set the link as busy.
      */
@@ -75,10 +139,86 @@ class Link {
      */
     void set_free() noexcept;
 
+    /**
+     * Get the bandwidth of the link.
+     *
+     * @return bandwidth of the link in GB/s
+     */
+    [[nodiscard]] Bandwidth get_bandwidth() const noexcept;
+
+    /**
+     * Get the latency of the link.
+     *
+     * @return latency of the link in ns
+     */
+    [[nodiscard]] Latency get_latency() const noexcept;
+
+    /**
+     * Get the statistics accumulated by the link.
+     *
+     * @return link statistics
+     */
+    [[nodiscard]] const LinkStats& get_stats() const noexcept;
+
+    /**
+     * Return the link to its idle state.
+     * Pending chunks, chunks in transmission, and reserved chunks starting at the link are dropped,
+     * the link is set free, and statistics are cleared.
+     */
+    void reset() noexcept;
+
+    /**
+     * Check whether the link is free, with no pending chunks,
+     * and not reserved by any ReservedChunk within [start_time, end_time).
+     *
+     * @param start_time start of the interval
+     * @param end_time end of the interval
+     * @return true if the link is idle within the interval, false otherwise
+     */
+    [[nodiscard]] bool idle_during(EventTime start_time, EventTime end_time) noexcept;
+
+    /**
+     * Reserve the link for a ReservedChunk,
+     * from start_time for the serialization delay of the chunk.
+     *
+     * @param reserved_chunk chunk to reserve the link for
+     * @param hop hop of the chunk's route this link serves
+     * @param start_time time the chunk reaches the link
+     */
+    void reserve(ReservedChunk* reserved_chunk, int hop, EventTime start_time) noexcept;
+
+    /**
+     * Release the reservation of a ReservedChunk.
+     *
+     * @param reserved_chunk chunk whose reservation is released
+     */
+    void release(const ReservedChunk* reserved_chunk) noexcept;
+
+    /**
+     * Compute the serialization delay of a chunk on the link.
+     * i.e., serialization delay = (chunk size) / (link bandwidth)
+     *
+     * @param chunk_size size of the target chunk
+     * @return serialization delay of the chunk
+     */
+    [[nodiscard]] EventTime serialization_delay(ChunkSize chunk_size) const noexcept;
+
+    /**
+     * Compute the communication delay of a chunk.
+     * i.e., communication delay = (link latency) + (serialization delay)
+     *
+     * @param chunk_size size of the target chunk
+     * @return communication delay of the chunk
+     */
+    [[nodiscard]] EventTime communication_delay(ChunkSize chunk_size) const noexcept;
+
   private:
     /// event queue Link uses to schedule events
     static std::shared_ptr<EventQueue> event_queue;
 
+    /// tracer Link records chunk transmissions to
+    static std::shared_ptr<ChunkTracer> chunk_tracer;
+
     /// bandwidth of the link in GB/s
     Bandwidth bandwidth;
 
@@ -88,29 +228,63 @@ class Link {
     /// latency of the link in ns
     Latency latency;
 
+    /// chunk waiting for the link, with the time it got queued
+    struct PendingChunk {
+        std::unique_ptr<Chunk> chunk;
+        EventTime enqueued_time;
+    };
+
     /// queue of pending chunks
-    std::list<std::unique_ptr<Chunk>> pending_chunks;
+    std::list<PendingChunk> pending_chunks;
+
+    /// chunks in transmission (owned by their arrival events), so that reset() can free them
+    Chunk* in_flight_chunks;
+
+    /// reserved chunks whose first hop is this link (owned by their events), so that reset() can free them
+    ReservedChunk* reserved_chunks;
+
+    /// interval a ReservedChunk holds the link for
+    struct Reservation {
+        EventTime start_time;
+        EventTime end_time;
+        ReservedChunk* reserved_chunk;
+        int hop;
+    };
+
+    /// reservations of the fast path, sorted by start_time
+    std::list<Reservation> reservations;
 
     /// flag to indicate if the link is busy
     bool busy;
 
+    /// statistics accumulated over the run
+    LinkStats stats;
+
     /**
-     * Compute the serialization delay of a chunk on the link.
-     * i.e., serialization delay = (chunk size) / (link bandwidth)
+     * Free the chunks in transmission and the reserved chunks starting at the link,
+     * whose events are dropped along with the event queue.
+     */
+    void free_in_flight_chunks() noexcept;
+
+    /**
+     * Drop the reservations that ended by the given time.
      *
-     * @param chunk_size size of the target chunk
-     * @return serialization delay of the chunk
+     * @param current_time current time
      */
-    [[nodiscard]] EventTime serialization_delay(ChunkSize chunk_size) const noexcept;
+    void drop_expired_reservations(EventTime current_time) noexcept;
 
     /**
-     * Compute the communication delay of a chunk.
-     * i.e., communication delay = (link latency) + (serialization delay)
+     * Before transmitting a chunk on the free link, resolve reservations:
+     * - if a ReservedChunk holds the link now, keep the link busy until it leaves and return true.
+     * - reserved chunks that would arrive while this chunk is still serializing are demoted,
+     *   as this chunk reached the link first.
+     * - a reserved chunk arriving right now is demoted as well if this chunk was queued before it.
      *
-     * @param chunk_size size of the target chunk
-     * @return communication delay of the chunk
+     * @param chunk_size size of the chunk to transmit
+     * @param enqueued_time time the chunk reached the link
+     * @return true if the chunk has to wait for a reservation, false if it can be transmitted now
      */
-    [[nodiscard]] EventTime communication_delay(ChunkSize chunk_size) const noexcept;
+    [[nodiscard]] bool wait_for_reservation(ChunkSize chunk_size, EventTime enqueued_time) noexcept;
 
     /**
      * Schedule the transmission of a chunk.
@@ -119,8 +293,9 @@ class Link {
      * - Chunk arrives next node after the communication delay.
      *
      * @param chunk chunk to be transmitted
+     * @param queueing_delay time the chunk waited in the pending queue
      */
-    void schedule_chunk_transmission(std::unique_ptr<Chunk> chunk) noexcept;
+    void schedule_chunk_transmission(std::unique_ptr<Chunk> chunk, EventTime queueing_delay = 0) noexcept;
 };
 
 }  // namespace NetworkAnalyticalCongestionAware
@@ -12,6 +12,7 @@ LICENSE file in the root directory of this source tree.
 
 #include <memory>
 #include <optional>
+#include <string>
 
 using namespace NetworkAnalytical;
 
@@ -50,8 +51,22 @@ class MultiDimTopology : public Topology {
 
     /**
      * Make connections for all nodes inter and intra dimensions.
+     * With more than one thread, the connection policies are expanded by worker threads
+     * into thread-local link blocks, which are then merged into the devices' links.
+     * The constructed topology does not depend on threads_count.
+     *
+     * @param threads_count number of threads used to build the links
+     */
+    void make_connections(int threads_count = 1) noexcept;
+
+    /**
+     * Defer every connection to the first chunk crossing it, instead of make_connections.
+     * A link is then instantiated with the bandwidth and latency of its dimension, derated by the fault map,
+     * so memory scales with the links the traffic touches rather than with the topology size.
+     * Link statistics, chunk traces, and snapshots only cover the links instantiated so far;
+     * a topology restored from a snapshot keeps instantiating the others lazily.
      */
-    void make_connections() noexcept;
+    void make_lazy_connections() noexcept;
 
     /**
      * Make connections for all nodes inter and intra dimensions.
@@ -60,14 +75,53 @@ class MultiDimTopology : public Topology {
 
     /**
      * Initialize all devices in the topology.
+     *
+     * @param threads_count number of threads used to instantiate the devices
      */
-    void initialize_all_devices() noexcept;
+    void initialize_all_devices(int threads_count = 1) noexcept;
 
     /**
      * Build mapping from switch address length to starting offset.
      */
     void build_switch_length_mapping() noexcept;
 
+    /**
+     * Serialize the constructed topology into a versioned binary snapshot file:
+     * the shape of every dimension, the fault map, every link and whether links are instantiated lazily.
+     *
+     * @param path path of the snapshot file to write
+     */
+    void save_snapshot(const std::string& path) const noexcept;
+
+    /**
+     * Restore a topology from a snapshot file written by save_snapshot.
+     * The file is memory-mapped and links are connected as saved,
+     * skipping the expansion of connection policies.
+     * A lazy topology is restored lazy, so links not saved are instantiated as chunks cross them.
+     *
+     * @param path path of the snapshot file to read
+     * @return restored topology
+     */
+    [[nodiscard]] static std::shared_ptr<MultiDimTopology> load_snapshot(const std::string& path) noexcept;
+
+  protected:
+    /**
+     * Get the network dimension the src -> dest link belongs to.
+     * NPU-to-NPU links belong to the first dimension their addresses differ in,
+     * and links touching a switch belong to the switch's dimension.
+     *
+     * @param src src device id
+     * @param dest dest device id
+     * @return dimension of the link
+     */
+    [[nodiscard]] int get_link_dim(DeviceId src, DeviceId dest) const noexcept override;
+
+    /**
+     * Implementation of connect_lazily function in Topology:
+     * connect src -> dest in the dimension the link belongs to.
+     */
+    void connect_lazily(DeviceId src, DeviceId dest) noexcept override;
+
   private:
     /**
      * Translate the NPU ID into a multi-dimensional address.
@@ -108,6 +162,67 @@ class MultiDimTopology : public Topology {
      */
     [[nodiscard]] bool is_switch(const MultiDimAddress& address) const noexcept;
 
+    /**
+     * A link to be created, produced by construction worker threads.
+     */
+    struct LinkSpec {
+        DeviceId src;
+        DeviceId dest;
+        Bandwidth bandwidth;
+        Latency latency;
+    };
+
+    /**
+     * Get the number of connections each connection policy of the given dimension expands to.
+     *
+     * @param dim dimension of the connection policy
+     * @return number of expanded connections per policy
+     */
+    [[nodiscard]] int get_connections_count_per_policy(int dim) const noexcept;
+
+    /**
+     * Enumerate the (src, dest) device ID pairs a connection policy of the given dimension expands to,
+     * restricted to the connection index range [first, last).
+     * The other dimensions are walked with an odometer over precomputed strides,
+     * so no multi-dimensional address is materialized.
+     *
+     * @param dim dimension the connection policy belongs to
+     * @param policy connection policy in per-dimension device IDs
+     * @param first index of the first connection to enumerate
+     * @param last index past the last connection to enumerate
+     * @param visitor invoked as visitor(src, dest) for each expanded connection
+     */
+    template <typename Visitor>
+    void for_each_connection(int dim, const ConnectionPolicy& policy, int first, int last, Visitor&& visitor) const
+        noexcept;
+
+    /**
+     * Multi-threaded implementation of make_connections.
+     *
+     * @param threads_count number of worker threads
+     */
+    void make_connections_parallel(int threads_count) noexcept;
+
+    /**
+     * Derate the bandwidth of src -> dest according to the fault map.
+     *
+     * @param bandwidth bandwidth of the healthy link
+     * @param src src device id
+     * @param dest dest device id
+     * @return bandwidth of the link
+     */
+    [[nodiscard]] Bandwidth derated_bandwidth(Bandwidth bandwidth, DeviceId src, DeviceId dest) const noexcept;
+
+    /**
+     * Connect src -> dest with the bandwidth and latency of the given dimension,
+     * derated according to the fault map.
+     *
+     * @param dim dimension the link belongs to
+     * @param src src device id
+     * @param dest dest device id
+     */
+    void connect_in_dim(int dim, DeviceId src, DeviceId dest) noexcept;
+
     double fault_derate(int src, int dst) const;
     std::vector<std::tuple<int, int, double>> faulty_links;
     std::vector<int> m_non_recursive_topo;
@@ -115,6 +230,8 @@ class MultiDimTopology : public Topology {
 
     /// BasicTopology instances per dimension.
     std::vector<std::unique_ptr<BasicTopology>> m_topology_per_dim;
+    /// stride of each dimension in the NPU ID space, e.g., [1, 2, 16] for [2, 8, 4]
+    std::vector<DeviceId> m_npus_stride_per_dim;
     /// Switch translation unit for address to device ID translation.
     std::optional<SwitchTranslationUnit> m_switch_translation_unit;
 };
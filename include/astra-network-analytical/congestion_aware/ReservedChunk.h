@@ -0,0 +1,130 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/EventQueue.h"
+#include "common/Type.h"
+#include "congestion_aware/IntrusiveList.h"
+#include "congestion_aware/Type.h"
+#include <memory>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionAware {
+
+/**
+ * ReservedChunk is a chunk sent through the analytical fast path of hybrid simulation.
+ *
+ * When every link on the route is idle for the time the chunk would occupy it,
+ * the chunk reserves those links up front and a single event fires at its final arrival,
+ * instead of two events per hop.
+ *
+ * A reservation is only a prediction: if another chunk reaches a reserved link first
+ * and would still occupy it when the reserved chunk gets there,
+ * the reserved chunk is demoted from that hop onward:
+ * its remaining reservations are released
+ * and it re-enters the event-driven path when it reaches that hop,
+ * exactly as it would have in a fully event-driven run.
+ *
+ * The object is owned by its scheduled events,
+ * and linked into the list of reserved chunks of its first link so that Link::reset can free it.
+ */
+class ReservedChunk : public IntrusiveListNode<ReservedChunk> {
+  public:
+    /**
+     * Set the event queue to be used by reserved chunks.
+     *
+     * @param event_queue_ptr pointer to the event queue
+     */
+    static void set_event_queue(std::shared_ptr<EventQueue> event_queue_ptr) noexcept;
+
+    /**
+     * Try to send a chunk through the fast path.
+     *
+     * @param chunk chunk to send, sitting at its source device
+     * @return nullptr if the chunk got reserved, or the chunk itself if any link on the route is contended
+     */
+    [[nodiscard]] static std::unique_ptr<Chunk> try_reserve(std::unique_ptr<Chunk> chunk) noexcept;
+
+    /**
+     * Demote the chunk to the event-driven path from the given hop onward.
+     * No-op if already demoted at or before the hop.
+     *
+     * @param hop index of the first hop to give up
+     */
+    void demote(int hop) noexcept;
+
+    /**
+     * Get the size of the chunk.
+     *
+     * @return size of the chunk
+     */
+    [[nodiscard]] ChunkSize get_size() const noexcept;
+
+  private:
+    /// event queue ReservedChunk uses to schedule events
+    static std::shared_ptr<EventQueue> event_queue;
+
+    /// the chunk, until it arrives or re-enters the event-driven path
+    std::unique_ptr<Chunk> chunk;
+
+    /// size of the chunk
+    ChunkSize chunk_size;
+
+    /// link of each hop
+    std::vector<Link*> links;
+
+    /// time the chunk reaches the device of each hop, followed by the final arrival time
+    std::vector<EventTime> arrival_times;
+
+    /// first hop taken through the event-driven path (hops count if not demoted)
+    int demoted_hop;
+
+    /// number of scheduled events referring to this object
+    int pending_events_count;
+
+    /**
+     * Constructor.
+     *
+     * @param chunk chunk to send
+     * @param links link of each hop
+     * @param arrival_times time the chunk reaches each device
+     */
+    ReservedChunk(std::unique_ptr<Chunk> chunk,
+                  std::vector<Link*> links,
+                  std::vector<EventTime> arrival_times) noexcept;
+
+    /**
+     * Callback at the final arrival time: invoke the chunk's callback unless demoted.
+     *
+     * @param reserved_chunk_ptr pointer to the ReservedChunk
+     */
+    static void chunk_arrived_dest(void* reserved_chunk_ptr) noexcept;
+
+    /**
+     * Callback at the demoted hop: hand the chunk over to the event-driven path.
+     *
+     * @param reserved_chunk_ptr pointer to the ReservedChunk
+     */
+    static void chunk_resumed(void* reserved_chunk_ptr) noexcept;
+
+    /**
+     * Record the transmissions taken through the fast path to the chunk tracer.
+     *
+     * @param hops_count number of hops taken through the fast path
+     */
+    void trace_transmissions(int hops_count) const noexcept;
+
+    /**
+     * Account for a fired event, deleting this object after the last one.
+     *
+     * @param reserved_chunk ReservedChunk the event referred to
+     */
+    static void event_fired(ReservedChunk* reserved_chunk) noexcept;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
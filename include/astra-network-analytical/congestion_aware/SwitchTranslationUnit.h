@@ -6,7 +6,6 @@ LICENSE file in the root directory of this source tree.
 #pragma once
 
 #include "common/Type.h"
-#include <unordered_map>
 #include <vector>
 
 using namespace NetworkAnalytical;
@@ -16,15 +15,17 @@ namespace NetworkAnalyticalCongestionAware {
 /**
  * Represents a switch translation unit.
  * Translate switch Address to device ID, it is a helper class for MultiDimTopology.
+ *
+ * All strides and offsets are precomputed at construction,
+ * so a translation is a single pass of multiply-adds over the address.
  */
 class SwitchTranslationUnit final {
   public:
     /**
      * Constructor.
      *
-     * @param npus_count number of npus connected to the switch
-     * @param bandwidth bandwidth of link
-     * @param latency latency of link
+     * @param npus_count_per_dim number of NPUs per each dimension
+     * @param is_switch_dim true for each dimension that is a Switch
      */
     SwitchTranslationUnit(std::vector<int> npus_count_per_dim, std::vector<bool> is_switch_dim) noexcept;
 
@@ -35,24 +36,45 @@ class SwitchTranslationUnit final {
      */
     [[nodiscard]] DeviceId translate_address_to_id(const MultiDimAddress& address) const noexcept;
 
-  private:
-    /** Translates a partial address to an offset.
+    /** Get the device ID of the first switch in the given switch dimension.
      *
-     * @param partial_address The partial address.
-     * @param partial_npus_count_per_dim The number of NPUs per dimension for the partial address.
-     * @return The offset.
+     * @param switch_dim dimension of the switch
+     * @return device ID of the switch whose higher-dimension address is all zero
      */
-    [[nodiscard]] DeviceId translate_partial_address_to_offset(
-        const MultiDimAddress& partial_address, const std::vector<int>& partial_npus_count_per_dim) const noexcept;
+    [[nodiscard]] DeviceId get_switch_base_id(int switch_dim) const noexcept;
 
+    /** Get the weight of address[dim] in the device ID of a switch living in switch_dim.
+     * i.e., the switch ID is get_switch_base_id(switch_dim) + sum(address[dim] * get_switch_stride(switch_dim, dim)).
+     *
+     * @param switch_dim dimension of the switch
+     * @param dim dimension of the address element
+     * @return stride of the address element, zero for dim <= switch_dim
+     */
+    [[nodiscard]] DeviceId get_switch_stride(int switch_dim, int dim) const noexcept;
+
+    /**
+     * Get the switch dimension a switch belongs to.
+     *
+     * @param switch_id device ID of the switch
+     * @return switch dimension holding the switch
+     */
+    [[nodiscard]] int get_switch_dim(DeviceId switch_id) const noexcept;
+
+  private:
     /// Total number of NPUs connected to the switch.
     const int m_total_npus_count;
+    /// number of network dimensions
+    const int m_dims_count;
     /// BasicTopology instances per dimension.
     const std::vector<int> m_npus_count_per_dim;
     /// indicates which dimensions are switches.
     const std::vector<bool> m_is_switch_dim;
-    /// map of address length to starting offset of such switches
-    std::unordered_map<int, int> m_switch_length_number_mapping;
+    /// device ID of the first switch of each switch dimension (-1 if not a switch dimension)
+    std::vector<DeviceId> m_switch_base_id_per_dim;
+    /// m_switch_strides[switch_dim * dims_count + dim]:
+    /// weight of address[dim] when computing the offset of a switch living in switch_dim
+    /// (zero for dim <= switch_dim)
+    std::vector<DeviceId> m_switch_strides;
 };
 
 }  // namespace NetworkAnalyticalCongestionAware
@@ -0,0 +1,115 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/EventQueue.h"
+#include "common/Type.h"
+#include "congestion_aware/CollectiveGenerator.h"
+#include "congestion_aware/DagExecutor.h"
+#include "congestion_aware/Topology.h"
+#include <memory>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionAware {
+
+/**
+ * SymmetricSimulation runs a collective schedule on a congestion-aware topology,
+ * simulating a single NPU when both the topology and the schedule are translation-invariant.
+ *
+ * Translations shift the NPU address of every dimension cyclically (e.g., rotating a Ring).
+ * The topology is invariant if every translation maps every link onto a link of the same bandwidth and latency
+ * (so faults and non-wrapping dimensions such as Mesh break the symmetry),
+ * and the schedule is invariant if every translation maps its sends and dependencies onto themselves.
+ *
+ * Translated sends then behave identically: only the sends of NPU 0 are simulated,
+ * on a quotient network with one link per orbit of links.
+ * A link of the quotient network carries every send the links of its orbit carry, translated back to NPU 0,
+ * so the contention between orbits (the coupling at the boundary of the simulated NPU) is kept.
+ * Completion times of the other sends are extrapolated from their translate at NPU 0.
+ *
+ * Otherwise, the whole schedule is simulated on the topology itself.
+ */
+class SymmetricSimulation {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param topology topology to run the schedule on
+     * @param event_queue event queue the topology runs on
+     * @param schedule sends of the schedule and their dependencies
+     */
+    SymmetricSimulation(std::shared_ptr<Topology> topology,
+                        std::shared_ptr<EventQueue> event_queue,
+                        const CollectiveSchedule& schedule) noexcept;
+
+    /**
+     * Release every send without dependencies.
+     * The rest is released as the simulation proceeds.
+     */
+    void start() noexcept;
+
+    /**
+     * Check whether every simulated send completed.
+     *
+     * @return true if the schedule is done, false otherwise
+     */
+    [[nodiscard]] bool finished() const noexcept;
+
+    /**
+     * Check whether the simulation is reduced to NPU 0.
+     *
+     * @return true if the symmetry was detected, false if the whole schedule is simulated
+     */
+    [[nodiscard]] bool is_reduced() const noexcept;
+
+    /**
+     * Get the number of sends actually simulated.
+     *
+     * @return number of simulated sends
+     */
+    [[nodiscard]] int get_simulated_nodes_count() const noexcept;
+
+    /**
+     * Get the completion time of a send of the schedule,
+     * extrapolated from its translate at NPU 0 if the simulation is reduced.
+     *
+     * @param node node index in the schedule
+     * @return completion time of the send (0 if not completed yet)
+     */
+    [[nodiscard]] EventTime get_completion_time(int node) const noexcept;
+
+  private:
+    /// topology the sends are simulated on: the quotient network if reduced, the topology itself otherwise
+    std::shared_ptr<Topology> simulated_topology;
+
+    /// executor of the simulated sends
+    std::unique_ptr<DagExecutor> dag_executor;
+
+    /// simulated node of each node of the schedule
+    std::vector<int> simulated_node_of;
+
+    /// whether the simulation is reduced to NPU 0
+    bool reduced;
+
+    /// number of simulated sends
+    int simulated_nodes_count;
+
+    /**
+     * Try to reduce the schedule to the sends of NPU 0.
+     *
+     * @param topology topology to run the schedule on
+     * @param schedule sends of the schedule and their dependencies
+     * @param simulated_schedule filled with the sends of NPU 0 and their dependencies
+     * @return quotient network, or nullptr if the topology or the schedule is not translation-invariant
+     */
+    [[nodiscard]] std::shared_ptr<Topology> reduce(const Topology& topology,
+                                                   const CollectiveSchedule& schedule,
+                                                   CollectiveSchedule& simulated_schedule) noexcept;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
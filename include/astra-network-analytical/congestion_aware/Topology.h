@@ -7,8 +7,11 @@ LICENSE file in the root directory of this source tree.
 
 #include "common/EventQueue.h"
 #include "congestion_aware/Chunk.h"
+#include "congestion_aware/ChunkTracer.h"
 #include "congestion_aware/Device.h"
+#include <cstdint>
 #include <memory>
+#include <string>
 #include <vector>
 
 using namespace NetworkAnalytical;
@@ -27,6 +30,14 @@ class Topology {
      */
     static void set_event_queue(std::shared_ptr<EventQueue> event_queue) noexcept;
 
+    /**
+     * Set the tracer recording chunk transmissions.
+     * Only effective when chunk tracing is compiled in (NETWORK_BACKEND_ENABLE_CHUNK_TRACE).
+     *
+     * @param chunk_tracer pointer to the tracer, nullptr to stop tracing
+     */
+    static void set_chunk_tracer(std::shared_ptr<ChunkTracer> chunk_tracer) noexcept;
+
     /**
      * Constructor.
      */
@@ -46,13 +57,63 @@ class Topology {
      */
     [[nodiscard]] virtual Route route(DeviceId src, DeviceId dest) const noexcept = 0;
 
+    /**
+     * Construct the route of a given chunk from src to dest.
+     * Topologies with several equal-cost routes (e.g., FatTree) spread chunks over them by chunk_id,
+     * while the others return route(src, dest).
+     *
+     * @param src src NPU id
+     * @param dest dest NPU id
+     * @param chunk_id id of the chunk, to pick one of several equal-cost routes
+     *
+     * @return route from src NPU to dest NPU
+     */
+    [[nodiscard]] virtual Route route_chunk(DeviceId src, DeviceId dest, uint64_t chunk_id) const noexcept;
+
     /**
      * Initiate a transmission of a chunk.
+     * In hybrid mode, a chunk whose route is idle takes the analytical fast path (see ReservedChunk).
+     * With lazy links, the links of the route not crossed before are instantiated first.
      *
      * @param chunk chunk to be transmitted
      */
     void send(std::unique_ptr<Chunk> chunk) noexcept;
 
+    /**
+     * Enable or disable hybrid simulation.
+     * When enabled, chunks that would not contend on any link of their route
+     * reserve the links and fire a single event at their arrival, instead of two events per hop.
+     * Contended chunks still take the event-driven path, so chunk arrival times are unchanged.
+     *
+     * @param hybrid_mode true to enable hybrid simulation, false otherwise
+     */
+    void set_hybrid_mode(bool hybrid_mode) noexcept;
+
+    /**
+     * Return every link to its idle state so the topology can be reused for another run.
+     * Links and devices are kept as-is; only their transient state is cleared,
+     * freeing the chunks pending, in transmission, or reserved through the hybrid fast path on every link.
+     * Pair this with a fresh EventQueue (set via set_event_queue()),
+     * as events still scheduled on the previous queue refer to the old run.
+     */
+    void reset() noexcept;
+
+    /**
+     * Write the statistics of every link to a file, one entry per (src, dest, dim).
+     * The output is JSON if the path ends with ".json", and CSV otherwise.
+     *
+     * @param path path of the output file
+     */
+    void dump_link_stats(const std::string& path) const noexcept;
+
+    /**
+     * Write the chunk transmissions recorded by the tracer as a Chrome trace JSON file,
+     * with one track per link of this topology.
+     *
+     * @param path path of the output file
+     */
+    void dump_chunk_trace(const std::string& path) const noexcept;
+
     /**
      * Get the number of NPUs in the topology.
      * NPU excludes non-NPU devices such as switches.
@@ -69,6 +130,14 @@ class Topology {
      */
     [[nodiscard]] int get_devices_count() const noexcept;
 
+    /**
+     * Get a device of the topology.
+     *
+     * @param id id of the device
+     * @return device with the given id
+     */
+    [[nodiscard]] std::shared_ptr<Device> get_device(DeviceId id) const noexcept;
+
     /**
      * Get the number of network dimensions.
      *
@@ -111,6 +180,12 @@ class Topology {
     /// bandwidth per each network dimension
     std::vector<Bandwidth> bandwidth_per_dim;
 
+    /// whether idle routes take the analytical fast path
+    bool hybrid_mode;
+
+    /// whether links are instantiated the first time a chunk crosses them (see connect_lazily)
+    bool lazy_links;
+
     /**
      * Instantiate Device objects in the topology.
      */
@@ -131,6 +206,25 @@ class Topology {
     void connect(DeviceId src, DeviceId dest, Bandwidth bandwidth, Latency latency, bool bidirectional = true) noexcept;
 
     void bus_connect(DeviceId src, DeviceId dest, Bandwidth bandwidth, Latency latency, bool bidirectional = true) noexcept;
+
+    /**
+     * Get the network dimension the src -> dest link belongs to.
+     * Basic topologies have a single dimension.
+     *
+     * @param src src device id
+     * @param dest dest device id
+     * @return dimension of the link
+     */
+    [[nodiscard]] virtual int get_link_dim(DeviceId src, DeviceId dest) const noexcept;
+
+    /**
+     * Instantiate the src -> dest link the first time a chunk crosses it.
+     * Only called when lazy_links is set, so topologies enabling it should override this.
+     *
+     * @param src src device id
+     * @param dest dest device id
+     */
+    virtual void connect_lazily(DeviceId src, DeviceId dest) noexcept;
 };
 
 }  // namespace NetworkAnalyticalCongestionAware
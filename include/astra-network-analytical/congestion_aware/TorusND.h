@@ -0,0 +1,91 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/Type.h"
+#include "congestion_aware/BasicTopology.h"
+#include <tuple>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionAware {
+
+/**
+ * Implements an N-dimensional torus or mesh topology with per-axis sizes.
+ * Each NPU links to its neighbours along every axis; an axis with wraparound closes into a ring.
+ * TorusND wraps around every axis, and MeshND none.
+ *
+ * NPU IDs are row-major with axis 0 being the fastest,
+ * e.g., NPU (x, y, z) of shape [X, Y, Z] is x + (y * X) + (z * X * Y).
+ *
+ * TorusND([4, 2]) example:
+ *   ___________________
+ *  |_ 0 - 1 - 2 - 3 _|
+ *     |   |   |   |
+ *   _ 4 - 5 - 6 - 7 _
+ *  |_________________|
+ *
+ * Routes are dimension-ordered (axis 0 first),
+ * taking the shorter direction of every axis with wraparound (the positive one on a tie).
+ *
+ * The axes already span the whole network, so TorusND is only built as a single-dimensional topology
+ * and never as a dimension of a MultiDimTopology.
+ */
+class TorusND final : public BasicTopology {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param shape number of NPUs along each axis
+     * @param bandwidth bandwidth of link
+     * @param latency latency of link
+     * @param wraparound whether each axis wraps around
+     * @param bidirectional true if links are bidirectional, false only if every axis wraps around
+     * @param faulty_links list of faulty links as tuples (src, dst, weight)
+     */
+    TorusND(const std::vector<int>& shape,
+            Bandwidth bandwidth,
+            Latency latency,
+            const std::vector<bool>& wraparound,
+            bool bidirectional = true,
+            const std::vector<std::tuple<int, int, double>>& faulty_links = {}) noexcept;
+
+    /**
+     * Implementation of route function in Topology.
+     */
+    [[nodiscard]] Route route(DeviceId src, DeviceId dest) const noexcept override;
+
+    /**
+     * Implementation of get_connection_policies function in BasicTopology.
+     */
+    [[nodiscard]] std::vector<ConnectionPolicy> get_connection_policies() const noexcept override;
+
+  private:
+    /// number of NPUs along each axis
+    std::vector<int> shape;
+
+    /// NPU ID stride of each axis
+    std::vector<DeviceId> strides;
+
+    /// whether each axis wraps around
+    std::vector<bool> wraparound;
+
+    /// true if links are bidirectional
+    bool bidirectional;
+
+    /**
+     * Check whether an NPU links to its next neighbour along an axis (wrapping around if needed).
+     * On a bidirectional axis of two NPUs, the wraparound link is the link back.
+     *
+     * @param axis axis of the link
+     * @param coordinate coordinate of the NPU along the axis
+     * @return true if the link exists, false otherwise
+     */
+    [[nodiscard]] bool has_next_link(int axis, int coordinate) const noexcept;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
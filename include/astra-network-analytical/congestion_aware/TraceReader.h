@@ -0,0 +1,149 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/Type.h"
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionAware {
+
+/**
+ * A message of a communication trace.
+ * Messages are identified by their position in the trace, starting from 0.
+ */
+struct TraceRecord {
+    /// absolute issue time if depends_on < 0,
+    /// otherwise the delay between the completion of depends_on and the issue of this message (ns)
+    EventTime issue_time;
+
+    /// id of the message this one waits for, -1 if none; should precede this message in the trace
+    int64_t depends_on;
+
+    /// source NPU
+    DeviceId src;
+
+    /// destination NPU
+    DeviceId dest;
+
+    /// size of the message
+    ChunkSize bytes;
+};
+
+/**
+ * TraceReader streams the records of a trace file, in order.
+ */
+class TraceReader {
+  public:
+    /**
+     * Open a trace file, picking the reader from the extension:
+     * ".bin" is the binary format (see BinaryTraceReader), anything else is CSV (see CsvTraceReader).
+     *
+     * @param path path of the trace file
+     * @return reader of the file
+     */
+    [[nodiscard]] static std::unique_ptr<TraceReader> open(const std::string& path) noexcept;
+
+    /**
+     * Destructor.
+     */
+    virtual ~TraceReader() noexcept = default;
+
+    /**
+     * Read the next record.
+     *
+     * @param record record to fill
+     * @return true if a record was read, false at the end of the trace
+     */
+    [[nodiscard]] virtual bool next(TraceRecord& record) noexcept = 0;
+};
+
+/**
+ * CsvTraceReader reads one record per line: issue_time,depends_on,src,dest,bytes
+ * An optional header line and empty lines are skipped.
+ */
+class CsvTraceReader final : public TraceReader {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param path path of the trace file
+     */
+    explicit CsvTraceReader(const std::string& path) noexcept;
+
+    [[nodiscard]] bool next(TraceRecord& record) noexcept override;
+
+  private:
+    /// path of the trace file
+    std::string path;
+
+    /// trace file
+    std::ifstream file;
+
+    /// current line, reused across records
+    std::string line;
+
+    /// number of lines read so far
+    uint64_t lines_count;
+};
+
+/**
+ * BinaryTraceReader reads the compact binary format:
+ * an 8-byte magic and a 4-byte version, followed by fixed-size records (see write_binary_trace()).
+ * Records are read in blocks of a bounded size.
+ */
+class BinaryTraceReader final : public TraceReader {
+  public:
+    /**
+     * Write records in the binary format.
+     *
+     * @param path path of the output file
+     * @param records records to write
+     */
+    static void write_binary_trace(const std::string& path, const std::vector<TraceRecord>& records) noexcept;
+
+    /**
+     * Constructor.
+     *
+     * @param path path of the trace file
+     * @param block_records_count number of records read from the file at once
+     */
+    explicit BinaryTraceReader(const std::string& path, size_t block_records_count = 4096) noexcept;
+
+    [[nodiscard]] bool next(TraceRecord& record) noexcept override;
+
+  private:
+    /// on-disk layout of a record
+    struct BinaryRecord {
+        uint64_t issue_time;
+        int64_t depends_on;
+        int32_t src;
+        int32_t dest;
+        uint64_t bytes;
+    };
+
+    /// path of the trace file
+    std::string path;
+
+    /// trace file
+    std::ifstream file;
+
+    /// block of records read from the file
+    std::vector<BinaryRecord> block;
+
+    /// number of valid records in the block
+    size_t block_size;
+
+    /// index of the next record in the block
+    size_t block_index;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
@@ -0,0 +1,184 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/EventQueue.h"
+#include "common/Type.h"
+#include "congestion_aware/Topology.h"
+#include "congestion_aware/TraceReader.h"
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionAware {
+
+/**
+ * Aggregated results of a trace replay.
+ */
+struct ReplayStats {
+    /// number of messages completed
+    uint64_t messages_count = 0;
+
+    /// number of bytes delivered
+    uint64_t bytes = 0;
+
+    /// time the last message completed
+    EventTime finish_time = 0;
+
+    /// number of messages issued after their issue time,
+    /// because the replay window was full of incomplete messages when they were due
+    uint64_t late_messages_count = 0;
+};
+
+/**
+ * TraceReplayer replays a communication trace on a congestion-aware topology.
+ *
+ * Records are streamed from the TraceReader into a fixed window of slots:
+ * message i occupies slot (i % window), and is read once message (i - window) completed.
+ * A message is issued at its issue time, or `issue_time` after the completion of the message it depends on,
+ * which should be less than `window` messages before it in the trace.
+ * Memory is therefore bounded by the window, regardless of the trace length.
+ *
+ * Traces should list independent messages in issue-time order.
+ * If a message is due while the window is still full of incomplete messages,
+ * it is issued as soon as it is read, and counted in ReplayStats::late_messages_count.
+ *
+ * Completed messages are written to the output CSV, in completion order:
+ * id,src,dest,bytes,issue_time,completion_time
+ */
+class TraceReplayer {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param topology topology to replay the trace on
+     * @param event_queue event queue the topology runs on
+     * @param trace_reader reader of the trace
+     * @param window number of messages kept in memory
+     * @param output_path path of the per-message completion CSV, empty to skip it
+     */
+    TraceReplayer(std::shared_ptr<Topology> topology,
+                  std::shared_ptr<EventQueue> event_queue,
+                  std::unique_ptr<TraceReader> trace_reader,
+                  int window = 65'536,
+                  const std::string& output_path = "") noexcept;
+
+    /**
+     * Read the first window of messages, issuing those that are ready.
+     * The rest is read and issued as the simulation proceeds.
+     */
+    void start() noexcept;
+
+    /**
+     * Check whether every message of the trace was read and completed.
+     *
+     * @return true if the replay is done, false otherwise
+     */
+    [[nodiscard]] bool finished() const noexcept;
+
+    /**
+     * Get the results of the replay so far.
+     *
+     * @return aggregated results
+     */
+    [[nodiscard]] const ReplayStats& get_stats() const noexcept;
+
+  private:
+    /// state of a message within its slot
+    enum class MessageState { Empty, Waiting, Scheduled, InFlight, Completed };
+
+    /// a message kept in memory
+    struct MessageSlot {
+        TraceReplayer* replayer;
+        int64_t id;
+        TraceRecord record;
+        MessageState state;
+        EventTime issue_time;
+        EventTime completion_time;
+
+        /// first and last messages waiting for this one, in trace order (slot index, -1 if none)
+        int first_dependent;
+        int last_dependent;
+
+        /// next message waiting for the same message (slot index, -1 if none)
+        int next_dependent;
+    };
+
+    /// topology to replay the trace on
+    std::shared_ptr<Topology> topology;
+
+    /// event queue the topology runs on
+    std::shared_ptr<EventQueue> event_queue;
+
+    /// reader of the trace
+    std::unique_ptr<TraceReader> trace_reader;
+
+    /// per-message completion CSV (not open if skipped)
+    std::ofstream output;
+
+    /// preallocated message slots
+    std::vector<MessageSlot> message_slots;
+
+    /// id of the next message to read
+    int64_t next_id;
+
+    /// whether the reader reached the end of the trace
+    bool trace_ended;
+
+    /// number of messages read but not yet completed
+    uint64_t incomplete_count;
+
+    /// aggregated results
+    ReplayStats stats;
+
+    /**
+     * Callback of a message due at its issue time.
+     *
+     * @param message_slot_ptr pointer to the MessageSlot of the message
+     */
+    static void message_due(void* message_slot_ptr) noexcept;
+
+    /**
+     * Callback of a completed message.
+     *
+     * @param message_slot_ptr pointer to the MessageSlot of the message
+     */
+    static void message_completed(void* message_slot_ptr) noexcept;
+
+    /**
+     * Read messages while their slots are free.
+     */
+    void read_messages() noexcept;
+
+    /**
+     * Issue a message now, or schedule it at its issue time.
+     *
+     * @param message_slot message to issue
+     * @param issue_time time the message is due
+     */
+    void schedule_issue(MessageSlot& message_slot, EventTime issue_time) noexcept;
+
+    /**
+     * Send a message through the topology.
+     *
+     * @param message_slot message to send
+     */
+    void issue(MessageSlot& message_slot) noexcept;
+
+    /**
+     * Get the slot of a message id.
+     *
+     * @param id message id
+     * @return slot of the message
+     */
+    [[nodiscard]] MessageSlot& slot_of(int64_t id) noexcept;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
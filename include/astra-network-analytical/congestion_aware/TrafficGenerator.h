@@ -0,0 +1,263 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/EventQueue.h"
+#include "common/Type.h"
+#include "congestion_aware/Topology.h"
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionAware {
+
+/// Synthetic traffic patterns, deciding the destination of each message
+enum class TrafficPattern {
+    UniformRandom,  ///< a random NPU other than the source, drawn per message
+    Permutation,    ///< a fixed random permutation without fixed points
+    Transpose,      ///< (row, col) -> (col, row) on a square grid of NPUs; diagonal NPUs stay silent
+    Hotspot,        ///< the hotspot NPU with the given probability, uniform random otherwise
+    AllToAll,       ///< every other NPU in ascending order, one per message
+    RingNeighbour,  ///< the next NPU in the ring, (src + 1) % npus_count
+    BitComplement   ///< the NPU with every address bit flipped; NPUs count should be a power of 2
+};
+
+/**
+ * Injection settings of a TrafficGenerator.
+ */
+struct TrafficConfig {
+    /// pattern deciding the destinations
+    TrafficPattern pattern = TrafficPattern::UniformRandom;
+
+    /// size of each message, sent as a single chunk
+    ChunkSize message_size = 1'048'576;
+
+    /// number of messages each NPU injects (AllToAll: npus_count - 1 if 0)
+    int messages_per_npu = 1;
+
+    /// maximum number of messages each NPU keeps in flight
+    int window = 1;
+
+    /// minimum gap between two injections of an NPU, in ns (0 for back-to-back)
+    EventTime injection_interval = 0;
+
+    /// hotspot NPU (Hotspot only)
+    DeviceId hotspot_npu = 0;
+
+    /// probability a message targets the hotspot NPU (Hotspot only)
+    double hotspot_fraction = 0.5;
+
+    /// seed of the random patterns
+    uint64_t seed = 0;
+};
+
+/**
+ * Aggregated results of a TrafficGenerator run.
+ */
+struct TrafficStats {
+    /// number of messages delivered
+    uint64_t messages_count = 0;
+
+    /// number of bytes delivered
+    uint64_t bytes = 0;
+
+    /// time the last message was delivered
+    EventTime finish_time = 0;
+
+    /// sum of the message latencies (injection to delivery)
+    EventTime total_latency = 0;
+
+    /// largest message latency
+    EventTime max_latency = 0;
+
+    /// largest number of messages in flight at once, over all NPUs
+    uint64_t max_in_flight = 0;
+
+    /**
+     * Get the mean message latency.
+     *
+     * @return mean latency in ns, 0 if no message was delivered
+     */
+    [[nodiscard]] double mean_latency() const noexcept;
+
+    /**
+     * Get the delivered throughput over the whole run.
+     *
+     * @return throughput in GB/s, 0 if the run took no time
+     */
+    [[nodiscard]] double throughput() const noexcept;
+};
+
+/**
+ * TrafficGenerator drives a synthetic traffic pattern through Topology::send.
+ *
+ * Messages are injected lazily: each NPU keeps at most `window` messages in flight,
+ * and injects its next message once one of them arrives (and the injection interval has passed),
+ * so memory is bounded by npus_count * window regardless of the number of messages.
+ *
+ * e.g.,
+ *   auto generator = TrafficGenerator(topology, event_queue, config);
+ *   generator.start();
+ *   while (!event_queue->finished()) {
+ *       event_queue->proceed();
+ *   }
+ *   const auto& stats = generator.get_stats();
+ */
+class TrafficGenerator {
+  public:
+    /**
+     * Parse a traffic pattern name.
+     *
+     * @param pattern_name name of the pattern (e.g., "UniformRandom", "AllToAll")
+     * @return parsed traffic pattern
+     */
+    [[nodiscard]] static TrafficPattern parse_traffic_pattern(const std::string& pattern_name) noexcept;
+
+    /**
+     * Constructor.
+     *
+     * @param topology topology to inject the traffic into
+     * @param event_queue event queue the topology runs on
+     * @param config injection settings
+     */
+    TrafficGenerator(std::shared_ptr<Topology> topology,
+                     std::shared_ptr<EventQueue> event_queue,
+                     const TrafficConfig& config) noexcept;
+
+    /**
+     * Inject the first window of messages of every NPU.
+     * The rest is injected as the simulation proceeds.
+     */
+    void start() noexcept;
+
+    /**
+     * Check whether every message was injected and delivered.
+     *
+     * @return true if the traffic is done, false otherwise
+     */
+    [[nodiscard]] bool finished() const noexcept;
+
+    /**
+     * Get the results of the run so far.
+     *
+     * @return aggregated results
+     */
+    [[nodiscard]] const TrafficStats& get_stats() const noexcept;
+
+  private:
+    /// injection state of an NPU
+    struct NpuState {
+        TrafficGenerator* generator;
+        DeviceId npu;
+        int injected_count;
+        int in_flight_count;
+        EventTime last_injection_time;
+        bool injection_scheduled;
+
+        /// free message slots of this NPU, indices into message_slots
+        std::vector<int> free_slots;
+    };
+
+    /// a message in flight, handed to the chunk callback
+    struct MessageSlot {
+        NpuState* npu_state;
+        int slot;
+        EventTime injection_time;
+    };
+
+    /// topology to inject the traffic into
+    std::shared_ptr<Topology> topology;
+
+    /// event queue the topology runs on
+    std::shared_ptr<EventQueue> event_queue;
+
+    /// injection settings
+    TrafficConfig config;
+
+    /// number of NPUs in the topology
+    int npus_count;
+
+    /// number of messages each NPU injects
+    int messages_per_npu;
+
+    /// side of the NPU grid (Transpose only)
+    int grid_side;
+
+    /// fixed destination of each NPU (Permutation only)
+    std::vector<DeviceId> permutation;
+
+    /// random engine of the random patterns
+    std::mt19937_64 random_engine;
+
+    /// injection state of each NPU
+    std::vector<NpuState> npu_states;
+
+    /// preallocated message slots, `window` per NPU
+    std::vector<MessageSlot> message_slots;
+
+    /// number of messages currently in flight
+    uint64_t in_flight_count;
+
+    /// aggregated results
+    TrafficStats stats;
+
+    /**
+     * Callback of a delivered message.
+     *
+     * @param message_slot_ptr pointer to the MessageSlot of the message
+     */
+    static void message_arrived(void* message_slot_ptr) noexcept;
+
+    /**
+     * Callback of a deferred injection (injection interval not yet passed).
+     *
+     * @param npu_state_ptr pointer to the NpuState of the NPU
+     */
+    static void injection_ready(void* npu_state_ptr) noexcept;
+
+    /**
+     * Inject as many messages of an NPU as its window and injection interval allow.
+     *
+     * @param npu_state NPU to inject from
+     */
+    void inject(NpuState& npu_state) noexcept;
+
+    /**
+     * Check whether an NPU has messages left to inject.
+     *
+     * @param npu_state NPU to check
+     * @return true if the NPU has messages left, false otherwise
+     */
+    [[nodiscard]] bool has_messages_left(const NpuState& npu_state) const noexcept;
+
+    /**
+     * Pick the destination of the next message of an NPU.
+     *
+     * @param src source NPU
+     * @param message_index index of the message among the messages of the NPU
+     * @return destination NPU
+     */
+    [[nodiscard]] DeviceId pick_destination(DeviceId src, int message_index) noexcept;
+
+    /**
+     * Draw a random NPU other than src.
+     *
+     * @param src source NPU
+     * @return random destination NPU
+     */
+    [[nodiscard]] DeviceId random_destination(DeviceId src) noexcept;
+
+    /**
+     * Build the fixed random permutation without fixed points (Permutation only).
+     */
+    void build_permutation() noexcept;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
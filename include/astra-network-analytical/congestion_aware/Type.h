@@ -14,6 +14,7 @@ namespace NetworkAnalyticalCongestionAware {
 class Chunk;
 class Link;
 class Device;
+class ReservedChunk;
 
 /// Route is a list of devices
 using Route = std::list<std::shared_ptr<Device>>;
@@ -6,7 +6,9 @@ LICENSE file in the root directory of this source tree.
 #pragma once
 
 #include "common/Type.h"
+#include "congestion_unaware/LoadWindow.h"
 #include "congestion_unaware/Topology.h"
+#include <optional>
 
 using namespace NetworkAnalytical;
 
@@ -38,6 +40,53 @@ class BasicTopology : public Topology {
      */
     [[nodiscard]] EventTime send(DeviceId src, DeviceId dest, ChunkSize chunk_size) const noexcept override;
 
+    /**
+     * Implement the send_batch method of Topology.
+     * Chunks are processed in blocks: hops counts first, then delays.
+     */
+    void send_batch(const DeviceId* src,
+                    const DeviceId* dest,
+                    const ChunkSize* chunk_size,
+                    EventTime* comms_delay,
+                    size_t count) const noexcept override;
+
+    /**
+     * Implement the send_at method of Topology.
+     */
+    [[nodiscard]] EventTime send_at(DeviceId src,
+                                    DeviceId dest,
+                                    ChunkSize chunk_size,
+                                    EventTime send_time) noexcept override;
+
+    /**
+     * Implement the enable_congestion_estimation method of Topology.
+     */
+    void enable_congestion_estimation(CongestionModel congestion_model, EventTime window) noexcept override;
+
+    /**
+     * Set the number of identical copies of this topology the load is spread over,
+     * e.g., a MultiDimTopology dimension stands for npus_count / dim_npus_count copies.
+     *
+     * @param replicas_count number of copies
+     */
+    void set_replicas_count(int replicas_count) noexcept;
+
+    /**
+     * Estimate the queueing delay of a chunk sent at send_time
+     * from the load offered over the last window, then record the chunk's load.
+     * Returns 0 unless congestion estimation is enabled.
+     *
+     * @param src src NPU ID
+     * @param dest dest NPU ID
+     * @param chunk_size size of the chunk
+     * @param send_time time the chunk is sent
+     * @return queueing delay of the chunk
+     */
+    [[nodiscard]] double estimate_queueing_delay(DeviceId src,
+                                                 DeviceId dest,
+                                                 ChunkSize chunk_size,
+                                                 EventTime send_time) noexcept;
+
     /**
      * Return the type of the basic topology
      * as a TopologyBuildingBlock enum class element.
@@ -46,6 +95,16 @@ class BasicTopology : public Topology {
      */
     [[nodiscard]] TopologyBuildingBlock get_basic_topology_type() const noexcept;
 
+    /**
+     * Compute the latency of the path between src and dest,
+     * i.e., the communication delay without serialization.
+     *
+     * @param src src NPU ID
+     * @param dest dest NPU ID
+     * @return latency of the path between src and dest
+     */
+    [[nodiscard]] double compute_path_latency(DeviceId src, DeviceId dest) const noexcept;
+
   protected:
     /**
      * Compute the number of hops between src and dest.
@@ -56,18 +115,60 @@ class BasicTopology : public Topology {
      */
     [[nodiscard]] virtual int compute_hops_count(DeviceId src, DeviceId dest) const noexcept = 0;
 
+    /**
+     * Compute the number of hops of many src-dest pairs.
+     * Defaults to compute_hops_count per pair;
+     * topologies override it with branchless loops the compiler can vectorize.
+     *
+     * @param src src NPU ID of each pair
+     * @param dest dest NPU ID of each pair
+     * @param hops_count output: number of hops of each pair
+     * @param count number of pairs
+     */
+    virtual void compute_hops_count_batch(const DeviceId* src,
+                                          const DeviceId* dest,
+                                          int* hops_count,
+                                          size_t count) const noexcept;
+
+    /**
+     * Get the number of (unidirectional) links in the topology.
+     *
+     * @return number of links
+     */
+    [[nodiscard]] virtual int get_links_count() const noexcept = 0;
+
     /// type of the basic topology
     TopologyBuildingBlock basic_topology_type;
 
   private:
+    /// number of chunks processed together by send_batch
+    static constexpr size_t batch_block_size = 256;
+
+    /// utilization cap of the queueing models, which diverge at 1
+    static constexpr double max_utilization = 0.95;
+
     /**
      * Analytically compute the communication delay.
      *
      * @param hops_count number of hops between src and dest
      * @param chunk_size size of the chunk
+     * @param queueing_delay queueing delay to add
      * @return communication delay to send a chunk between src and dest
      */
-    [[nodiscard]] EventTime compute_communication_delay(int hops_count, ChunkSize chunk_size) const noexcept;
+    [[nodiscard]] EventTime compute_communication_delay(int hops_count,
+                                                        ChunkSize chunk_size,
+                                                        double queueing_delay = 0.0) const noexcept;
+
+    /**
+     * Compute the queueing delay of a chunk and record its load,
+     * see estimate_queueing_delay().
+     *
+     * @param hops_count number of hops between src and dest
+     * @param chunk_size size of the chunk
+     * @param send_time time the chunk is sent
+     * @return queueing delay of the chunk
+     */
+    [[nodiscard]] double compute_queueing_delay(int hops_count, ChunkSize chunk_size, EventTime send_time) noexcept;
 
     /// bandwidth of each link in GB/s
     Bandwidth bandwidth;
@@ -77,6 +178,18 @@ class BasicTopology : public Topology {
 
     /// latency of each link in ns
     Latency latency;
+
+    /// queueing model of send_at()
+    CongestionModel congestion_model;
+
+    /// link-bytes offered over the sliding window, when congestion estimation is enabled
+    std::optional<LoadWindow> load_window;
+
+    /// number of identical copies of this topology the load is spread over
+    int replicas_count;
+
+    /// aggregate capacity (B/ns) of all links of all copies
+    Bandwidth capacity_Bpns;
 };
 
 }  // namespace NetworkAnalyticalCongestionUnaware
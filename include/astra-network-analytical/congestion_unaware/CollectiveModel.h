@@ -0,0 +1,166 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/Type.h"
+#include "congestion_unaware/Topology.h"
+#include <memory>
+#include <utility>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionUnaware {
+
+/**
+ * CollectiveModel estimates the completion time of collective communications
+ * in closed form, without enumerating per-pair sends.
+ *
+ * Each algorithm is expressed as a sequence of steps,
+ * and each step costs a single Topology::send() of a representative NPU pair,
+ * so the model shares the latency/bandwidth arithmetic of the point-to-point API
+ * and takes O(dims + log(npus)) sends per estimate.
+ * As in send(), congestion is ignored: all transfers of a step run concurrently
+ * and the slowest representative pair bounds the step.
+ *
+ * The collective size is the per-NPU buffer size:
+ * the input of AllReduce, ReduceScatter, AllToAll, and Broadcast,
+ * and the output of AllGather.
+ */
+class CollectiveModel {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param topology topology to run collectives on
+     * @param pipeline_chunks_count number of chunks DoubleBinaryTree pipelines the buffer into
+     */
+    explicit CollectiveModel(std::shared_ptr<const Topology> topology, int pipeline_chunks_count = 1) noexcept;
+
+    /**
+     * Estimate the completion time of a collective over all NPUs.
+     * Ring, Direct, HalvingDoubling, and DoubleBinaryTree run flat over all NPUs;
+     * Hierarchical runs Ring on each dimension in turn.
+     *
+     * @param operation collective operation
+     * @param algorithm collective algorithm
+     * @param collective_size per-NPU buffer size
+     * @return completion time of the collective
+     */
+    [[nodiscard]] EventTime estimate(CollectiveOperation operation,
+                                     CollectiveAlgorithm algorithm,
+                                     ChunkSize collective_size) const noexcept;
+
+    /**
+     * Estimate the completion time of a hierarchical collective,
+     * which runs one algorithm per dimension, dimension by dimension.
+     * AllReduce is ReduceScatter from the lowest to the highest dimension
+     * followed by AllGather from the highest to the lowest dimension.
+     *
+     * @param operation collective operation
+     * @param algorithm_per_dim algorithm of each dimension (Hierarchical is not allowed)
+     * @param collective_size per-NPU buffer size
+     * @return completion time of the collective
+     */
+    [[nodiscard]] EventTime estimate_hierarchical(CollectiveOperation operation,
+                                                  const std::vector<CollectiveAlgorithm>& algorithm_per_dim,
+                                                  ChunkSize collective_size) const noexcept;
+
+  private:
+    /**
+     * NPUs taking part in a single-level collective:
+     * NPU (index * stride) for index in [0, npus_count).
+     */
+    struct Group {
+        /// number of NPUs in the group
+        int npus_count;
+
+        /// distance of adjacent group members in the NPU ID space
+        DeviceId stride;
+
+        /// (src, dest) pairs whose send() bounds a ring step
+        std::vector<std::pair<DeviceId, DeviceId>> ring_edges;
+
+        /// dest NPUs (from NPU 0) whose send() bounds a direct step
+        std::vector<DeviceId> farthest_npus;
+    };
+
+    /// topology to run collectives on
+    std::shared_ptr<const Topology> topology;
+
+    /// number of chunks DoubleBinaryTree pipelines the buffer into
+    int pipeline_chunks_count;
+
+    /// group of all NPUs
+    Group flat_group;
+
+    /// group of each dimension
+    std::vector<Group> group_per_dim;
+
+    /**
+     * Estimate a single-level collective over a group.
+     *
+     * @param group NPUs taking part in the collective
+     * @param operation collective operation
+     * @param algorithm collective algorithm (Hierarchical is not allowed)
+     * @param collective_size per-NPU buffer size
+     * @return completion time of the collective
+     */
+    [[nodiscard]] double estimate_group(const Group& group,
+                                        CollectiveOperation operation,
+                                        CollectiveAlgorithm algorithm,
+                                        double collective_size) const noexcept;
+
+    /**
+     * Time of a ring step: every member sends chunk_size to its ring neighbour.
+     *
+     * @param group NPUs taking part in the collective
+     * @param chunk_size size sent by each member
+     * @return time of the step
+     */
+    [[nodiscard]] double ring_step(const Group& group, double chunk_size) const noexcept;
+
+    /**
+     * Time of a direct step: every member sends chunk_size to every other member.
+     *
+     * @param group NPUs taking part in the collective
+     * @param chunk_size size sent to each peer
+     * @return time of the step
+     */
+    [[nodiscard]] double direct_step(const Group& group, double chunk_size) const noexcept;
+
+    /**
+     * Time of a step where every member sends chunk_size to the member distance apart.
+     *
+     * @param group NPUs taking part in the collective
+     * @param distance distance of the peer in group members
+     * @param chunk_size size sent by each member
+     * @return time of the step
+     */
+    [[nodiscard]] double partner_step(const Group& group, int distance, double chunk_size) const noexcept;
+
+    /**
+     * Time of a pipelined pass over the depth levels of a binary tree, in either direction.
+     *
+     * @param group NPUs taking part in the collective
+     * @param chunk_size size carried by the tree
+     * @return time of the pass
+     */
+    [[nodiscard]] double tree_pass(const Group& group, double chunk_size) const noexcept;
+
+    /**
+     * Estimate the time to send chunk_size from src to dest.
+     * Wraps Topology::send(), rounding chunk_size up to a whole byte.
+     *
+     * @param src src NPU ID
+     * @param dest dest NPU ID
+     * @param chunk_size size of the chunk
+     * @return time to send the chunk
+     */
+    [[nodiscard]] double send(DeviceId src, DeviceId dest, double chunk_size) const noexcept;
+};
+
+}  // namespace NetworkAnalyticalCongestionUnaware
@@ -0,0 +1,70 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/DragonflyLayout.h"
+#include "common/Type.h"
+#include "congestion_unaware/BasicTopology.h"
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionUnaware {
+
+/**
+ * Implements a Dragonfly topology: groups of fully-connected routers, linked by global links
+ * (see DragonflyLayout for the numbering of NPUs, routers, and global ports).
+ *
+ * A chunk takes the hops of its Minimal or Valiant route.
+ * Without link queues to compare, UGAL takes the Minimal route.
+ */
+class Dragonfly final : public BasicTopology {
+  public:
+    /**
+     * Constructor
+     *
+     * @param groups number of groups
+     * @param routers_per_group number of routers per group
+     * @param global_links_per_router number of global links per router
+     * @param npus_per_router number of NPUs per router
+     * @param arrangement how the global links of a group spread over the other groups
+     * @param routing how chunks are routed
+     * @param bandwidth bandwidth of each link
+     * @param latency latency of each link
+     */
+    Dragonfly(int groups,
+              int routers_per_group,
+              int global_links_per_router,
+              int npus_per_router,
+              DragonflyArrangement arrangement,
+              DragonflyRouting routing,
+              Bandwidth bandwidth,
+              Latency latency) noexcept;
+
+  private:
+    /**
+     * Implements the compute_hops_count method of BasicTopology.
+     */
+    [[nodiscard]] int compute_hops_count(DeviceId src, DeviceId dest) const noexcept override;
+
+    /**
+     * Implements the get_links_count method of BasicTopology.
+     */
+    [[nodiscard]] int get_links_count() const noexcept override;
+
+    /// numbering and arithmetic routes of the NPUs and routers
+    DragonflyLayout layout;
+
+    /// how chunks are routed
+    DragonflyRouting routing;
+
+    /// number of global links per router
+    int global_links_per_router;
+
+    /// number of routers per group
+    int routers_per_group;
+};
+
+}  // namespace NetworkAnalyticalCongestionUnaware
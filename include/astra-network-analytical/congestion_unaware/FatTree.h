@@ -0,0 +1,64 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/Type.h"
+#include "congestion_unaware/BasicTopology.h"
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionUnaware {
+
+/**
+ * Implements a k-ary fat-tree (folded Clos) of switches with the given radix and tiers.
+ *
+ * Switches of the upper tiers have k = radix / 2 down and k up ports,
+ * and a leaf switch splits its radix into radix * o / (o + 1) NPUs and radix / (o + 1) uplinks,
+ * o being the oversubscription ratio.
+ * Leaves are numbered by (tiers - 1) base-k digits.
+ *
+ * A chunk goes up to the tier above the highest digit where the leaves of src and dest differ, then down.
+ * Every equal-cost route has the same number of hops.
+ */
+class FatTree final : public BasicTopology {
+  public:
+    /**
+     * Constructor
+     *
+     * @param radix number of ports per switch
+     * @param tiers number of switch tiers
+     * @param oversubscription ratio of endpoints to uplinks of a leaf switch
+     * @param bandwidth bandwidth of each link
+     * @param latency latency of each link
+     */
+    FatTree(int radix, int tiers, int oversubscription, Bandwidth bandwidth, Latency latency) noexcept;
+
+  private:
+    /**
+     * Implements the compute_hops_count method of BasicTopology.
+     */
+    [[nodiscard]] int compute_hops_count(DeviceId src, DeviceId dest) const noexcept override;
+
+    /**
+     * Implements the get_links_count method of BasicTopology.
+     */
+    [[nodiscard]] int get_links_count() const noexcept override;
+
+    /// number of switch tiers
+    int tiers;
+
+    /// arity of the upper tiers (radix / 2)
+    int arity;
+
+    /// NPUs per leaf switch
+    int leaf_npus_count;
+
+    /// uplinks per leaf switch
+    int leaf_uplinks_count;
+};
+
+}  // namespace NetworkAnalyticalCongestionUnaware
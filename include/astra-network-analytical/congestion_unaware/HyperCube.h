@@ -46,6 +46,19 @@ class HyperCube final : public BasicTopology {
      */
     [[nodiscard]] int compute_hops_count(DeviceId src, DeviceId dest) const noexcept override;
 
+    /**
+     * Implements the compute_hops_count_batch method of BasicTopology.
+     */
+    void compute_hops_count_batch(const DeviceId* src,
+                                  const DeviceId* dest,
+                                  int* hops_count,
+                                  size_t count) const noexcept override;
+
+    /**
+     * Implements the get_links_count method of BasicTopology.
+     */
+    [[nodiscard]] int get_links_count() const noexcept override;
+
     /// true if the hypercube is bidirectional, false otherwise
     bool bidirectional;
 };
@@ -0,0 +1,78 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/Type.h"
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionUnaware {
+
+/**
+ * LoadWindow accumulates the bytes offered to a set of links
+ * over a sliding time window.
+ *
+ * The window is split into buckets_count buckets kept in a ring,
+ * so recording and querying are O(1) amortized:
+ * moving forward in time only clears the buckets that fell out of the window.
+ * Records older than the newest bucket are folded into the newest bucket.
+ */
+class LoadWindow {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param window length of the sliding window in ns
+     * @param buckets_count number of buckets the window is split into
+     */
+    explicit LoadWindow(EventTime window, int buckets_count = 16) noexcept;
+
+    /**
+     * Record bytes offered at the given time.
+     *
+     * @param time time the bytes are offered
+     * @param bytes number of bytes
+     */
+    void add(EventTime time, double bytes) noexcept;
+
+    /**
+     * Get the bytes offered within the window ending at the given time.
+     *
+     * @param time end of the window
+     * @return bytes offered within the window
+     */
+    [[nodiscard]] double get_bytes(EventTime time) noexcept;
+
+    /**
+     * Get the length of the window.
+     *
+     * @return length of the window in ns
+     */
+    [[nodiscard]] EventTime get_window() const noexcept;
+
+  private:
+    /// width of each bucket in ns
+    EventTime bucket_width;
+
+    /// bytes per bucket, indexed as a ring
+    std::vector<double> bucket_bytes;
+
+    /// index of the bucket covering the newest time
+    EventTime newest_bucket;
+
+    /// sum of bucket_bytes
+    double window_bytes;
+
+    /**
+     * Slide the window forward so that the newest bucket covers the given time.
+     *
+     * @param time time to slide to
+     */
+    void advance(EventTime time) noexcept;
+};
+
+}  // namespace NetworkAnalyticalCongestionUnaware
@@ -27,9 +27,37 @@ class MultiDimTopology : public Topology {
 
     /**
      * Implement the send method of Topology.
+     * How a chunk crossing multiple dimensions is charged depends on the send mode.
      */
     [[nodiscard]] EventTime send(DeviceId src, DeviceId dest, ChunkSize chunk_size) const noexcept override;
 
+    /**
+     * Implement the send_batch method of Topology.
+     * Each block of chunks is split by the dimension it transfers over,
+     * and each split runs through that dimension's batched kernel.
+     * Other than MultiDimSendMode::FirstDim, falls back to send() per chunk.
+     */
+    void send_batch(const DeviceId* src,
+                    const DeviceId* dest,
+                    const ChunkSize* chunk_size,
+                    EventTime* comms_delay,
+                    size_t count) const noexcept override;
+
+    /**
+     * Implement the send_at method of Topology.
+     * Every dimension the chunk is charged on (see send()) adds its queueing term.
+     */
+    [[nodiscard]] EventTime send_at(DeviceId src,
+                                    DeviceId dest,
+                                    ChunkSize chunk_size,
+                                    EventTime send_time) noexcept override;
+
+    /**
+     * Implement the enable_congestion_estimation method of Topology.
+     * Each dimension tracks the load of all its copies.
+     */
+    void enable_congestion_estimation(CongestionModel congestion_model, EventTime window) noexcept override;
+
     /**
      * Add a dimension to the multi-dimensional topology.
      *
@@ -37,29 +65,44 @@ class MultiDimTopology : public Topology {
      */
     void append_dimension(std::unique_ptr<BasicTopology> basic_topology) noexcept;
 
+    /**
+     * Set how send() charges a chunk crossing multiple dimensions.
+     *
+     * @param send_mode multi-dimension send mode
+     */
+    void set_send_mode(MultiDimSendMode send_mode) noexcept;
+
   private:
+    /// number of chunks processed together by send_batch
+    static constexpr size_t batch_block_size = 256;
+
     /// BasicTopology instances per dimension.
     std::vector<std::unique_ptr<BasicTopology>> topology_per_dim;
 
-    /**
-     * Translate the NPU ID into a multi-dimensional address.
-     *
-     * @param npu_id id of the NPU
-     * @return the same NPU in multi-dimensional address representation
-     */
-    [[nodiscard]] MultiDimAddress translate_address(DeviceId npu_id) const noexcept;
+    /// stride of each dimension in the NPU ID space, e.g., [1, 2, 16] for [2, 8, 4]
+    std::vector<DeviceId> npus_stride_per_dim;
+
+    /// bandwidth (B/ns) per each network dimension
+    std::vector<Bandwidth> bandwidth_Bpns_per_dim;
+
+    /// how send() charges a chunk crossing multiple dimensions
+    MultiDimSendMode send_mode;
 
     /**
-     * Given src and dest address in multi-dimensional form,
-     * return the dimension where the transfer should happen.
-     * i.e., the dimension where the src and dest addresses differ.
+     * Charge every dimension where src and dest differ,
+     * following MultiDimSendMode::Accumulate or MultiDimSendMode::Pipelined.
+     * Addresses are decoded with npus_stride_per_dim, without allocation.
      *
-     * @param src_address src NPU ID in multi-dimensional form
-     * @param dest_address dest NPU ID in multi-dimensional form
-     * @return the dimension where the transfer should happen
+     * @param src src NPU ID
+     * @param dest dest NPU ID
+     * @param chunk_size size of the chunk to send
+     * @param queueing_delay queueing delay to add
+     * @return time to send the chunk from src to dest
      */
-    [[nodiscard]] int get_dim_to_transfer(const MultiDimAddress& src_address,
-                                          const MultiDimAddress& dest_address) const noexcept;
+    [[nodiscard]] EventTime send_across_dims(DeviceId src,
+                                             DeviceId dest,
+                                             ChunkSize chunk_size,
+                                             double queueing_delay = 0.0) const noexcept;
 };
 
 }  // namespace NetworkAnalyticalCongestionUnaware
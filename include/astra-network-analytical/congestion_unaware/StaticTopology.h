@@ -0,0 +1,419 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/NetworkFunction.h"
+#include "common/Type.h"
+#include "congestion_unaware/Topology.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <tuple>
+#include <utility>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionUnaware {
+
+/**
+ * Compile-time sized counterpart of BasicTopology.
+ * Derived classes provide a static constexpr compute_hops_count(),
+ * which is resolved statically (CRTP) so that the whole delay computation inlines
+ * and divisions by the NPUs count are strength-reduced.
+ *
+ * The delay arithmetic is the same as BasicTopology,
+ * so a StaticRing<16> returns exactly what Ring(16) returns.
+ * Classes are final: calls through the concrete type are devirtualized,
+ * while the Topology interface keeps them usable anywhere a Topology is.
+ *
+ * @tparam Derived concrete static topology
+ * @tparam NpusCount number of NPUs in the topology
+ * @tparam BuildingBlock type of the basic topology
+ */
+template <typename Derived, int NpusCount, TopologyBuildingBlock BuildingBlock>
+class StaticBasicTopology : public Topology {
+  public:
+    static_assert(NpusCount > 0, "NpusCount should be positive");
+
+    /// number of NPUs in the topology
+    static constexpr int npus_count_static = NpusCount;
+
+    /// type of the basic topology
+    static constexpr TopologyBuildingBlock basic_topology_type = BuildingBlock;
+
+    /**
+     * Constructor.
+     *
+     * @param bandwidth bandwidth of each link in the topology
+     * @param latency latency of each link in the topology
+     */
+    StaticBasicTopology(const Bandwidth bandwidth, const Latency latency) noexcept
+        : bandwidth_Bpns(bw_GBps_to_Bpns(bandwidth)),
+          latency(latency),
+          Topology() {
+        assert(bandwidth > 0);
+        assert(latency >= 0);
+
+        // set topology shape
+        npus_count = NpusCount;
+        npus_count_per_dim.push_back(NpusCount);
+        dims_count = 1;
+        bandwidth_per_dim.push_back(bandwidth);
+    }
+
+    /**
+     * Implement the send method of Topology.
+     */
+    [[nodiscard]] EventTime send(const DeviceId src, const DeviceId dest, const ChunkSize chunk_size) const
+        noexcept override {
+        assert(0 <= src && src < NpusCount);
+        assert(0 <= dest && dest < NpusCount);
+        assert(src != dest);
+        assert(chunk_size > 0);
+
+        // same arithmetic as BasicTopology::compute_communication_delay
+        const auto link_delay = compute_path_latency(src, dest);
+        const auto serialization_delay = static_cast<double>(chunk_size) / bandwidth_Bpns;
+        return static_cast<EventTime>(link_delay + serialization_delay);
+    }
+
+    /**
+     * Implement the send_batch method of Topology.
+     */
+    void send_batch(const DeviceId* const src,
+                    const DeviceId* const dest,
+                    const ChunkSize* const chunk_size,
+                    EventTime* const comms_delay,
+                    const size_t count) const noexcept override {
+        for (size_t i = 0; i < count; i++) {
+            comms_delay[i] = send(src[i], dest[i], chunk_size[i]);
+        }
+    }
+
+    /**
+     * Compute the latency of the path between src and dest.
+     *
+     * @param src src NPU ID
+     * @param dest dest NPU ID
+     * @return latency of the path between src and dest
+     */
+    [[nodiscard]] double compute_path_latency(const DeviceId src, const DeviceId dest) const noexcept {
+        return Derived::compute_hops_count(src, dest) * latency;
+    }
+
+    /**
+     * Get the bandwidth of each link in B/ns.
+     *
+     * @return bandwidth of each link in B/ns
+     */
+    [[nodiscard]] Bandwidth get_bandwidth_Bpns() const noexcept {
+        return bandwidth_Bpns;
+    }
+
+  private:
+    /// bandwidth of each link in B/ns, used for actual computation
+    Bandwidth bandwidth_Bpns;
+
+    /// latency of each link in ns
+    Latency latency;
+};
+
+/**
+ * Ring of NpusCount NPUs, see Ring.
+ *
+ * @tparam NpusCount number of NPUs in the Ring
+ * @tparam Bidirectional whether the ring is bidirectional
+ */
+template <int NpusCount, bool Bidirectional = true>
+class StaticRing final
+    : public StaticBasicTopology<StaticRing<NpusCount, Bidirectional>, NpusCount, TopologyBuildingBlock::Ring> {
+  public:
+    using StaticBasicTopology<StaticRing, NpusCount, TopologyBuildingBlock::Ring>::StaticBasicTopology;
+
+    /**
+     * Compute the number of hops between src and dest.
+     *
+     * @param src src NPU ID
+     * @param dest dest NPU ID
+     * @return number of hops between src and dest
+     */
+    [[nodiscard]] static constexpr int compute_hops_count(const DeviceId src, const DeviceId dest) noexcept {
+        // modulo by a constant: strength-reduced
+        const auto clockwise_distance = (dest - src + NpusCount) % NpusCount;
+        if constexpr (!Bidirectional) {
+            return clockwise_distance;
+        }
+        return std::min(clockwise_distance, NpusCount - clockwise_distance);
+    }
+};
+
+/**
+ * FullyConnected topology of NpusCount NPUs, see FullyConnected.
+ *
+ * @tparam NpusCount number of NPUs in the FullyConnected topology
+ */
+template <int NpusCount>
+class StaticFullyConnected final
+    : public StaticBasicTopology<StaticFullyConnected<NpusCount>, NpusCount, TopologyBuildingBlock::FullyConnected> {
+  public:
+    using StaticBasicTopology<StaticFullyConnected, NpusCount,
+                              TopologyBuildingBlock::FullyConnected>::StaticBasicTopology;
+
+    /**
+     * Compute the number of hops between src and dest.
+     *
+     * @param src src NPU ID
+     * @param dest dest NPU ID
+     * @return number of hops between src and dest
+     */
+    [[nodiscard]] static constexpr int compute_hops_count(const DeviceId src, const DeviceId dest) noexcept {
+        // directly connected
+        return 1;
+    }
+};
+
+/**
+ * Switch topology of NpusCount NPUs, see Switch.
+ *
+ * @tparam NpusCount number of NPUs connected to the Switch
+ */
+template <int NpusCount>
+class StaticSwitch final
+    : public StaticBasicTopology<StaticSwitch<NpusCount>, NpusCount, TopologyBuildingBlock::Switch> {
+  public:
+    using StaticBasicTopology<StaticSwitch, NpusCount, TopologyBuildingBlock::Switch>::StaticBasicTopology;
+
+    /**
+     * Compute the number of hops between src and dest.
+     *
+     * @param src src NPU ID
+     * @param dest dest NPU ID
+     * @return number of hops between src and dest
+     */
+    [[nodiscard]] static constexpr int compute_hops_count(const DeviceId src, const DeviceId dest) noexcept {
+        // src -> switch -> dest
+        return 2;
+    }
+};
+
+/**
+ * Mesh of NpusCount NPUs, see Mesh.
+ *
+ * @tparam NpusCount number of NPUs in the Mesh
+ */
+template <int NpusCount>
+class StaticMesh final : public StaticBasicTopology<StaticMesh<NpusCount>, NpusCount, TopologyBuildingBlock::Mesh> {
+  public:
+    using StaticBasicTopology<StaticMesh, NpusCount, TopologyBuildingBlock::Mesh>::StaticBasicTopology;
+
+    /**
+     * Compute the number of hops between src and dest.
+     *
+     * @param src src NPU ID
+     * @param dest dest NPU ID
+     * @return number of hops between src and dest
+     */
+    [[nodiscard]] static constexpr int compute_hops_count(const DeviceId src, const DeviceId dest) noexcept {
+        return (src < dest) ? dest - src : src - dest;
+    }
+};
+
+/**
+ * HyperCube of 2^LogNpusCount NPUs, see HyperCube.
+ *
+ * @tparam LogNpusCount log2 of the number of NPUs in the HyperCube
+ */
+template <int LogNpusCount>
+class StaticHyperCube final : public StaticBasicTopology<StaticHyperCube<LogNpusCount>,
+                                                         (1 << LogNpusCount),
+                                                         TopologyBuildingBlock::HyperCube> {
+  public:
+    static_assert(0 <= LogNpusCount && LogNpusCount < 31, "LogNpusCount out of range");
+
+    using StaticBasicTopology<StaticHyperCube, (1 << LogNpusCount),
+                              TopologyBuildingBlock::HyperCube>::StaticBasicTopology;
+
+    /**
+     * Compute the number of hops between src and dest.
+     *
+     * @param src src NPU ID
+     * @param dest dest NPU ID
+     * @return number of hops between src and dest
+     */
+    [[nodiscard]] static constexpr int compute_hops_count(const DeviceId src, const DeviceId dest) noexcept {
+        // Hamming distance with a SWAR popcount
+        auto diff = static_cast<uint32_t>(src ^ dest);
+        diff = diff - ((diff >> 1) & 0x55555555U);
+        diff = (diff & 0x33333333U) + ((diff >> 2) & 0x33333333U);
+        diff = (diff + (diff >> 4)) & 0x0F0F0F0FU;
+        return static_cast<int>((diff * 0x01010101U) >> 24);
+    }
+};
+
+/**
+ * Compile-time shaped counterpart of MultiDimTopology,
+ * whose dimensions are given as a list of static basic topologies.
+ * Address decoding uses constexpr strides, and every dimension is dispatched statically.
+ *
+ * StaticMultiDimTopology<StaticRing<2>, StaticFullyConnected<8>, StaticSwitch<4>> example:
+ * same shape as Ring_FullyConnected_Switch.yml.
+ *
+ * @tparam Dims static basic topology of each dimension, from the lowest one
+ */
+template <typename... Dims>
+class StaticMultiDimTopology final : public Topology {
+  public:
+    static_assert(sizeof...(Dims) > 0, "at least one dimension is required");
+
+    /// number of network dimensions
+    static constexpr int dims_count_static = sizeof...(Dims);
+
+    /// number of NPUs in the topology
+    static constexpr int npus_count_static = (Dims::npus_count_static * ...);
+
+    /**
+     * Constructor.
+     *
+     * @param dims basic topology of each dimension
+     */
+    explicit StaticMultiDimTopology(Dims... dims) noexcept
+        : topology_per_dim(std::move(dims)...),
+          send_mode(MultiDimSendMode::FirstDim),
+          Topology() {
+        // set topology shape
+        npus_count = npus_count_static;
+        dims_count = dims_count_static;
+        npus_count_per_dim = {Dims::npus_count_static...};
+        std::apply([this](const auto&... dim) { (bandwidth_per_dim.push_back(dim.get_bandwidth_per_dim()[0]), ...); },
+                   topology_per_dim);
+    }
+
+    /**
+     * Implement the send method of Topology.
+     * Same semantics as MultiDimTopology::send().
+     */
+    [[nodiscard]] EventTime send(const DeviceId src, const DeviceId dest, const ChunkSize chunk_size) const
+        noexcept override {
+        assert(0 <= src && src < npus_count_static);
+        assert(0 <= dest && dest < npus_count_static);
+        assert(src != dest);
+        assert(chunk_size > 0);
+
+        if (send_mode == MultiDimSendMode::FirstDim) {
+            return send_first_dim(src, dest, chunk_size, std::index_sequence_for<Dims...>());
+        }
+        return send_across_dims(src, dest, chunk_size, std::index_sequence_for<Dims...>());
+    }
+
+    /**
+     * Implement the send_batch method of Topology.
+     */
+    void send_batch(const DeviceId* const src,
+                    const DeviceId* const dest,
+                    const ChunkSize* const chunk_size,
+                    EventTime* const comms_delay,
+                    const size_t count) const noexcept override {
+        for (size_t i = 0; i < count; i++) {
+            comms_delay[i] = send(src[i], dest[i], chunk_size[i]);
+        }
+    }
+
+    /**
+     * Set how send() charges a chunk crossing multiple dimensions.
+     *
+     * @param send_mode multi-dimension send mode
+     */
+    void set_send_mode(const MultiDimSendMode send_mode) noexcept {
+        this->send_mode = send_mode;
+    }
+
+  private:
+    /// stride of each dimension in the NPU ID space
+    static constexpr std::array<DeviceId, sizeof...(Dims)> npus_stride_per_dim = [] {
+        auto strides = std::array<DeviceId, sizeof...(Dims)>();
+        const auto npus_counts = std::array<int, sizeof...(Dims)>{Dims::npus_count_static...};
+        auto stride = DeviceId{1};
+        for (size_t dim = 0; dim < sizeof...(Dims); dim++) {
+            strides[dim] = stride;
+            stride *= npus_counts[dim];
+        }
+        return strides;
+    }();
+
+    /// basic topology of each dimension
+    std::tuple<Dims...> topology_per_dim;
+
+    /// how send() charges a chunk crossing multiple dimensions
+    MultiDimSendMode send_mode;
+
+    /**
+     * Get the local ID of an NPU in a dimension.
+     *
+     * @tparam Dim dimension
+     * @param npu_id NPU ID
+     * @return local ID of the NPU in the dimension
+     */
+    template <size_t Dim> [[nodiscard]] static constexpr DeviceId local_id(const DeviceId npu_id) noexcept {
+        using DimTopology = std::tuple_element_t<Dim, std::tuple<Dims...>>;
+        return (npu_id / npus_stride_per_dim[Dim]) % DimTopology::npus_count_static;
+    }
+
+    /**
+     * Charge only the lowest dimension where src and dest differ.
+     */
+    template <size_t... Dim>
+    [[nodiscard]] EventTime send_first_dim(const DeviceId src,
+                                           const DeviceId dest,
+                                           const ChunkSize chunk_size,
+                                           std::index_sequence<Dim...>) const noexcept {
+        auto comms_delay = EventTime{0};
+
+        // short-circuits at the first differing dimension
+        const auto sent = ((local_id<Dim>(src) != local_id<Dim>(dest) &&
+                            (comms_delay = std::get<Dim>(topology_per_dim).send(local_id<Dim>(src),
+                                                                                local_id<Dim>(dest), chunk_size),
+                             true)) ||
+                           ...);
+        assert(sent);
+        (void)sent;
+
+        return comms_delay;
+    }
+
+    /**
+     * Charge every dimension where src and dest differ, see MultiDimTopology::send_across_dims().
+     */
+    template <size_t... Dim>
+    [[nodiscard]] EventTime send_across_dims(const DeviceId src,
+                                             const DeviceId dest,
+                                             const ChunkSize chunk_size,
+                                             std::index_sequence<Dim...>) const noexcept {
+        auto link_delay = 0.0;
+        auto serialization_delay = 0.0;
+        auto slowest_bandwidth_Bpns = std::numeric_limits<Bandwidth>::max();
+
+        const auto charge_dim = [&](const auto& topology, const DeviceId src_local_id, const DeviceId dest_local_id) {
+            if (src_local_id == dest_local_id) {
+                return;
+            }
+            link_delay += topology.compute_path_latency(src_local_id, dest_local_id);
+            serialization_delay += static_cast<double>(chunk_size) / topology.get_bandwidth_Bpns();
+            slowest_bandwidth_Bpns = std::min(slowest_bandwidth_Bpns, topology.get_bandwidth_Bpns());
+        };
+        (charge_dim(std::get<Dim>(topology_per_dim), local_id<Dim>(src), local_id<Dim>(dest)), ...);
+
+        if (send_mode == MultiDimSendMode::Pipelined) {
+            serialization_delay = static_cast<double>(chunk_size) / slowest_bandwidth_Bpns;
+        }
+
+        return static_cast<EventTime>(link_delay + serialization_delay);
+    }
+};
+
+}  // namespace NetworkAnalyticalCongestionUnaware
@@ -6,6 +6,7 @@ LICENSE file in the root directory of this source tree.
 #pragma once
 
 #include "common/Type.h"
+#include <cstddef>
 #include <vector>
 
 using namespace NetworkAnalytical;
@@ -33,6 +34,49 @@ class Topology {
      */
     [[nodiscard]] virtual EventTime send(DeviceId src, DeviceId dest, ChunkSize chunk_size) const noexcept = 0;
 
+    /**
+     * Estimate the communication delay of many chunks at once.
+     * Equivalent to comms_delay[i] = send(src[i], dest[i], chunk_size[i]) for every i,
+     * but topologies override it with batched kernels.
+     *
+     * @param src src NPU ID of each chunk
+     * @param dest dest NPU ID of each chunk
+     * @param chunk_size size of each chunk
+     * @param comms_delay output: time to send each chunk from src to dest
+     * @param count number of chunks
+     */
+    virtual void send_batch(const DeviceId* src,
+                            const DeviceId* dest,
+                            const ChunkSize* chunk_size,
+                            EventTime* comms_delay,
+                            size_t count) const noexcept;
+
+    /**
+     * Estimate the time to transmit a chunk sent at send_time,
+     * adding a queueing term for the load the topology has recently carried,
+     * and record the chunk's load.
+     * Same as send() unless congestion estimation is enabled.
+     *
+     * @param src src NPU ID
+     * @param dest dest NPU ID
+     * @param chunk_size size of the chunk to send
+     * @param send_time time the chunk is sent
+     * @return time to send the chunk from src to dest
+     */
+    [[nodiscard]] virtual EventTime send_at(DeviceId src,
+                                            DeviceId dest,
+                                            ChunkSize chunk_size,
+                                            EventTime send_time) noexcept;
+
+    /**
+     * Enable congestion estimation for send_at():
+     * the load offered over the last window is turned into a queueing term.
+     *
+     * @param congestion_model queueing model
+     * @param window length of the sliding window in ns
+     */
+    virtual void enable_congestion_estimation(CongestionModel congestion_model, EventTime window) noexcept;
+
     /**
      * Get the number of NPUs in the topology.
      *
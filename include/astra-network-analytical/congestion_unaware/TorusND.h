@@ -0,0 +1,78 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/Type.h"
+#include "congestion_unaware/BasicTopology.h"
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionUnaware {
+
+/**
+ * Implements an N-dimensional torus or mesh topology with per-axis sizes.
+ * Each NPU links to its neighbours along every axis; an axis with wraparound closes into a ring.
+ * TorusND wraps around every axis, and MeshND none.
+ *
+ * NPU IDs are row-major with axis 0 being the fastest,
+ * e.g., NPU (x, y, z) of shape [X, Y, Z] is x + (y * X) + (z * X * Y).
+ *
+ * TorusND([4, 2]) example:
+ *   ___________________
+ *  |_ 0 - 1 - 2 - 3 _|
+ *     |   |   |   |
+ *   _ 4 - 5 - 6 - 7 _
+ *  |_________________|
+ *
+ * A chunk crosses the axes one by one,
+ * taking the shorter direction of every axis with wraparound.
+ *
+ * The axes already span the whole network, so TorusND is only built as a single-dimensional topology
+ * and never as a dimension of a MultiDimTopology.
+ */
+class TorusND final : public BasicTopology {
+  public:
+    /**
+     * Constructor
+     *
+     * @param shape number of NPUs along each axis
+     * @param bandwidth bandwidth of each link
+     * @param latency latency of each link
+     * @param wraparound whether each axis wraps around
+     * @param bidirectional whether the links are bidirectional, defaults to true; false only if every axis wraps around
+     */
+    TorusND(const std::vector<int>& shape,
+            Bandwidth bandwidth,
+            Latency latency,
+            const std::vector<bool>& wraparound,
+            bool bidirectional = true) noexcept;
+
+  private:
+    /**
+     * Implements the compute_hops_count method of BasicTopology.
+     */
+    [[nodiscard]] int compute_hops_count(DeviceId src, DeviceId dest) const noexcept override;
+
+    /**
+     * Implements the get_links_count method of BasicTopology.
+     */
+    [[nodiscard]] int get_links_count() const noexcept override;
+
+    /// number of NPUs along each axis
+    std::vector<int> shape;
+
+    /// NPU ID stride of each axis
+    std::vector<DeviceId> strides;
+
+    /// whether each axis wraps around
+    std::vector<bool> wraparound;
+
+    /// true if the links are bidirectional, false otherwise
+    bool bidirectional;
+};
+
+}  // namespace NetworkAnalyticalCongestionUnaware
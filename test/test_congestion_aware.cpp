@@ -4,11 +4,35 @@ LICENSE file in the root directory of this source tree.
 *******************************************************************************/
 
 #include "common/EventQueue.h"
+#include "common/Instrumentation.h"
 #include "common/NetworkParser.h"
+#include "common/ProgressReporter.h"
 #include "common/Type.h"
 #include "congestion_aware/Chunk.h"
+#include "congestion_aware/ChunkTracer.h"
+#include "congestion_aware/CollectiveGenerator.h"
+#include "congestion_aware/DagExecutor.h"
+#include "congestion_aware/DoubleBinaryTree.h"
+#include "congestion_aware/Dragonfly.h"
+#include "congestion_aware/FatTree.h"
 #include "congestion_aware/Helper.h"
+#include "congestion_aware/MultiDimTopology.h"
+#include "congestion_aware/Ring.h"
+#include "congestion_aware/SwitchTranslationUnit.h"
+#include "congestion_aware/SymmetricSimulation.h"
+#include "congestion_aware/TorusND.h"
+#include "congestion_aware/TraceReplayer.h"
+#include "congestion_aware/TrafficGenerator.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
 #include <gtest/gtest.h>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
 
 using namespace NetworkAnalytical;
 using namespace NetworkAnalyticalCongestionAware;
@@ -28,6 +52,134 @@ class TestNetworkAnalyticalCongestionAware : public ::testing::Test {
 
     static void callback(void* const arg) {}
 
+    /**
+     * Send a chunk between every pair of NPUs and run the simulation.
+     *
+     * @param topology topology to run All-to-All on
+     * @param max_steps number of events to process before stopping early, -1 to run to the end
+     * @return time when the simulation stopped
+     */
+    EventTime run_all_to_all(Topology& topology, const int max_steps = -1) const {
+        const auto npus_count = topology.get_npus_count();
+        for (int i = 0; i < npus_count; i++) {
+            for (int j = 0; j < npus_count; j++) {
+                if (i == j) {
+                    continue;
+                }
+
+                // create a chunk
+                auto route = topology.route(i, j);
+                auto chunk = std::make_unique<Chunk>(chunk_size, route, callback, nullptr);
+
+                // send a chunk
+                topology.send(std::move(chunk));
+            }
+        }
+
+        for (int step = 0; !event_queue->finished() && step != max_steps; step++) {
+            event_queue->proceed();
+        }
+        return event_queue->get_current_time();
+    }
+
+    /**
+     * Start a fresh simulation on the topology: a new event queue, and the topology reset.
+     *
+     * @param topology topology to simulate
+     */
+    void reset_simulation(Topology& topology) {
+        event_queue = std::make_shared<EventQueue>();
+        Topology::set_event_queue(event_queue);
+        topology.reset();
+    }
+
+    /**
+     * Run a DAG of sends on a fresh simulation of the topology.
+     *
+     * @param topology topology to run the DAG on
+     * @param nodes nodes of the DAG
+     * @param edges dependencies as (predecessor, successor) node indices
+     * @return finished DagExecutor
+     */
+    std::unique_ptr<DagExecutor> run_dag(const std::shared_ptr<Topology>& topology,
+                                         std::vector<DagNode> nodes,
+                                         const std::vector<std::pair<int, int>>& edges) {
+        reset_simulation(*topology);
+
+        auto dag_executor = std::make_unique<DagExecutor>(topology, event_queue, std::move(nodes), edges);
+        dag_executor->start();
+        while (!event_queue->finished()) {
+            event_queue->proceed();
+        }
+        EXPECT_TRUE(dag_executor->finished());
+        return dag_executor;
+    }
+
+    /**
+     * Run a collective schedule on a fresh simulation of the topology.
+     *
+     * @param topology topology to run the schedule on
+     * @param schedule schedule to run
+     * @return finish time of the schedule
+     */
+    EventTime run_schedule(const std::shared_ptr<Topology>& topology, const CollectiveSchedule& schedule) {
+        run_dag(topology, schedule.nodes, schedule.edges);
+        return event_queue->get_current_time();
+    }
+
+    /**
+     * Time a single uncontended send from NPU 0.
+     *
+     * @param topology topology to send on
+     * @param dest dest NPU ID
+     * @param size size of the chunk
+     * @return time of the send
+     */
+    EventTime time_send(const std::shared_ptr<Topology>& topology, const DeviceId dest, const ChunkSize size) {
+        return run_schedule(topology, {{{0, dest, size}}, {}});
+    }
+
+    /**
+     * IDs of the devices along a route.
+     *
+     * @param route route to read
+     * @return device IDs from src to dest
+     */
+    static std::vector<DeviceId> route_ids(const Route& route) {
+        auto ids = std::vector<DeviceId>();
+        for (const auto& device : route) {
+            ids.push_back(device->get_id());
+        }
+        return ids;
+    }
+
+    /**
+     * Time a single chunk along a route, run to the end of the simulation.
+     *
+     * @param topology topology owning the route
+     * @param route route of the chunk
+     * @return time the chunk took
+     */
+    EventTime time_route(Topology& topology, Route route) const {
+        const auto start_time = event_queue->get_current_time();
+        topology.send(std::make_unique<Chunk>(chunk_size, std::move(route), callback, nullptr));
+        while (!event_queue->finished()) {
+            event_queue->proceed();
+        }
+        return event_queue->get_current_time() - start_time;
+    }
+
+    /**
+     * Time a single chunk over a number of hops of a unidirectional ring of 50 GB/s, 500 ns links.
+     *
+     * @param hops_count number of hops of the route
+     * @return time the chunk took
+     */
+    EventTime time_ring_route(const int hops_count) const {
+        auto ring = Ring(hops_count + 1, 50, 500, /*bidirectional=*/false);
+        return time_route(ring, ring.route(0, hops_count));
+    }
+
     ChunkSize chunk_size;
 };
 
@@ -53,6 +205,167 @@ TEST_F(TestNetworkAnalyticalCongestionAware, Ring) {
     EXPECT_EQ(simulation_time, 60'093);
 }
 
+TEST_F(TestNetworkAnalyticalCongestionAware, TorusND) {
+    /// setup: 4x4x4 torus
+    const auto network_parser = NetworkParser("../../input/TorusND.yml");
+    const auto topology = construct_topology(network_parser);
+
+    /// test: dimension-ordered routes, through the wraparound links
+    EXPECT_EQ(route_ids(topology->route(0, 63)), (std::vector<DeviceId>{0, 3, 15, 63}));
+    EXPECT_EQ(route_ids(topology->route(0, 42)), (std::vector<DeviceId>{0, 1, 2, 6, 10, 26, 42}));
+
+    // a mesh of the same shape has no wraparound links
+    const auto mesh = TorusND({4, 4, 4}, 50, 500, {false, false, false});
+    EXPECT_EQ(mesh.route(0, 63).size(), 10);
+    EXPECT_EQ(mesh.get_connection_policies().size(), 3 * 16 * 3 * 2);
+
+    // an axis of two NPUs has a single link each way
+    const auto thin_torus = TorusND({2, 3}, 50, 500, {true, true});
+    EXPECT_EQ(thin_torus.get_connection_policies().size(), (3 * 1 * 2) + (2 * 3 * 2));
+
+    /// test: the same timing as a ring route of as many hops
+    EXPECT_EQ(time_route(*topology, topology->route(0, 63)), time_ring_route(3));
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, FatTree) {
+    /// setup: radix-8, 3-tier fat-tree of 64 NPUs (leaves 64-79, aggregation 80-95, core 96-111)
+    const auto network_parser = NetworkParser("../../input/FatTree.yml");
+    const auto topology = construct_topology(network_parser);
+    EXPECT_EQ(topology->get_devices_count(), 64 + 48);
+
+    /// test: routes go up to the lowest common tier, then down
+    EXPECT_EQ(route_ids(topology->route(0, 1)), (std::vector<DeviceId>{0, 64, 1}));
+    const auto pod_route = route_ids(topology->route(0, 4));
+    ASSERT_EQ(pod_route.size(), 5);
+    EXPECT_EQ(pod_route[1], 64);
+    EXPECT_TRUE(80 <= pod_route[2] && pod_route[2] < 84);
+    EXPECT_EQ(pod_route[3], 65);
+
+    /// test: equal-cost routes are spread over the core switches by chunk_id
+    auto cores = std::set<DeviceId>();
+    for (auto chunk_id = 0; chunk_id < 64; chunk_id++) {
+        const auto route = route_ids(topology->route_chunk(0, 63, chunk_id));
+        ASSERT_EQ(route.size(), 7);
+        EXPECT_EQ(route, route_ids(topology->route_chunk(0, 63, chunk_id)));
+        EXPECT_EQ(route[5], 79);
+        EXPECT_TRUE(96 <= route[3] && route[3] < 112);
+        cores.insert(route[3]);
+    }
+    EXPECT_GT(cores.size(), 8);
+
+    // an oversubscribed leaf has fewer uplinks than NPUs
+    const auto oversubscribed = FatTree(8, 2, 3, 50, 500);
+    EXPECT_EQ(oversubscribed.get_npus_count(), 6 * 4);
+    EXPECT_EQ(oversubscribed.get_connection_policies().size(), 2 * ((6 * 4) + (2 * 4)));
+
+    // 64k NPUs with contiguous switch IDs
+    EXPECT_EQ(FatTree::compute_npus_count(32, 4, 1), 65'536);
+    const auto large = FatTree(32, 4, 1, 50, 500);
+    EXPECT_EQ(large.get_devices_count(), 65'536 + FatTree::compute_switches_count(32, 4, 1));
+    EXPECT_EQ(large.route(0, 65'535).size(), 9);
+
+    /// test: the same timing as a ring route of as many hops
+    EXPECT_EQ(time_route(*topology, topology->route(0, 63)), time_ring_route(6));
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, Dragonfly) {
+    /// setup: 9 groups of 4 routers with 2 NPUs each (routers 72-107), minimal routing
+    const auto network_parser = NetworkParser("../../input/Dragonfly.yml");
+    const auto topology = construct_topology(network_parser);
+    EXPECT_EQ(topology->get_devices_count(), 72 + 36);
+
+    /// test: minimal routes take at most one global link
+    EXPECT_EQ(route_ids(topology->route(0, 1)), (std::vector<DeviceId>{0, 72, 1}));
+    EXPECT_EQ(route_ids(topology->route(0, 2)), (std::vector<DeviceId>{0, 72, 73, 2}));
+    EXPECT_EQ(route_ids(topology->route(0, 8)), (std::vector<DeviceId>{0, 72, 76, 8}));
+    EXPECT_EQ(route_ids(topology->route(0, 15)), (std::vector<DeviceId>{0, 72, 76, 79, 15}));
+
+    /// test: every arrangement links every two groups by the same number of global links, both ways
+    for (const auto arrangement :
+         {DragonflyArrangement::Absolute, DragonflyArrangement::Relative, DragonflyArrangement::Circulant}) {
+        for (const auto& [groups, global_links_per_router] :
+             {std::pair{9, 2}, std::pair{5, 2}, std::pair{7, 3}, std::pair{4, 3}}) {
+            const auto dragonfly =
+                Dragonfly(groups, 4, global_links_per_router, 1, arrangement, DragonflyRouting::Minimal, 50, 500);
+            const auto npus_count = dragonfly.get_npus_count();
+            auto links = std::set<std::pair<DeviceId, DeviceId>>();
+            auto global_links_per_pair = std::map<std::pair<int, int>, int>();
+            for (const auto& policy : dragonfly.get_connection_policies()) {
+                EXPECT_TRUE(links.insert({policy.src, policy.dst}).second);
+                const auto src_group = (policy.src - npus_count) / 4;
+                const auto dest_group = (policy.dst - npus_count) / 4;
+                if (policy.src >= npus_count && policy.dst >= npus_count && src_group != dest_group) {
+                    global_links_per_pair[{src_group, dest_group}]++;
+                }
+            }
+            for (const auto& [src, dest] : links) {
+                EXPECT_EQ(links.count({dest, src}), 1);
+            }
+            EXPECT_EQ(global_links_per_pair.size(), groups * (groups - 1));
+            for (const auto& [pair, count] : global_links_per_pair) {
+                EXPECT_EQ(count, (4 * global_links_per_router) / (groups - 1));
+            }
+        }
+    }
+
+    /// test: Valiant routes detour through an intermediate group
+    auto valiant = Dragonfly(9, 4, 2, 2, DragonflyArrangement::Absolute, DragonflyRouting::Valiant, 50, 500);
+    auto intermediate_groups = std::set<int>();
+    for (auto chunk_id = 0; chunk_id < 64; chunk_id++) {
+        DeviceId route[DragonflyLayout::max_route_length];
+        const auto length = valiant.route_device_ids(0, 15, chunk_id, route);
+        ASSERT_GE(length, 5);
+        EXPECT_EQ(route[0], 0);
+        EXPECT_EQ(route[length - 1], 15);
+        for (auto i = 1; i < length - 1; i++) {
+            const auto group = (route[i] - 72) / 4;
+            if (group != 0 && group != 1) {
+                intermediate_groups.insert(group);
+            }
+        }
+    }
+    EXPECT_GT(intermediate_groups.size(), 3);
+
+    /// test: UGAL takes the minimal route unless its first global link is queued up
+    auto ugal = Dragonfly(9, 4, 2, 2, DragonflyArrangement::Absolute, DragonflyRouting::UGAL, 50, 500);
+    EXPECT_EQ(route_ids(ugal.route(0, 8)), (std::vector<DeviceId>{0, 72, 76, 8}));
+    for (auto i = 0; i < 4; i++) {
+        const auto congested_route = Route{ugal.get_device(72), ugal.get_device(76), ugal.get_device(8)};
+        ugal.send(std::make_unique<Chunk>(chunk_size, congested_route, callback, nullptr));
+    }
+    EXPECT_GT(ugal.route(0, 8).size(), 4);
+    while (!event_queue->finished()) {
+        event_queue->proceed();
+    }
+    EXPECT_EQ(route_ids(ugal.route(0, 8)), (std::vector<DeviceId>{0, 72, 76, 8}));
+
+    /// test: the same timing as a ring route of as many hops
+    EXPECT_EQ(time_route(*topology, topology->route(0, 8)), time_ring_route(3));
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, DoubleBinaryTree) {
+    /// test: every tree node is owned once, so sizes with and without a full last level destroy cleanly
+    for (const auto npus_count : {1, 2, 5, 8, 13, 16}) {
+        const auto topology = std::make_shared<DoubleBinaryTree>(npus_count, 50, 500);
+
+        /// test: routes follow the tree links
+        for (auto src = 0; src < npus_count; src++) {
+            for (auto dest = 0; dest < npus_count; dest++) {
+                if (src == dest) {
+                    continue;
+                }
+                const auto route = route_ids(topology->route(src, dest));
+                ASSERT_GE(route.size(), 2);
+                EXPECT_EQ(route.front(), src);
+                EXPECT_EQ(route.back(), dest);
+                for (size_t i = 1; i < route.size(); i++) {
+                    EXPECT_EQ(topology->get_device(route[i - 1])->get_links().count(route[i]), 1);
+                }
+            }
+        }
+    }
+}
+
 TEST_F(TestNetworkAnalyticalCongestionAware, FullyConnected) {
     /// setup
     const auto network_parser = NetworkParser("../../input/FullyConnected.yml");
@@ -113,7 +426,7 @@ TEST_F(TestNetworkAnalyticalCongestionAware, AllGatherOnRing) {
                 continue;
             }
 
-            // crate a chunk
+            // create a chunk
             auto route = topology->route(i, j);
             auto* event_queue_ptr = static_cast<void*>(event_queue.get());
             auto chunk = std::make_unique<Chunk>(chunk_size, route, callback, nullptr);
@@ -132,3 +445,902 @@ TEST_F(TestNetworkAnalyticalCongestionAware, AllGatherOnRing) {
     const auto simulation_time = event_queue->get_current_time();
     EXPECT_EQ(simulation_time, 704'116);
 }
+
+TEST_F(TestNetworkAnalyticalCongestionAware, SwitchTranslationUnitDeepHierarchy) {
+    /// setup: 5D hierarchy, dims 0, 2, 3 are switches
+    const auto npus_count_per_dim = std::vector<int>{2, 3, 4, 2, 3};
+    const auto is_switch_dim = std::vector<bool>{true, false, true, true, false};
+    const auto switch_translation_unit = SwitchTranslationUnit(npus_count_per_dim, is_switch_dim);
+    const auto npus_count = 2 * 3 * 4 * 2 * 3;
+    const auto switches_count = (3 * 4 * 2 * 3) + (2 * 3) + 3;
+
+    /// translate every switch address
+    auto switch_ids = std::set<DeviceId>();
+    for (int switch_dim = 0; switch_dim < 5; switch_dim++) {
+        if (!is_switch_dim[switch_dim]) {
+            continue;
+        }
+        for (int upper = 0; upper < 3 * 4 * 2 * 3; upper++) {
+            auto address = MultiDimAddress(5, 0);
+            address[switch_dim] = npus_count_per_dim[switch_dim];
+            auto leftover = upper;
+            for (int dim = switch_dim + 1; dim < 5; dim++) {
+                address[dim] = leftover % npus_count_per_dim[dim];
+                leftover /= npus_count_per_dim[dim];
+            }
+            if (leftover == 0) {
+                switch_ids.insert(switch_translation_unit.translate_address_to_id(address));
+            }
+        }
+    }
+
+    /// test: switch IDs are unique and contiguous right after the NPUs
+    EXPECT_EQ(switch_ids.size(), switches_count);
+    EXPECT_EQ(*switch_ids.begin(), npus_count);
+    EXPECT_EQ(*switch_ids.rbegin(), npus_count + switches_count - 1);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, AllToAllOnRingFullyConnectedSwitch) {
+    /// setup
+    const auto network_parser = NetworkParser("../../input/Ring_FullyConnected_Switch.yml");
+    const auto topology = construct_topology(network_parser);
+
+    /// Run All-to-All
+    const auto simulation_time = run_all_to_all(*topology);
+
+    /// test
+    EXPECT_EQ(simulation_time, 1'669'550);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, HybridModeOnRingFullyConnectedSwitch) {
+    /// records the arrival time of each chunk
+    struct Arrival {
+        const EventQueue* event_queue;
+        EventTime time;
+    };
+    static const auto record_arrival = [](void* const arg) {
+        auto* const arrival = static_cast<Arrival*>(arg);
+        arrival->time = arrival->event_queue->get_current_time();
+    };
+
+    /// run All-to-All, optionally in hybrid mode, with `rounds` of traffic spaced apart
+    const auto run = [&](const bool hybrid_mode, const int rounds, const EventTime round_gap,
+                         std::vector<Arrival>& arrivals) {
+        event_queue = std::make_shared<EventQueue>();
+        Topology::set_event_queue(event_queue);
+
+        const auto network_parser = NetworkParser("../../input/Ring_FullyConnected_Switch.yml");
+        const auto topology = construct_topology(network_parser);
+        topology->set_hybrid_mode(hybrid_mode);
+        const auto npus_count = topology->get_npus_count();
+
+        arrivals.assign(rounds * npus_count * (npus_count - 1), {event_queue.get(), 0});
+        auto arrival_index = 0;
+        for (int round = 0; round < rounds; round++) {
+            while (!event_queue->finished() && event_queue->get_current_time() < round * round_gap) {
+                event_queue->proceed();
+            }
+            for (int i = 0; i < npus_count; i++) {
+                for (int j = 0; j < npus_count; j++) {
+                    if (i == j) {
+                        continue;
+                    }
+                    auto route = topology->route(i, j);
+                    auto* const arrival = &arrivals.at(arrival_index++);
+                    topology->send(std::make_unique<Chunk>(chunk_size, route, +record_arrival, arrival));
+                }
+            }
+        }
+
+        while (!event_queue->finished()) {
+            event_queue->proceed();
+        }
+    };
+
+    /// identical chunks arriving at a link at the same time may swap places,
+    /// so contended runs are compared by their sorted arrival times
+    const auto sorted_times = [](const std::vector<Arrival>& arrivals) {
+        auto times = std::vector<EventTime>();
+        for (const auto& arrival : arrivals) {
+            times.push_back(arrival.time);
+        }
+        std::sort(times.begin(), times.end());
+        return times;
+    };
+
+    /// test: contended traffic gives identical arrival times
+    auto reference = std::vector<Arrival>();
+    auto hybrid = std::vector<Arrival>();
+    run(false, 1, 0, reference);
+    run(true, 1, 0, hybrid);
+    EXPECT_EQ(event_queue->get_current_time(), 1'669'550);
+    ASSERT_EQ(reference.size(), hybrid.size());
+    EXPECT_EQ(sorted_times(reference), sorted_times(hybrid));
+
+    /// test: a single chunk in flight at a time takes the fast path, with fewer events
+    const auto light_load = [&](const bool hybrid_mode, std::vector<Arrival>& arrivals) {
+        event_queue = std::make_shared<EventQueue>();
+        Topology::set_event_queue(event_queue);
+
+        const auto network_parser = NetworkParser("../../input/Ring_FullyConnected_Switch.yml");
+        const auto topology = construct_topology(network_parser);
+        topology->set_hybrid_mode(hybrid_mode);
+        const auto npus_count = topology->get_npus_count();
+
+        // each NPU sends to its farthest peer, one after another
+        arrivals.assign(npus_count, {event_queue.get(), 0});
+        for (int i = 0; i < npus_count; i++) {
+            while (!event_queue->finished()) {
+                event_queue->proceed();
+            }
+            auto route = topology->route(i, npus_count - 1 - i);
+            topology->send(std::make_unique<Chunk>(chunk_size, route, +record_arrival, &arrivals.at(i)));
+        }
+        while (!event_queue->finished()) {
+            event_queue->proceed();
+        }
+        return event_queue->get_invoked_events_count();
+    };
+    const auto reference_events_count = light_load(false, reference);
+    const auto hybrid_events_count = light_load(true, hybrid);
+    for (size_t i = 0; i < reference.size(); i++) {
+        EXPECT_EQ(reference[i].time, hybrid[i].time);
+    }
+    EXPECT_LT(hybrid_events_count * 2, reference_events_count);
+
+    /// test: staggered rounds mix both paths, with identical arrival times
+    run(false, 4, 20'000, reference);
+    run(true, 4, 20'000, hybrid);
+    EXPECT_EQ(sorted_times(reference), sorted_times(hybrid));
+
+    /// test: a chunk queued at a link before a reserved chunk arrives there goes first
+    struct Message {
+        Topology* topology;
+        DeviceId src;
+        DeviceId dest;
+        ChunkSize size;
+        Arrival* arrival;
+    };
+    static const auto send_message = [](void* const arg) {
+        auto* const message = static_cast<Message*>(arg);
+        auto route = message->topology->route(message->src, message->dest);
+        message->topology->send(
+            std::make_unique<Chunk>(message->size, route, +record_arrival, message->arrival));
+    };
+    const auto queued_first = [&](const bool hybrid_mode, std::vector<Arrival>& arrivals) {
+        event_queue = std::make_shared<EventQueue>();
+        Topology::set_event_queue(event_queue);
+
+        // unidirectional Ring(4) of 1 B/ns links
+        const auto topology = std::make_shared<Ring>(4, 1e9 / (1 << 30), 100, /*bidirectional=*/false);
+        topology->set_hybrid_mode(hybrid_mode);
+
+        // 0 -> 2 reaches link 1 -> 2 at 1'100, behind 1 -> 2 chunks queued there since 200
+        arrivals.assign(3, {event_queue.get(), 0});
+        auto messages = std::vector<Message>{{topology.get(), 0, 2, 1'000, &arrivals[0]},
+                                             {topology.get(), 1, 2, 1'000, &arrivals[1]},
+                                             {topology.get(), 1, 2, 2'000, &arrivals[2]}};
+        send_message(&messages[0]);
+        event_queue->schedule_event(100, +send_message, &messages[1]);
+        event_queue->schedule_event(200, +send_message, &messages[2]);
+        while (!event_queue->finished()) {
+            event_queue->proceed();
+        }
+    };
+    queued_first(false, reference);
+    queued_first(true, hybrid);
+    EXPECT_EQ(reference[0].time, 4'200);
+    EXPECT_EQ(reference[1].time, 1'200);
+    EXPECT_EQ(reference[2].time, 3'200);
+    for (size_t i = 0; i < reference.size(); i++) {
+        EXPECT_EQ(reference[i].time, hybrid[i].time);
+    }
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, TrafficGeneratorOnRingFullyConnectedSwitch) {
+    /// setup
+    const auto network_parser = NetworkParser("../../input/Ring_FullyConnected_Switch.yml");
+    const auto topology = construct_topology(network_parser);
+    const auto npus_count = topology->get_npus_count();
+
+    const auto run = [&](const TrafficConfig& config) {
+        reset_simulation(*topology);
+
+        auto traffic_generator = TrafficGenerator(topology, event_queue, config);
+        traffic_generator.start();
+        while (!event_queue->finished()) {
+            event_queue->proceed();
+        }
+        EXPECT_TRUE(traffic_generator.finished());
+        return traffic_generator.get_stats();
+    };
+
+    /// test: All-to-All with every message in flight matches the hand-rolled loop
+    auto config = TrafficConfig();
+    config.pattern = TrafficPattern::AllToAll;
+    config.message_size = chunk_size;
+    config.messages_per_npu = 0;
+    config.window = npus_count - 1;
+    auto stats = run(config);
+    EXPECT_EQ(stats.messages_count, npus_count * (npus_count - 1));
+    EXPECT_EQ(stats.bytes, stats.messages_count * chunk_size);
+    EXPECT_EQ(stats.finish_time, 1'669'550);
+
+    /// test: lazy injection keeps at most `window` messages in flight per NPU
+    config.window = 2;
+    stats = run(config);
+    EXPECT_EQ(stats.messages_count, npus_count * (npus_count - 1));
+    EXPECT_EQ(stats.max_in_flight, npus_count * 2);
+    EXPECT_GT(stats.finish_time, 1'669'550);
+
+    /// test: injection interval spreads the injections
+    config.pattern = TrafficPattern::RingNeighbour;
+    config.messages_per_npu = 4;
+    config.window = 4;
+    config.injection_interval = 1'000'000;
+    stats = run(config);
+    EXPECT_EQ(stats.messages_count, npus_count * 4);
+    EXPECT_GE(stats.finish_time, 3 * config.injection_interval);
+    EXPECT_EQ(stats.max_in_flight, npus_count);
+
+    /// test: every pattern delivers its messages
+    config.injection_interval = 0;
+    for (const auto pattern : {"UniformRandom", "Permutation", "Transpose", "Hotspot", "BitComplement"}) {
+        config.pattern = TrafficGenerator::parse_traffic_pattern(pattern);
+        stats = run(config);
+
+        // Transpose: the 8 NPUs on the diagonal of the 8x8 grid stay silent
+        const auto senders_count = (config.pattern == TrafficPattern::Transpose) ? npus_count - 8 : npus_count;
+        EXPECT_EQ(stats.messages_count, senders_count * 4) << pattern;
+        EXPECT_GT(stats.mean_latency(), 0.0) << pattern;
+        EXPECT_GT(stats.throughput(), 0.0) << pattern;
+    }
+
+    /// test: random patterns are reproducible for a given seed
+    config.pattern = TrafficPattern::UniformRandom;
+    config.seed = 42;
+    const auto first_stats = run(config);
+    const auto second_stats = run(config);
+    EXPECT_EQ(first_stats.finish_time, second_stats.finish_time);
+    EXPECT_EQ(first_stats.total_latency, second_stats.total_latency);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, TraceReplayOnRingFullyConnectedSwitch) {
+    /// setup
+    const auto network_parser = NetworkParser("../../input/Ring_FullyConnected_Switch.yml");
+    const auto topology = construct_topology(network_parser);
+    const auto npus_count = topology->get_npus_count();
+
+    const auto replay = [&](const std::string& trace_path, const int window, const std::string& output_path = "") {
+        reset_simulation(*topology);
+
+        auto trace_replayer = TraceReplayer(topology, event_queue, TraceReader::open(trace_path), window, output_path);
+        trace_replayer.start();
+        while (!event_queue->finished()) {
+            event_queue->proceed();
+        }
+        EXPECT_TRUE(trace_replayer.finished());
+        return trace_replayer.get_stats();
+    };
+
+    /// All-to-All trace, as CSV and binary
+    auto records = std::vector<TraceRecord>();
+    const auto csv_path = std::string("trace.csv");
+    auto csv_file = std::ofstream(csv_path);
+    csv_file << "issue_time,depends_on,src,dest,bytes\n";
+    for (int i = 0; i < npus_count; i++) {
+        for (int j = 0; j < npus_count; j++) {
+            if (i != j) {
+                records.push_back({0, -1, i, j, chunk_size});
+                csv_file << "0,-1," << i << "," << j << "," << chunk_size << "\n";
+            }
+        }
+    }
+    csv_file.close();
+    const auto binary_path = std::string("trace.bin");
+    BinaryTraceReader::write_binary_trace(binary_path, records);
+
+    /// test: with every message in the window, replay matches the hand-rolled loop
+    for (const auto& trace_path : {csv_path, binary_path}) {
+        const auto stats = replay(trace_path, static_cast<int>(records.size()));
+        EXPECT_EQ(stats.messages_count, records.size());
+        EXPECT_EQ(stats.bytes, records.size() * chunk_size);
+        EXPECT_EQ(stats.finish_time, 1'669'550);
+        EXPECT_EQ(stats.late_messages_count, 0);
+    }
+
+    /// test: a small window streams the trace, holding messages back
+    const auto streamed_stats = replay(binary_path, 64);
+    EXPECT_EQ(streamed_stats.messages_count, records.size());
+    EXPECT_GT(streamed_stats.late_messages_count, 0);
+    EXPECT_GT(streamed_stats.finish_time, 1'669'550);
+    std::remove(csv_path.c_str());
+    std::remove(binary_path.c_str());
+
+    /// test: a dependency chain bouncing between NPUs 0 and 1, 100 ns apart, completes hop after hop
+    records.clear();
+    for (int i = 0; i < 8; i++) {
+        records.push_back({(i == 0) ? EventTime{0} : EventTime{100}, i - 1, i % 2, 1 - (i % 2), chunk_size});
+    }
+    BinaryTraceReader::write_binary_trace(binary_path, records);
+    const auto output_path = std::string("completions.csv");
+    const auto chain_stats = replay(binary_path, 4, output_path);
+    EXPECT_EQ(chain_stats.messages_count, 8);
+
+    auto output_file = std::ifstream(output_path);
+    auto line = std::string();
+    std::getline(output_file, line);
+    EXPECT_EQ(line, "id,src,dest,bytes,issue_time,completion_time");
+    auto previous_completion_time = EventTime{0};
+    auto hop_time = EventTime{0};
+    for (int i = 0; i < 8; i++) {
+        ASSERT_TRUE(std::getline(output_file, line));
+        auto row = std::istringstream(line);
+        auto fields = std::vector<uint64_t>();
+        auto field = std::string();
+        while (std::getline(row, field, ',')) {
+            fields.push_back(std::stoull(field));
+        }
+        ASSERT_EQ(fields.size(), 6);
+        EXPECT_EQ(fields[0], i);
+        if (i == 0) {
+            hop_time = fields[5];
+        } else {
+            EXPECT_EQ(fields[4], previous_completion_time + 100);
+            EXPECT_EQ(fields[5], fields[4] + hop_time);
+        }
+        previous_completion_time = fields[5];
+    }
+    std::remove(output_path.c_str());
+    std::remove(binary_path.c_str());
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, DagExecutorOnRing) {
+    /// setup
+    const auto network_parser = NetworkParser("../../input/Ring.yml");
+    const auto topology = construct_topology(network_parser);
+    const auto npus_count = topology->get_npus_count();
+
+    const auto run = [&](std::vector<DagNode> nodes, const std::vector<std::pair<int, int>>& edges) {
+        return run_dag(topology, std::move(nodes), edges);
+    };
+
+    /// a single send gives the time of one uncontended hop
+    const auto hop_time = run({{0, 1, chunk_size}}, {})->get_completion_time(0);
+    EXPECT_GT(hop_time, 0);
+
+    /// test: ring All-Gather, step s + 1 of NPU i waits for step s of NPU (i - 1)
+    const auto steps_count = npus_count - 1;
+    const auto node_of = [&](const int step, const int npu) { return (step * npus_count) + npu; };
+    auto nodes = std::vector<DagNode>();
+    auto edges = std::vector<std::pair<int, int>>();
+    for (int step = 0; step < steps_count; step++) {
+        for (int npu = 0; npu < npus_count; npu++) {
+            nodes.push_back({npu, (npu + 1) % npus_count, chunk_size});
+            if (step > 0) {
+                edges.emplace_back(node_of(step - 1, (npu + npus_count - 1) % npus_count), node_of(step, npu));
+            }
+        }
+    }
+    auto dag_executor = run(nodes, edges);
+    EXPECT_EQ(dag_executor->get_completed_count(), steps_count * npus_count);
+    for (int step = 0; step < steps_count; step++) {
+        EXPECT_EQ(dag_executor->get_completion_time(node_of(step, 0)), (step + 1) * hop_time);
+    }
+
+    /// test: a local node joins two sends and delays the next one
+    nodes = {{0, 1, chunk_size}, {2, 1, chunk_size}, {1, 1, 0, 1'000}, {1, 2, chunk_size}};
+    edges = {{0, 2}, {1, 2}, {2, 3}};
+    dag_executor = run(nodes, edges);
+    EXPECT_EQ(dag_executor->get_completion_time(2), hop_time + 1'000);
+    EXPECT_EQ(dag_executor->get_completion_time(3), (2 * hop_time) + 1'000);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, CollectiveGeneratorOnFullyConnected) {
+    /// setup: every NPU pair has its own link, so the collectives run uncontended
+    const auto network_parser = NetworkParser("../../input/FullyConnected.yml");
+    const auto topology = construct_topology(network_parser);
+    const auto npus_count = topology->get_npus_count();
+
+    const auto run = [&](const CollectiveSchedule& schedule) { return run_schedule(topology, schedule); };
+    const auto send = [&](const DeviceId dest, const ChunkSize size) { return time_send(topology, dest, size); };
+
+    /// test: the closed forms of the congestion-unaware CollectiveModel, with congestion-aware sends
+    const auto generator = CollectiveGenerator(topology);
+    const auto shard_size = chunk_size / npus_count;
+    const auto ring_step = send(1, shard_size);
+    EXPECT_EQ(run(generator.generate(CollectiveOperation::AllReduce, CollectiveAlgorithm::Ring, chunk_size)),
+              2 * (npus_count - 1) * ring_step);
+    EXPECT_EQ(run(generator.generate(CollectiveOperation::AllGather, CollectiveAlgorithm::Ring, chunk_size)),
+              (npus_count - 1) * ring_step);
+    EXPECT_NEAR(run(generator.generate(CollectiveOperation::AllToAll, CollectiveAlgorithm::Ring, chunk_size)),
+                (npus_count - 1) * send(1, chunk_size / 2), npus_count);
+
+    EXPECT_EQ(run(generator.generate(CollectiveOperation::ReduceScatter, CollectiveAlgorithm::Direct, chunk_size)),
+              ring_step);
+    EXPECT_EQ(run(generator.generate(CollectiveOperation::AllReduce, CollectiveAlgorithm::Direct, chunk_size)),
+              2 * ring_step);
+
+    // halving-doubling: halving sizes, then back
+    auto halving_doubling = EventTime{0};
+    for (auto step = 0; step < 4; step++) {
+        halving_doubling += send(8 >> step, chunk_size >> (step + 1));
+        halving_doubling += send(1 << step, chunk_size >> (4 - step));
+    }
+    EXPECT_EQ(
+        run(generator.generate(CollectiveOperation::AllReduce, CollectiveAlgorithm::HalvingDoubling, chunk_size)),
+        halving_doubling);
+
+    // double binary tree: both trees carry half of the buffer over 4 levels, up and down
+    const auto tree_step = send(1, chunk_size / 2);
+    EXPECT_EQ(
+        run(generator.generate(CollectiveOperation::AllReduce, CollectiveAlgorithm::DoubleBinaryTree, chunk_size)),
+        2 * 4 * tree_step);
+
+    /// test: pipelining
+    // one chunk in flight: chunks run back to back
+    const auto chunks_count = 8;
+    const auto serial_generator = CollectiveGenerator(topology, chunks_count, 1);
+    const auto pipelined_generator = CollectiveGenerator(topology, chunks_count, chunks_count);
+    EXPECT_EQ(run(serial_generator.generate(CollectiveOperation::AllGather, CollectiveAlgorithm::Ring, chunk_size)),
+              chunks_count * (npus_count - 1) * send(1, shard_size / chunks_count));
+
+    // pipelined double binary tree beats the closed form, which does not overlap the reduction and the broadcast
+    const auto large_size = 64 * chunk_size;
+    const auto pipeline_step = send(1, large_size / 2 / chunks_count);
+    const auto pipelined_tree_pass = (4 + chunks_count - 1) * pipeline_step;
+    const auto tree = CollectiveAlgorithm::DoubleBinaryTree;
+    const auto pipelined_tree = run(pipelined_generator.generate(CollectiveOperation::AllReduce, tree, large_size));
+    EXPECT_LE(pipelined_tree, 2 * pipelined_tree_pass);
+    EXPECT_LT(pipelined_tree, run(generator.generate(CollectiveOperation::AllReduce, tree, large_size)));
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, CollectiveGeneratorHierarchical) {
+    /// setup
+    const auto network_parser = NetworkParser("../../input/Ring_FullyConnected_Switch.yml");
+    const auto topology = construct_topology(network_parser);
+
+    const auto run = [&](const CollectiveSchedule& schedule) { return run_schedule(topology, schedule); };
+    const auto send = [&](const DeviceId dest, const ChunkSize size) { return time_send(topology, dest, size); };
+
+    /// test: [2, 8, 4], ring reduce-scatter per dimension on a shrinking buffer, then all-gather back
+    const auto generator = CollectiveGenerator(topology);
+    const auto dim1 = send(1, chunk_size / 2);
+    const auto dim2 = send(2, chunk_size / 16);
+    const auto dim3 = send(16, chunk_size / 64);
+    const auto reduce_scatter = (1 * dim1) + (7 * dim2) + (3 * dim3);
+    EXPECT_EQ(
+        run(generator.generate(CollectiveOperation::ReduceScatter, CollectiveAlgorithm::Hierarchical, chunk_size)),
+        reduce_scatter);
+    EXPECT_EQ(run(generator.generate(CollectiveOperation::AllReduce, CollectiveAlgorithm::Hierarchical, chunk_size)),
+              2 * reduce_scatter);
+
+    /// test: per-dimension algorithms
+    const auto algorithm_per_dim = std::vector<CollectiveAlgorithm>{
+        CollectiveAlgorithm::Ring, CollectiveAlgorithm::HalvingDoubling, CollectiveAlgorithm::Ring};
+    const auto halving_doubling = send(8, chunk_size / 4) + send(4, chunk_size / 8) + send(2, chunk_size / 16);
+    EXPECT_EQ(run(generator.generate_hierarchical(CollectiveOperation::ReduceScatter, algorithm_per_dim, chunk_size)),
+              (1 * dim1) + halving_doubling + (3 * dim3));
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, SymmetricSimulation) {
+    /// setup
+    const auto run_full = [&](const std::shared_ptr<Topology>& topology, const CollectiveSchedule& schedule) {
+        return run_schedule(topology, schedule);
+    };
+    const auto run_symmetric = [&](const std::shared_ptr<Topology>& topology, const CollectiveSchedule& schedule,
+                                   const bool reduced) {
+        reset_simulation(*topology);
+
+        auto simulation = SymmetricSimulation(topology, event_queue, schedule);
+        EXPECT_EQ(simulation.is_reduced(), reduced);
+        simulation.start();
+        while (!event_queue->finished()) {
+            event_queue->proceed();
+        }
+        EXPECT_TRUE(simulation.finished());
+
+        // extrapolated completion times end with the simulation
+        auto last_completion_time = EventTime{0};
+        for (auto node = 0; node < static_cast<int>(schedule.nodes.size()); node++) {
+            last_completion_time = std::max(last_completion_time, simulation.get_completion_time(node));
+        }
+        EXPECT_EQ(last_completion_time, event_queue->get_current_time());
+        return std::make_pair(event_queue->get_current_time(), simulation.get_simulated_nodes_count());
+    };
+
+    /// test: ring all-gather on a ring simulates the 15 sends of NPU 0 only
+    const auto ring = construct_topology(NetworkParser("../../input/Ring.yml"));
+    const auto ring_generator = CollectiveGenerator(ring);
+    const auto all_gather =
+        ring_generator.generate(CollectiveOperation::AllGather, CollectiveAlgorithm::Ring, chunk_size);
+    const auto [all_gather_time, all_gather_nodes_count] = run_symmetric(ring, all_gather, true);
+    EXPECT_EQ(all_gather.nodes.size(), 16 * 15);
+    EXPECT_EQ(all_gather_nodes_count, 15);
+    EXPECT_EQ(all_gather_time, run_full(ring, all_gather));
+
+    // direct all-to-all contends on the ring links: the quotient network keeps the contention
+    const auto all_to_all =
+        ring_generator.generate(CollectiveOperation::AllToAll, CollectiveAlgorithm::Direct, chunk_size);
+    EXPECT_EQ(run_symmetric(ring, all_to_all, true).first, run_full(ring, all_to_all));
+
+    /// test: hierarchical all-reduce on [2, 8, 4], through the switches of the last dimension
+    const auto multi_dim = construct_topology(NetworkParser("../../input/Ring_FullyConnected_Switch.yml"));
+    const auto all_reduce = CollectiveGenerator(multi_dim).generate(
+        CollectiveOperation::AllReduce, CollectiveAlgorithm::Hierarchical, chunk_size);
+    const auto [all_reduce_time, all_reduce_nodes_count] = run_symmetric(multi_dim, all_reduce, true);
+    EXPECT_EQ(all_reduce_nodes_count * multi_dim->get_npus_count(), all_reduce.nodes.size());
+    EXPECT_EQ(all_reduce_time, run_full(multi_dim, all_reduce));
+
+    /// test: a faulty link breaks the symmetry of the topology
+    const auto faulty_links = std::vector<std::tuple<int, int, double>>{{0, 1, 0.5}};
+    const auto faulty_ring = std::make_shared<Ring>(16, 50, 500, faulty_links);
+    const auto faulty_all_gather = CollectiveGenerator(faulty_ring).generate(
+        CollectiveOperation::AllGather, CollectiveAlgorithm::Ring, chunk_size);
+    const auto [faulty_time, faulty_nodes_count] = run_symmetric(faulty_ring, faulty_all_gather, false);
+    EXPECT_EQ(faulty_nodes_count, faulty_all_gather.nodes.size());
+    EXPECT_EQ(faulty_time, run_full(faulty_ring, faulty_all_gather));
+    EXPECT_GT(faulty_time, all_gather_time);
+
+    /// test: trees break the symmetry of the schedule
+    const auto tree = ring_generator.generate(
+        CollectiveOperation::AllReduce, CollectiveAlgorithm::DoubleBinaryTree, chunk_size);
+    EXPECT_EQ(run_symmetric(ring, tree, false).first, run_full(ring, tree));
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, AllToAllOnRingFullyConnectedSwitchParallelConstruction) {
+    /// setup: build the links with 4 threads
+    const auto network_parser = NetworkParser("../../input/Ring_FullyConnected_Switch.yml");
+    const auto topology = construct_topology(network_parser, /* threads_count = */ 4);
+
+    /// test: identical to the single-threaded construction
+    EXPECT_EQ(run_all_to_all(*topology), 1'669'550);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, AllToAllOnRingFullyConnectedSwitchLazyLinks) {
+    /// setup: links are instantiated as chunks cross them
+    const auto network_parser = NetworkParser("../../input/Ring_FullyConnected_Switch.yml");
+    const auto topology = construct_topology(network_parser, /* threads_count = */ 1, /* lazy_links = */ true);
+    const auto eager_topology = construct_topology(network_parser);
+    const auto npus_count = topology->get_npus_count();
+
+    const auto npu_links_count = [&](const std::shared_ptr<Topology>& topology) {
+        auto links_count = size_t{0};
+        for (auto npu = 0; npu < npus_count; npu++) {
+            links_count += topology->get_device(npu)->get_links().size();
+        }
+        return links_count;
+    };
+    EXPECT_EQ(npu_links_count(topology), 0);
+
+    /// test: a single chunk only instantiates the links of its route
+    auto route = topology->route(0, npus_count - 1);
+    const auto hops_count = route.size() - 1;
+    topology->send(std::make_unique<Chunk>(chunk_size, route, callback, nullptr));
+    while (!event_queue->finished()) {
+        event_queue->proceed();
+    }
+    EXPECT_LE(npu_links_count(topology), hops_count);
+
+    /// Run All-to-All
+    reset_simulation(*topology);
+
+    /// test: identical to the eager construction, which all-to-all fully covers
+    EXPECT_EQ(run_all_to_all(*topology), 1'669'550);
+    EXPECT_EQ(npu_links_count(topology), npu_links_count(eager_topology));
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, AllToAllOnRingFullyConnectedSwitchSnapshot) {
+    /// setup: save a snapshot, then restore the topology from it
+    const auto network_parser = NetworkParser("../../input/Ring_FullyConnected_Switch.yml");
+    const auto constructed_topology = construct_topology(network_parser);
+    const auto snapshot_path = std::string("Ring_FullyConnected_Switch.snapshot");
+    std::dynamic_pointer_cast<MultiDimTopology>(constructed_topology)->save_snapshot(snapshot_path);
+    const auto topology = construct_topology_from_snapshot(snapshot_path);
+    const auto npus_count = topology->get_npus_count();
+    EXPECT_EQ(topology->get_devices_count(), constructed_topology->get_devices_count());
+
+    /// test: identical to the constructed topology
+    EXPECT_EQ(run_all_to_all(*topology), 1'669'550);
+
+    /// test: a lazy topology is restored lazy, instantiating the links not crossed before saving
+    const auto lazy_topology = construct_topology(network_parser, /* threads_count = */ 1, /* lazy_links = */ true);
+    lazy_topology->send(std::make_unique<Chunk>(chunk_size, lazy_topology->route(0, 1), callback, nullptr));
+    while (!event_queue->finished()) {
+        event_queue->proceed();
+    }
+    std::dynamic_pointer_cast<MultiDimTopology>(lazy_topology)->save_snapshot(snapshot_path);
+    const auto restored_topology = construct_topology_from_snapshot(snapshot_path);
+
+    // time a chunk takes from the first to the last NPU, over links mostly not crossed before saving
+    EXPECT_EQ(time_route(*restored_topology, restored_topology->route(0, npus_count - 1)),
+              time_route(*topology, topology->route(0, npus_count - 1)));
+    std::remove(snapshot_path.c_str());
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, AllToAllOnRingFullyConnectedSwitchReset) {
+    /// setup
+    const auto network_parser = NetworkParser("../../input/Ring_FullyConnected_Switch.yml");
+    const auto topology = construct_topology(network_parser);
+
+    for (const auto hybrid_mode : {false, true}) {
+        topology->set_hybrid_mode(hybrid_mode);
+
+        /// abandon a run halfway, then reuse the topology for full runs
+        const auto chunks_in_flight = Chunk::get_chunks_in_flight();
+        run_all_to_all(*topology, 10);
+        EXPECT_FALSE(event_queue->finished());
+
+        for (int run = 0; run < 3; run++) {
+            reset_simulation(*topology);
+
+            /// test: pending chunks, chunks in transmission, and reserved chunks are freed
+            EXPECT_EQ(Chunk::get_chunks_in_flight(), chunks_in_flight);
+
+            /// test: identical to a freshly constructed topology
+            EXPECT_EQ(run_all_to_all(*topology), 1'669'550);
+            EXPECT_EQ(Chunk::get_chunks_in_flight(), chunks_in_flight);
+        }
+    }
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, LinkStatsOnRingFullyConnectedSwitch) {
+    /// setup
+    const auto network_parser = NetworkParser("../../input/Ring_FullyConnected_Switch.yml");
+    const auto topology = construct_topology(network_parser);
+    const auto npus_count = topology->get_npus_count();
+
+    /// Run All-to-All
+    auto total_hops = uint64_t{0};
+    for (int i = 0; i < npus_count; i++) {
+        for (int j = 0; j < npus_count; j++) {
+            if (i == j) {
+                continue;
+            }
+
+            auto route = topology->route(i, j);
+            total_hops += route.size() - 1;
+            auto chunk = std::make_unique<Chunk>(chunk_size, route, callback, nullptr);
+            topology->send(std::move(chunk));
+        }
+    }
+
+    /// Run simulation
+    while (!event_queue->finished()) {
+        event_queue->proceed();
+    }
+
+    /// dump and read back the CSV
+    const auto stats_path = std::string("link_stats.csv");
+    topology->dump_link_stats(stats_path);
+    auto file = std::ifstream(stats_path);
+    auto line = std::string();
+    std::getline(file, line);
+    EXPECT_EQ(line.rfind("src,dest,dim,", 0), 0);
+
+    auto total_bytes = uint64_t{0};
+    auto total_chunks = uint64_t{0};
+    auto dims = std::set<int>();
+    auto queued_links_count = 0;
+    while (std::getline(file, line)) {
+        auto row = std::istringstream(line);
+        auto fields = std::vector<std::string>();
+        auto field = std::string();
+        while (std::getline(row, field, ',')) {
+            fields.push_back(field);
+        }
+        ASSERT_EQ(fields.size(), 9);
+
+        dims.insert(std::stoi(fields[2]));
+        total_bytes += std::stoull(fields[4]);
+        total_chunks += std::stoull(fields[5]);
+        if (std::stoull(fields[6]) > 0) {
+            queued_links_count++;
+            EXPECT_GT(std::stoull(fields[8]), 0);
+        }
+    }
+    std::remove(stats_path.c_str());
+
+    /// test: every hop is accounted once, on links of all three dimensions
+    EXPECT_EQ(total_chunks, total_hops);
+    EXPECT_EQ(total_bytes, total_hops * chunk_size);
+    EXPECT_EQ(dims, (std::set<int>{0, 1, 2}));
+    EXPECT_GT(queued_links_count, 0);
+
+    /// test: reset clears the statistics
+    topology->reset();
+    topology->dump_link_stats(stats_path);
+    file = std::ifstream(stats_path);
+    std::getline(file, line);
+    while (std::getline(file, line)) {
+        EXPECT_NE(line.find(",0,0,0,0,0,0"), std::string::npos);
+    }
+    std::remove(stats_path.c_str());
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, ChunkTracerRingBuffer) {
+    /// record more transmissions than the buffer holds
+    auto chunk_tracer = ChunkTracer(4);
+    for (uint64_t i = 0; i < 6; i++) {
+        chunk_tracer.record({nullptr, i, chunk_size, i * 1'000, i * 1'000 + 500, 0});
+    }
+
+    /// test: only the newest records are kept
+    EXPECT_EQ(chunk_tracer.get_records_count(), 4);
+    EXPECT_EQ(chunk_tracer.get_dropped_count(), 2);
+
+    /// test: clearing drops all records
+    chunk_tracer.clear();
+    EXPECT_EQ(chunk_tracer.get_records_count(), 0);
+    EXPECT_EQ(chunk_tracer.get_dropped_count(), 0);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, ChunkTraceOnRingFullyConnectedSwitch) {
+    if (!chunk_trace_enabled) {
+        GTEST_SKIP() << "chunk tracing is compiled out (NETWORK_BACKEND_ENABLE_CHUNK_TRACE=OFF)";
+    }
+
+    /// setup
+    const auto network_parser = NetworkParser("../../input/Ring_FullyConnected_Switch.yml");
+    const auto topology = construct_topology(network_parser);
+    const auto npus_count = topology->get_npus_count();
+    const auto chunk_tracer = std::make_shared<ChunkTracer>(1 << 16);
+    Topology::set_chunk_tracer(chunk_tracer);
+
+    /// Run All-to-All
+    auto total_hops = uint64_t{0};
+    for (int i = 0; i < npus_count; i++) {
+        for (int j = 0; j < npus_count; j++) {
+            if (i == j) {
+                continue;
+            }
+
+            auto route = topology->route(i, j);
+            total_hops += route.size() - 1;
+            auto chunk = std::make_unique<Chunk>(chunk_size, route, callback, nullptr);
+            topology->send(std::move(chunk));
+        }
+    }
+
+    /// Run simulation
+    while (!event_queue->finished()) {
+        event_queue->proceed();
+    }
+
+    /// test: every hop is recorded once
+    EXPECT_EQ(chunk_tracer->get_records_count(), total_hops);
+    EXPECT_EQ(chunk_tracer->get_dropped_count(), 0);
+
+    /// test: the trace holds one complete event per hop
+    const auto trace_path = std::string("chunk_trace.json");
+    topology->dump_chunk_trace(trace_path);
+    auto file = std::ifstream(trace_path);
+    auto complete_events_count = uint64_t{0};
+    auto line = std::string();
+    while (std::getline(file, line)) {
+        if (line.find(R"("ph": "X")") != std::string::npos) {
+            complete_events_count++;
+        }
+    }
+    EXPECT_EQ(complete_events_count, total_hops);
+    std::remove(trace_path.c_str());
+    Topology::set_chunk_tracer(nullptr);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, InstrumentationOnRing) {
+    /// setup
+    const auto network_parser = NetworkParser("../../input/Ring.yml");
+    const auto topology = construct_topology(network_parser);
+    const auto npus_count = topology->get_npus_count();
+    Instrumentation::reset();
+
+    /// Run All-Gather
+    auto total_hops = uint64_t{0};
+    for (int i = 0; i < npus_count; i++) {
+        for (int j = 0; j < npus_count; j++) {
+            if (i == j) {
+                continue;
+            }
+
+            auto route = topology->route(i, j);
+            total_hops += route.size() - 1;
+            auto chunk = std::make_unique<Chunk>(chunk_size, route, callback, nullptr);
+            topology->send(std::move(chunk));
+        }
+    }
+
+    /// Run simulation
+    while (!event_queue->finished()) {
+        event_queue->proceed();
+    }
+
+    /// test: the null policy records nothing, the counting policy sees every hop
+    const auto counters = Instrumentation::get_counters();
+    if (std::is_same_v<Instrumentation, NullInstrumentation>) {
+        EXPECT_EQ(counters.hops_forwarded, 0);
+        EXPECT_EQ(counters.events_scheduled, 0);
+    } else {
+        EXPECT_EQ(counters.chunks_created, npus_count * (npus_count - 1));
+        EXPECT_EQ(counters.hops_forwarded, total_hops);
+        EXPECT_EQ(counters.queue_depth_samples, total_hops);
+        EXPECT_EQ(counters.events_scheduled, 2 * total_hops);
+        EXPECT_GT(counters.max_queue_depth, 0);
+    }
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, ProgressReporterOnRing) {
+    /// setup
+    const auto network_parser = NetworkParser("../../input/Ring.yml");
+    const auto topology = construct_topology(network_parser);
+    const auto npus_count = topology->get_npus_count();
+
+    /// sample every 100 events into a vector
+    auto samples = std::vector<ProgressSample>();
+    const auto progress_reporter = std::make_shared<ProgressReporter>(
+        100, 0.0, [&samples](const ProgressSample& sample) { samples.push_back(sample); });
+    progress_reporter->set_chunks_in_flight_counter(Chunk::get_chunks_in_flight);
+    event_queue->set_progress_reporter(progress_reporter);
+
+    /// Run All-Gather, counting chunks in flight from the ones alive before the run
+    const auto chunks_in_flight = Chunk::get_chunks_in_flight();
+    for (int i = 0; i < npus_count; i++) {
+        for (int j = 0; j < npus_count; j++) {
+            if (i == j) {
+                continue;
+            }
+
+            auto route = topology->route(i, j);
+            auto chunk = std::make_unique<Chunk>(chunk_size, route, callback, nullptr);
+            topology->send(std::move(chunk));
+        }
+    }
+    EXPECT_EQ(Chunk::get_chunks_in_flight() - chunks_in_flight, npus_count * (npus_count - 1));
+
+    /// Run simulation
+    while (!event_queue->finished()) {
+        event_queue->proceed();
+    }
+
+    /// test: samples are taken along the run
+    const auto events_count = event_queue->get_invoked_events_count();
+    EXPECT_EQ(event_queue->get_pending_events_count(), 0);
+    EXPECT_EQ(Chunk::get_chunks_in_flight(), chunks_in_flight);
+    ASSERT_FALSE(samples.empty());
+    EXPECT_GE(samples.size(), events_count / 100 / 2);
+    EXPECT_GT(samples.front().chunks_in_flight, chunks_in_flight);
+    for (size_t i = 1; i < samples.size(); i++) {
+        EXPECT_GE(samples[i].simulated_time, samples[i - 1].simulated_time);
+        EXPECT_GE(samples[i].events_count, samples[i - 1].events_count + 100);
+    }
+
+    /// test: the stop condition ends the run at the first sample meeting it
+    reset_simulation(*topology);
+    const auto stopping_reporter = std::make_shared<ProgressReporter>(100, 0.0, [](const ProgressSample&) {});
+    stopping_reporter->set_stop_condition(
+        [events_count](const ProgressSample& sample) { return sample.events_count >= events_count / 2; });
+    event_queue->set_progress_reporter(stopping_reporter);
+    for (int i = 0; i < npus_count; i++) {
+        for (int j = 0; j < npus_count; j++) {
+            if (i != j) {
+                auto chunk = std::make_unique<Chunk>(chunk_size, topology->route(i, j), callback, nullptr);
+                topology->send(std::move(chunk));
+            }
+        }
+    }
+    while (!event_queue->finished()) {
+        event_queue->proceed();
+    }
+    EXPECT_TRUE(stopping_reporter->stop_requested());
+    EXPECT_GT(event_queue->get_pending_events_count(), 0);
+    EXPECT_LT(event_queue->get_invoked_events_count(), events_count);
+
+    /// test: removing the reporter resumes the stopped run to the end
+    event_queue->set_progress_reporter(nullptr);
+    EXPECT_FALSE(event_queue->finished());
+    while (!event_queue->finished()) {
+        event_queue->proceed();
+    }
+    EXPECT_EQ(event_queue->get_pending_events_count(), 0);
+    EXPECT_EQ(event_queue->get_invoked_events_count(), events_count);
+    EXPECT_EQ(Chunk::get_chunks_in_flight(), chunks_in_flight);
+}
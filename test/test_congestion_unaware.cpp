@@ -5,8 +5,22 @@ LICENSE file in the root directory of this source tree.
 
 #include "common/NetworkParser.h"
 #include "common/Type.h"
+#include "congestion_unaware/CollectiveModel.h"
+#include "congestion_unaware/Dragonfly.h"
+#include "congestion_unaware/FatTree.h"
+#include "congestion_unaware/FullyConnected.h"
 #include "congestion_unaware/Helper.h"
+#include "congestion_unaware/MultiDimTopology.h"
+#include "congestion_unaware/HyperCube.h"
+#include "congestion_unaware/Mesh.h"
+#include "congestion_unaware/Ring.h"
+#include "congestion_unaware/StaticTopology.h"
+#include "congestion_unaware/Switch.h"
+#include "congestion_unaware/TorusND.h"
+#include <algorithm>
 #include <gtest/gtest.h>
+#include <memory>
+#include <vector>
 
 using namespace NetworkAnalytical;
 using namespace NetworkAnalyticalCongestionUnaware;
@@ -68,3 +82,282 @@ TEST_F(TestNetworkAnalyticalCongestionUnaware, Ring_FullyConnected_Switch) {
     const auto comm_delay_dim3 = topology->send(26, 42, chunk_size);
     EXPECT_EQ(comm_delay_dim3, 23'531);
 }
+
+TEST_F(TestNetworkAnalyticalCongestionUnaware, TorusND) {
+    // create network: 4x4x4 torus
+    const auto network_parser = NetworkParser("../../input/TorusND.yml");
+    const auto topology = construct_topology(network_parser);
+
+    // one hop per axis, through the wraparound links
+    EXPECT_EQ(topology->send(0, 63, chunk_size), 21'031);
+
+    // two hops per axis
+    EXPECT_EQ(topology->send(0, 42, chunk_size), 22'531);
+
+    // a mesh of the same shape has no wraparound links
+    const auto mesh = TorusND({4, 4, 4}, 50, 500, {false, false, false});
+    EXPECT_EQ(mesh.send(0, 63, chunk_size), 24'031);
+    EXPECT_EQ(mesh.send(63, 0, chunk_size), 24'031);
+
+    // wraparound per axis
+    const auto tube = TorusND({4, 4, 4}, 50, 500, {true, false, true});
+    EXPECT_EQ(tube.send(0, 63, chunk_size), 22'031);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionUnaware, FatTree) {
+    // create network: radix-8, 3-tier fat-tree of 64 NPUs
+    const auto network_parser = NetworkParser("../../input/FatTree.yml");
+    const auto topology = construct_topology(network_parser);
+
+    // through the leaf only
+    EXPECT_EQ(topology->send(0, 1, chunk_size), 20'531);
+
+    // up to the aggregation tier
+    EXPECT_EQ(topology->send(0, 4, chunk_size), 21'531);
+
+    // up to the core tier
+    EXPECT_EQ(topology->send(0, 63, chunk_size), 22'531);
+
+    // 64k NPUs, up to the fourth tier
+    const auto large = FatTree(32, 4, 1, 50, 500);
+    EXPECT_EQ(large.send(0, 65'535, chunk_size), 23'531);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionUnaware, Dragonfly) {
+    // create network: 9 groups of 4 routers with 2 NPUs each, minimal routing
+    const auto network_parser = NetworkParser("../../input/Dragonfly.yml");
+    const auto topology = construct_topology(network_parser);
+
+    // through the router only
+    EXPECT_EQ(topology->send(0, 1, chunk_size), 20'531);
+
+    // through a local link
+    EXPECT_EQ(topology->send(0, 2, chunk_size), 21'031);
+
+    // through a global link, then a local link
+    EXPECT_EQ(topology->send(0, 15, chunk_size), 21'531);
+
+    // Valiant routes detour through an intermediate group
+    const auto valiant = Dragonfly(9, 4, 2, 2, DragonflyArrangement::Absolute, DragonflyRouting::Valiant, 50, 500);
+    EXPECT_GT(valiant.send(0, 15, chunk_size), 21'531);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionUnaware, SendBatchMatchesSend) {
+    const auto expect_send_batch_matches_send = [&](const Topology& topology) {
+        const auto npus_count = topology.get_npus_count();
+
+        // every ordered pair, with varying chunk sizes
+        auto src = std::vector<DeviceId>();
+        auto dest = std::vector<DeviceId>();
+        auto chunk_sizes = std::vector<ChunkSize>();
+        for (int i = 0; i < npus_count; i++) {
+            for (int j = 0; j < npus_count; j++) {
+                if (i != j) {
+                    src.push_back(i);
+                    dest.push_back(j);
+                    chunk_sizes.push_back(chunk_size + (i * npus_count) + j);
+                }
+            }
+        }
+
+        // run batched communication
+        auto comms_delay = std::vector<EventTime>(src.size());
+        topology.send_batch(src.data(), dest.data(), chunk_sizes.data(), comms_delay.data(), src.size());
+
+        // compare against per-chunk send
+        for (size_t i = 0; i < src.size(); i++) {
+            EXPECT_EQ(comms_delay[i], topology.send(src[i], dest[i], chunk_sizes[i]));
+        }
+    };
+
+    for (const auto* const config : {"../../input/Ring.yml", "../../input/FullyConnected.yml", "../../input/Switch.yml",
+                                     "../../input/Ring_FullyConnected_Switch.yml", "../../input/TorusND.yml",
+                                     "../../input/FatTree.yml", "../../input/Dragonfly.yml"}) {
+        // create network
+        const auto network_parser = NetworkParser(config);
+        const auto topology = construct_topology(network_parser);
+        expect_send_batch_matches_send(*topology);
+    }
+
+    // building blocks without an input config, both bidirectional and not
+    for (const auto bidirectional : {true, false}) {
+        expect_send_batch_matches_send(HyperCube(16, 50, 500, bidirectional));
+        expect_send_batch_matches_send(Mesh(16, 50, 500, bidirectional));
+        expect_send_batch_matches_send(Mesh(13, 50, 500, bidirectional));
+    }
+}
+
+TEST_F(TestNetworkAnalyticalCongestionUnaware, CollectiveModelRing) {
+    // create network
+    const auto network_parser = NetworkParser("../../input/Ring.yml");
+    const auto topology = construct_topology(network_parser);
+    const auto collective_model = CollectiveModel(topology);
+    const auto npus_count = topology->get_npus_count();
+
+    // ring: 2(n-1) neighbour steps of one shard each
+    const auto ring_step = topology->send(0, 1, chunk_size / npus_count);
+    EXPECT_EQ(collective_model.estimate(CollectiveOperation::AllReduce, CollectiveAlgorithm::Ring, chunk_size),
+              2 * (npus_count - 1) * ring_step);
+    EXPECT_EQ(collective_model.estimate(CollectiveOperation::AllGather, CollectiveAlgorithm::Ring, chunk_size),
+              (npus_count - 1) * ring_step);
+
+    // direct: the farthest NPU (8 hops away on a bidirectional ring of 16) bounds each phase
+    const auto direct_step = topology->send(0, 8, chunk_size / npus_count);
+    EXPECT_EQ(collective_model.estimate(CollectiveOperation::ReduceScatter, CollectiveAlgorithm::Direct, chunk_size),
+              direct_step);
+
+    // halving-doubling: 8, 4, 2, 1 hops with halving sizes, then back
+    auto halving_doubling = EventTime{0};
+    for (auto step = 0; step < 4; step++) {
+        halving_doubling += topology->send(0, 8 >> step, chunk_size >> (step + 1));
+        halving_doubling += topology->send(0, 1 << step, chunk_size >> (4 - step));
+    }
+    EXPECT_EQ(collective_model.estimate(CollectiveOperation::AllReduce, CollectiveAlgorithm::HalvingDoubling,
+                                        chunk_size),
+              halving_doubling);
+
+    // hierarchical over a single dimension is ring
+    EXPECT_EQ(collective_model.estimate(CollectiveOperation::AllReduce, CollectiveAlgorithm::Hierarchical, chunk_size),
+              collective_model.estimate(CollectiveOperation::AllReduce, CollectiveAlgorithm::Ring, chunk_size));
+
+    // pipelining shortens double binary tree once serialization dominates
+    const auto pipelined_model = CollectiveModel(topology, 8);
+    const auto large_size = 64 * chunk_size;
+    EXPECT_LT(
+        pipelined_model.estimate(CollectiveOperation::AllReduce, CollectiveAlgorithm::DoubleBinaryTree, large_size),
+        collective_model.estimate(CollectiveOperation::AllReduce, CollectiveAlgorithm::DoubleBinaryTree, large_size));
+}
+
+TEST_F(TestNetworkAnalyticalCongestionUnaware, CollectiveModelHierarchical) {
+    // create network
+    const auto network_parser = NetworkParser("../../input/Ring_FullyConnected_Switch.yml");
+    const auto topology = construct_topology(network_parser);
+    const auto collective_model = CollectiveModel(topology);
+
+    // [2, 8, 4]: ring reduce-scatter per dimension on a shrinking buffer, then all-gather back
+    const auto dim1 = topology->send(0, 1, chunk_size / 2);
+    const auto dim2 = topology->send(0, 2, chunk_size / 16);
+    const auto dim3 = topology->send(0, 16, chunk_size / 64);
+    const auto reduce_scatter = (1 * dim1) + (7 * dim2) + (3 * dim3);
+    EXPECT_EQ(
+        collective_model.estimate(CollectiveOperation::ReduceScatter, CollectiveAlgorithm::Hierarchical, chunk_size),
+        reduce_scatter);
+    EXPECT_EQ(collective_model.estimate(CollectiveOperation::AllReduce, CollectiveAlgorithm::Hierarchical, chunk_size),
+              2 * reduce_scatter);
+
+    // per-dimension algorithms
+    const auto algorithm_per_dim = std::vector<CollectiveAlgorithm>{
+        CollectiveAlgorithm::Ring, CollectiveAlgorithm::Direct, CollectiveAlgorithm::Direct};
+    const auto reduce_scatter_direct = (1 * dim1) + dim2 + dim3;
+    EXPECT_EQ(collective_model.estimate_hierarchical(CollectiveOperation::ReduceScatter, algorithm_per_dim, chunk_size),
+              reduce_scatter_direct);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionUnaware, MultiDimSendModes) {
+    // create network: same shape as Ring_FullyConnected_Switch.yml
+    auto topology = MultiDimTopology();
+    topology.append_dimension(std::make_unique<Ring>(2, 200.0, 50.0));
+    topology.append_dimension(std::make_unique<FullyConnected>(8, 100.0, 500.0));
+    topology.append_dimension(std::make_unique<Switch>(4, 50.0, 2'000.0));
+
+    // 0 -> 63 crosses all dims: 1 hop on dim 1, 1 hop on dim 2, 2 hops on dim 3
+    topology.set_send_mode(MultiDimSendMode::FirstDim);
+    EXPECT_EQ(topology.send(0, 63, chunk_size), 4'932);
+
+    // store-and-forward: every dim serializes the chunk
+    topology.set_send_mode(MultiDimSendMode::Accumulate);
+    EXPECT_EQ(topology.send(0, 63, chunk_size), 38'729);
+    EXPECT_EQ(topology.send(37, 41, chunk_size), 10'265);
+
+    // cut-through: serialized once on the slowest dim
+    topology.set_send_mode(MultiDimSendMode::Pipelined);
+    EXPECT_EQ(topology.send(0, 63, chunk_size), 24'081);
+    EXPECT_EQ(topology.send(26, 42, chunk_size), 23'531);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionUnaware, StaticTopologyMatchesDynamic) {
+    // compare every ordered pair of NPUs
+    const auto expect_same_delays = [this](const Topology& static_topology, const Topology& dynamic_topology) {
+        ASSERT_EQ(static_topology.get_npus_count(), dynamic_topology.get_npus_count());
+        const auto npus_count = dynamic_topology.get_npus_count();
+        for (int i = 0; i < npus_count; i++) {
+            for (int j = 0; j < npus_count; j++) {
+                if (i != j) {
+                    EXPECT_EQ(static_topology.send(i, j, chunk_size), dynamic_topology.send(i, j, chunk_size));
+                }
+            }
+        }
+    };
+
+    // basic topologies
+    expect_same_delays(StaticRing<16>(50.0, 500.0), Ring(16, 50.0, 500.0));
+    expect_same_delays(StaticRing<16, false>(50.0, 500.0), Ring(16, 50.0, 500.0, false));
+    expect_same_delays(StaticFullyConnected<8>(100.0, 500.0), FullyConnected(8, 100.0, 500.0));
+    expect_same_delays(StaticSwitch<8>(50.0, 2'000.0), Switch(8, 50.0, 2'000.0));
+    expect_same_delays(StaticMesh<8>(50.0, 500.0), Mesh(8, 50.0, 500.0));
+    expect_same_delays(StaticHyperCube<4>(50.0, 500.0), HyperCube(16, 50.0, 500.0));
+
+    // multi-dimensional topology, in every send mode
+    auto static_topology = StaticMultiDimTopology<StaticRing<2>, StaticFullyConnected<8>, StaticSwitch<4>>(
+        StaticRing<2>(200.0, 50.0), StaticFullyConnected<8>(100.0, 500.0), StaticSwitch<4>(50.0, 2'000.0));
+    auto dynamic_topology = MultiDimTopology();
+    dynamic_topology.append_dimension(std::make_unique<Ring>(2, 200.0, 50.0));
+    dynamic_topology.append_dimension(std::make_unique<FullyConnected>(8, 100.0, 500.0));
+    dynamic_topology.append_dimension(std::make_unique<Switch>(4, 50.0, 2'000.0));
+    for (const auto send_mode :
+         {MultiDimSendMode::FirstDim, MultiDimSendMode::Accumulate, MultiDimSendMode::Pipelined}) {
+        static_topology.set_send_mode(send_mode);
+        dynamic_topology.set_send_mode(send_mode);
+        expect_same_delays(static_topology, dynamic_topology);
+    }
+}
+
+TEST_F(TestNetworkAnalyticalCongestionUnaware, CongestionEstimationOnRing) {
+    // create network
+    auto topology = Ring(16, 50.0, 500.0);
+    const auto idle_delay = topology.send(0, 8, chunk_size);
+
+    // without congestion estimation, send_at() is send()
+    EXPECT_EQ(topology.send_at(0, 8, chunk_size, 0), idle_delay);
+
+    for (const auto congestion_model : {CongestionModel::MD1, CongestionModel::BandwidthShare}) {
+        topology.enable_congestion_estimation(congestion_model, 100'000);
+
+        // the first chunk sees idle links
+        auto previous_delay = topology.send_at(0, 8, chunk_size, 0);
+        EXPECT_EQ(previous_delay, idle_delay);
+
+        // load builds up within the window (below the utilization cap)
+        for (auto i = 0; i < 16; i++) {
+            const auto comms_delay = topology.send_at(i % 16, (i + 8) % 16, chunk_size, 1'000);
+            EXPECT_GT(comms_delay, previous_delay);
+            previous_delay = comms_delay;
+        }
+
+        // and drains once the window slides past it
+        EXPECT_EQ(topology.send_at(0, 8, chunk_size, 1'000'000), idle_delay);
+    }
+}
+
+TEST_F(TestNetworkAnalyticalCongestionUnaware, CongestionEstimationOnRingFullyConnectedSwitch) {
+    // create network
+    const auto network_parser = NetworkParser("../../input/Ring_FullyConnected_Switch.yml");
+    const auto topology = construct_topology(network_parser);
+    topology->enable_congestion_estimation(CongestionModel::MD1, 100'000);
+
+    // idle: same as the congestion-unaware estimate on every dim
+    EXPECT_EQ(topology->send_at(0, 1, chunk_size, 0), 4'932);
+    EXPECT_EQ(topology->send_at(37, 41, chunk_size, 0), 10'265);
+    EXPECT_EQ(topology->send_at(26, 42, chunk_size, 0), 23'531);
+
+    // all-to-all within the window: the dim 3 switches get loaded
+    auto max_delay = EventTime{0};
+    for (int i = 0; i < 64; i++) {
+        for (int j = 0; j < 64; j++) {
+            if (i != j) {
+                max_delay = std::max(max_delay, topology->send_at(i, j, chunk_size, 0));
+            }
+        }
+    }
+    EXPECT_GT(max_delay, 23'531);
+}
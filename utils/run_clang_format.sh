@@ -38,5 +38,10 @@ printf "\tFormatting test:\n"
 find "$TARGET_DIR/test" \( -name "*.cpp" -o -name "*.h" \) -exec \
     clang-format -style=file -i {} \;
 
+# run clang-format for `bench`
+printf "\tFormatting bench:\n"
+find "$TARGET_DIR/bench" \( -name "*.cpp" -o -name "*.h" \) -exec \
+    clang-format -style=file -i {} \;
+
 # finalize
 echo "Formatting Done."